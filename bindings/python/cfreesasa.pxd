@@ -2,7 +2,7 @@ from libc.stdio cimport FILE
 
 cdef extern from "freesasa.h":
     ctypedef enum freesasa_algorithm:
-        FREESASA_LEE_RICHARDS, FREESASA_SHRAKE_RUPLEY
+        FREESASA_LEE_RICHARDS, FREESASA_SHRAKE_RUPLEY, FREESASA_SHRAKE_RUPLEY_LUT
 
     ctypedef enum freesasa_verbosity:
         FREESASA_V_NORMAL, FREESASA_V_NOWARNINGS, FREESASA_V_SILENT, FREESASA_V_DEBUG
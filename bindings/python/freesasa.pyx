@@ -26,6 +26,9 @@ ShrakeRupley = 'ShrakeRupley'
 ## Used to specify the algorithm by Lee & Richards
 LeeRichards = 'LeeRichards'
 
+## Used to specify the lookup table approximation of Shrake & Rupley
+ShrakeRupleyLUT = 'ShrakeRupleyLUT'
+
 ## Used for classification
 polar = 'Polar'
 
@@ -83,13 +86,16 @@ cdef class Parameters:
 
       ## Set algorithm.
       #
-      #  @param alg (str) algorithm name, only allowed values are ::ShrakeRupley and ::LeeRichards
+      #  @param alg (str) algorithm name, only allowed values are ::ShrakeRupley,
+      #             ::ShrakeRupleyLUT and ::LeeRichards
       #  @exception AssertionError unknown algorithm specified
       def setAlgorithm(self,alg):
             if alg == ShrakeRupley:
                   self._c_param.alg = FREESASA_SHRAKE_RUPLEY
             elif alg == LeeRichards:
                   self._c_param.alg = FREESASA_LEE_RICHARDS
+            elif alg == ShrakeRupleyLUT:
+                  self._c_param.alg = FREESASA_SHRAKE_RUPLEY_LUT
             else:
                   raise AssertionError("Algorithm '%s' is unknown" % alg)
 
@@ -101,6 +107,8 @@ cdef class Parameters:
                   return ShrakeRupley
             if self._c_param.alg == FREESASA_LEE_RICHARDS:
                   return LeeRichards
+            if self._c_param.alg == FREESASA_SHRAKE_RUPLEY_LUT:
+                  return ShrakeRupleyLUT
             raise Exception("No algorithm specified, shouldn't be possible")
 
       ## Set probe radius.
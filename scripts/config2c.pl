@@ -11,6 +11,11 @@ use strict;
 # doesn't do any syntax checks, so it will only work on valid config
 # files. 
 
+# The hash table used to look up atoms is also generated here, with
+# the same hash function and layout as config_build_table() in
+# classifier.c, so that the classifier doesn't have to build it at
+# runtime.
+
 my %types;
 my %atoms;
 my %classes;
@@ -20,6 +25,16 @@ my $n_residues = 0;
 my $atom_flag = 0;
 my $type_flag = 0;
 
+# FNV-1a hash of residue and atom name, as config_hash() in classifier.c
+sub config_hash {
+    my ($res, $atom) = @_;
+    my $h = 2166136261;
+    foreach my $c (unpack("C*", "$res $atom")) {
+        $h = (($h ^ $c) * 16777619) & 0xffffffff;
+    }
+    return $h;
+}
+
 (scalar @ARGV == 1) or die "Provide prefix for variable names";
 my $prefix = shift @ARGV;
 
@@ -66,8 +81,26 @@ print "static const char *$prefix\_class_name[] = {";
 print "\"$_\", "foreach (sort {$classes{$a} <=> $classes{$b}} keys %classes);
 print "};\n\n";
 
-foreach my $res (@res_array) {
-    my @atom_names = keys %{$atoms{$res}};
+my @table;
+my $n_atoms = 0;
+$n_atoms += scalar keys %{$atoms{$_}} foreach (@res_array);
+my $table_size = 16;
+$table_size *= 2 while ($table_size < 2*$n_atoms);
+my $max_probe = 0;
+
+foreach my $i (0..$#res_array) {
+    my $res = $res_array[$i];
+    my @atom_names = sort keys %{$atoms{$res}};
+    foreach my $j (0..$#atom_names) {
+        my $h = config_hash($res, $atom_names[$j]) & ($table_size - 1);
+        my $probe = 1;
+        while (defined $table[$h]) {
+            $h = ($h + 1) & ($table_size - 1);
+            ++$probe;
+        }
+        $max_probe = $probe if ($probe > $max_probe);
+        $table[$h] = "{$i, $j}";
+    }
     print "static const char *$prefix\_$res\_atom_name[] = {";
     print "\"$_\", " foreach (@atom_names);
     print "};\n";
@@ -83,6 +116,14 @@ foreach my $res (@res_array) {
     print "    .atom_radius = (double*) $prefix\_$res\_atom_radius,\n";
     print "    .atom_class = (int*) $prefix\_$res\_atom_class };\n\n"
 }
+print "/* Hash table for looking up atoms, at most $max_probe probes per atom */\n";
+print "static struct classifier_entry $prefix\_table[] = {";
+foreach my $h (0..$table_size-1) {
+    print $h % 8 == 0 ? "\n    " : " ";
+    print defined $table[$h] ? $table[$h] : "{-1, -1}", ",";
+}
+print "\n};\n\n";
+
 print "static struct classifier_residue *$prefix\_residue_cfg[] = {\n    ";
 foreach my $res (@res_array) {
     print "&$prefix\_$res\_cfg, ";
@@ -93,7 +134,9 @@ print "static struct classifier_config $prefix\_auto_config = {\n";
 print "    .n_residues = $n_residues, .n_classes = $n_classes,\n";
 print "    .residue_name = (char**) $prefix\_residue_name,\n";
 print "    .class_name = (char**) $prefix\_class_name,\n";
-print "    .residue = (struct classifier_residue **) $prefix\_residue_cfg\n";
+print "    .residue = (struct classifier_residue **) $prefix\_residue_cfg,\n";
+print "    .table_size = $table_size,\n";
+print "    .table = $prefix\_table\n";
 print "};\n\n";
 print "static void $prefix\_dummy_free(void *arg) {}\n\n";
 print "const freesasa_classifier freesasa_$prefix\_classifier = {\n";
@@ -0,0 +1,263 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "freesasa.h"
+#include "freesasa_internal.h"
+#include "coord.h"
+#include "nb.h"
+
+struct freesasa_calculation {
+    coord_t *xyz;
+    double *radii; // atomic radii
+    double *r; // radii including probe, used in the grid
+    freesasa_parameters param;
+    nb_grid *grid;
+    freesasa_result *result;
+    char *affected; // flags atoms that need to be recalculated
+    int *subset; // the flagged atoms
+    double *old; // the SASA of the flagged atoms before recalculation
+    double sum, comp; // compensated sum of the SASA, see total_add()
+    freesasa_sr_workspace *ws; // test points and work space for S&R
+    int n_recalculated; // atoms recalculated by the last move
+};
+
+void
+freesasa_calculation_free(freesasa_calculation *calc)
+{
+    if (calc) {
+        freesasa_coord_free(calc->xyz);
+        freesasa_nb_grid_free(calc->grid);
+        freesasa_result_free(calc->result);
+        free(calc->radii);
+        free(calc->r);
+        free(calc->affected);
+        free(calc->subset);
+        free(calc->old);
+        freesasa_sr_workspace_free(calc->ws);
+        free(calc);
+    }
+}
+
+/**
+    Adds x to the total SASA, using Neumaier's variant of Kahan
+    summation, so that the rounding errors of many moves don't
+    accumulate.
+ */
+static void
+total_add(freesasa_calculation *calc,
+          double x)
+{
+    const double t = calc->sum + x;
+    if (fabs(calc->sum) >= fabs(x)) calc->comp += (calc->sum - t) + x;
+    else calc->comp += (x - t) + calc->sum;
+    calc->sum = t;
+}
+
+freesasa_calculation *
+freesasa_calculation_new(const double *xyz,
+                         const double *radii,
+                         int n,
+                         const freesasa_parameters *parameters)
+{
+    assert(xyz);
+    assert(radii);
+    assert(n > 0);
+
+    freesasa_calculation *calc = malloc(sizeof(freesasa_calculation));
+
+    if (calc == NULL) {
+        mem_fail();
+        return NULL;
+    }
+
+    if (parameters == NULL) parameters = &freesasa_default_parameters;
+    calc->param = *parameters;
+    calc->grid = NULL;
+    calc->result = NULL;
+    calc->ws = NULL;
+    calc->sum = calc->comp = 0;
+    calc->n_recalculated = 0;
+    calc->xyz = freesasa_coord_new();
+    calc->radii = malloc(sizeof(double)*n);
+    calc->r = malloc(sizeof(double)*n);
+    calc->affected = calloc(n, 1);
+    calc->subset = malloc(sizeof(int)*n);
+    calc->old = malloc(sizeof(double)*n);
+
+    if (!calc->xyz || !calc->radii || !calc->r ||
+        !calc->affected || !calc->subset || !calc->old) {
+        mem_fail();
+        goto fail;
+    }
+    if (freesasa_coord_append(calc->xyz, xyz, n)) {
+        fail_msg("");
+        goto fail;
+    }
+    for (int i = 0; i < n; ++i) {
+        calc->radii[i] = radii[i];
+        calc->r[i] = radii[i] + calc->param.probe_radius;
+    }
+
+    calc->result = freesasa_calc_coord(xyz, radii, n, &calc->param);
+    if (calc->result == NULL) {
+        fail_msg("");
+        goto fail;
+    }
+    for (int i = 0; i < n; ++i) total_add(calc, calc->result->sasa[i]);
+
+    if (calc->param.alg == FREESASA_SHRAKE_RUPLEY ||
+        calc->param.alg == FREESASA_SHRAKE_RUPLEY_LUT) {
+        calc->ws = freesasa_sr_workspace_new(&calc->param);
+        if (calc->ws == NULL) {
+            fail_msg("");
+            goto fail;
+        }
+    }
+
+    calc->grid = freesasa_nb_grid_new(calc->xyz, calc->r);
+    if (calc->grid == NULL) {
+        fail_msg("");
+        goto fail;
+    }
+
+    return calc;
+
+ fail:
+    freesasa_calculation_free(calc);
+    return NULL;
+}
+
+const freesasa_result *
+freesasa_calculation_result(const freesasa_calculation *calc)
+{
+    assert(calc);
+    return calc->result;
+}
+
+int
+freesasa_calculation_n_recalculated(const freesasa_calculation *calc)
+{
+    assert(calc);
+    return calc->n_recalculated;
+}
+
+/**
+    Flags the atoms in the given row of the neighbor list nb, and adds them
+    to the subset. Returns the new size of the subset.
+ */
+static int
+flag_neighbors(freesasa_calculation *calc,
+               const nb_list *nb,
+               int row,
+               int n_subset)
+{
+    const nb_pair *nbi = nb->pair + nb->first[row];
+    for (int k = 0; k < nb->nn[row]; ++k) {
+        const int j = nbi[k].j;
+        if (!calc->affected[j]) {
+            calc->affected[j] = 1;
+            calc->subset[n_subset++] = j;
+        }
+    }
+    return n_subset;
+}
+
+//! Calls the subset version of the algorithm selected in the parameters
+static int
+calc_subset(freesasa_calculation *calc,
+            const nb_list *nb,
+            int n_subset)
+{
+    const freesasa_parameters *p = &calc->param;
+    double *sasa = calc->result->sasa;
+
+    switch (p->alg) {
+    case FREESASA_SHRAKE_RUPLEY:
+    case FREESASA_SHRAKE_RUPLEY_LUT:
+        return freesasa_shrake_rupley_subset(sasa, calc->xyz, calc->r, nb,
+                                             calc->subset, n_subset, p, calc->ws);
+    case FREESASA_LEE_RICHARDS:
+        return freesasa_lee_richards_subset(sasa, calc->xyz, calc->r, nb,
+                                            calc->subset, n_subset, p);
+    default:
+        assert(0); //should never get here
+        break;
+    }
+    return FREESASA_FAIL;
+}
+
+int
+freesasa_calculation_move(freesasa_calculation *calc,
+                          const int *atoms,
+                          const double *xyz,
+                          int n)
+{
+    assert(calc);
+    assert(atoms || n == 0);
+    assert(xyz || n == 0);
+
+    const int n_atoms = calc->result->n_atoms;
+    int n_moved = 0, n_affected, ret = FREESASA_FAIL;
+    nb_list *nb = NULL;
+    freesasa_result *result = calc->result;
+
+    for (int k = 0; k < n; ++k) {
+        if (atoms[k] < 0 || atoms[k] >= n_atoms)
+            return freesasa_fail("in %s(): atom index %d out of range",
+                                 __func__, atoms[k]);
+    }
+
+    // the moved atoms, without duplicates, go first in the subset
+    for (int k = 0; k < n; ++k) {
+        if (!calc->affected[atoms[k]]) {
+            calc->affected[atoms[k]] = 1;
+            calc->subset[n_moved++] = atoms[k];
+        }
+    }
+    n_affected = n_moved;
+
+    // neighbors before the move
+    nb = freesasa_nb_new_subset(calc->grid, calc->subset, n_moved);
+    if (nb == NULL) goto cleanup;
+    for (int k = 0; k < n_moved; ++k)
+        n_affected = flag_neighbors(calc, nb, k, n_affected);
+    freesasa_nb_free(nb);
+    nb = NULL;
+
+    // if more than one position is given for an atom, the last one is used
+    for (int k = 0; k < n; ++k)
+        freesasa_coord_set_i(calc->xyz, atoms[k], xyz + 3*k);
+    for (int k = 0; k < n_moved; ++k) {
+        if (freesasa_nb_grid_move(calc->grid, calc->subset[k])) goto cleanup;
+    }
+
+    // neighbors after the move
+    nb = freesasa_nb_new_subset(calc->grid, calc->subset, n_moved);
+    if (nb == NULL) goto cleanup;
+    for (int k = 0; k < n_moved; ++k)
+        n_affected = flag_neighbors(calc, nb, k, n_affected);
+    freesasa_nb_free(nb);
+    nb = NULL;
+
+    nb = freesasa_nb_new_subset(calc->grid, calc->subset, n_affected);
+    if (nb == NULL) goto cleanup;
+    for (int k = 0; k < n_affected; ++k)
+        calc->old[k] = result->sasa[calc->subset[k]];
+    ret = calc_subset(calc, nb, n_affected);
+    if (ret == FREESASA_FAIL) goto cleanup;
+
+    // only the change of the recalculated atoms is added to the total
+    for (int k = 0; k < n_affected; ++k) {
+        total_add(calc, -calc->old[k]);
+        total_add(calc, result->sasa[calc->subset[k]]);
+    }
+    result->total = calc->sum + calc->comp;
+    calc->n_recalculated = n_affected;
+
+ cleanup:
+    if (ret == FREESASA_FAIL) fail_msg("");
+    freesasa_nb_free(nb);
+    for (int k = 0; k < n_affected; ++k) calc->affected[calc->subset[k]] = 0;
+    return ret;
+}
@@ -0,0 +1,404 @@
+#include <assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freesasa_internal.h"
+#include "cif.h"
+
+//! The names of the items, in the order of ::cif_item, without the prefix `_atom_site.`
+static const char *cif_item_names[CIF_N_ITEMS] = {
+    "group_PDB", "type_symbol",
+    "label_atom_id", "auth_atom_id",
+    "label_alt_id",
+    "label_comp_id", "auth_comp_id",
+    "label_asym_id", "auth_asym_id",
+    "label_seq_id", "auth_seq_id",
+    "Cartn_x", "Cartn_y", "Cartn_z",
+    "occupancy", "pdbx_PDB_model_num"
+};
+
+//! Types of tokens
+enum cif_token {
+    CIF_TOKEN_END, //!< End of input
+    CIF_TOKEN_VALUE, //!< A value, quotes are stripped
+    CIF_TOKEN_MISSING, //!< `.` or `?`
+    CIF_TOKEN_TAG, //!< A data name, such as `_atom_site.id`
+    CIF_TOKEN_RESERVED //!< `loop_`, `data_`, `save_`, etc.
+};
+
+//! Case-insensitive check if the token starts with prefix
+static int
+cif_has_prefix(const char *token,
+               size_t len,
+               const char *prefix)
+{
+    size_t n = strlen(prefix);
+    if (len < n) return 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (tolower((unsigned char) token[i]) != tolower((unsigned char) prefix[i]))
+            return 0;
+    }
+    return 1;
+}
+
+//! Case-insensitive check if the token equals str
+static int
+cif_equals(const char *token,
+           size_t len,
+           const char *str)
+{
+    return len == strlen(str) && cif_has_prefix(token, len, str);
+}
+
+static int
+cif_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\0';
+}
+
+/**
+    Get the next token from the input. Comments are skipped. Text
+    fields (delimited by lines starting with ';') can't hold any of
+    the values we use, and are returned as missing values.
+ */
+static enum cif_token
+cif_next_token(struct cif_reader *r,
+               const char **token,
+               size_t *len)
+{
+    const char *l;
+    size_t p, begin;
+
+    if (r->peeked) {
+        r->peeked = 0;
+        *token = r->token;
+        *len = r->token_len;
+        return r->token_type;
+    }
+
+    for (;;) {
+        if (r->line == NULL || r->pos >= r->len) {
+            r->line = freesasa_pdb_reader_next(&r->lines, &r->len);
+            r->pos = 0;
+            if (r->line == NULL) break;
+            if (r->line[0] == ';') {
+                do {
+                    r->line = freesasa_pdb_reader_next(&r->lines, &r->len);
+                } while (r->line != NULL && r->line[0] != ';');
+                if (r->line == NULL) break;
+                r->pos = 1;
+                *token = "?";
+                *len = 1;
+                return CIF_TOKEN_MISSING;
+            }
+        }
+
+        l = r->line;
+        p = r->pos;
+        while (p < r->len && cif_is_space(l[p])) ++p;
+        if (p == r->len || l[p] == '#') {
+            r->pos = r->len;
+            continue;
+        }
+
+        if (l[p] == '\'' || l[p] == '"') {
+            // a quote only ends the value if followed by whitespace
+            const char quote = l[p];
+            begin = ++p;
+            while (p < r->len &&
+                   !(l[p] == quote && (p + 1 == r->len || cif_is_space(l[p+1]))))
+                ++p;
+            *token = l + begin;
+            *len = p - begin;
+            r->pos = p < r->len ? p + 1 : p;
+            return CIF_TOKEN_VALUE;
+        }
+
+        begin = p;
+        while (p < r->len && !cif_is_space(l[p])) ++p;
+        r->pos = p;
+        *token = l + begin;
+        *len = p - begin;
+
+        if (l[begin] == '_') return CIF_TOKEN_TAG;
+        if (memchr(*token, '_', *len) != NULL &&
+            (cif_has_prefix(*token, *len, "loop_") ||
+             cif_has_prefix(*token, *len, "data_") ||
+             cif_has_prefix(*token, *len, "save_") ||
+             cif_has_prefix(*token, *len, "global_") ||
+             cif_has_prefix(*token, *len, "stop_")))
+            return CIF_TOKEN_RESERVED;
+        if (*len == 1 && (l[begin] == '.' || l[begin] == '?'))
+            return CIF_TOKEN_MISSING;
+        return CIF_TOKEN_VALUE;
+    }
+
+    *token = NULL;
+    *len = 0;
+    return CIF_TOKEN_END;
+}
+
+//! The next call to cif_next_token() will return this token again
+static void
+cif_push_back(struct cif_reader *r,
+              const char *token,
+              size_t len,
+              enum cif_token type)
+{
+    assert(!r->peeked);
+    r->peeked = 1;
+    r->token = token;
+    r->token_len = len;
+    r->token_type = type;
+}
+
+//! Returns the ::cif_item of a tag without prefix, -1 if not used
+static int
+cif_item_index(const char *name,
+               size_t len)
+{
+    for (int i = 0; i < CIF_N_ITEMS; ++i) {
+        if (cif_equals(name, len, cif_item_names[i])) return i;
+    }
+    return -1;
+}
+
+int
+freesasa_cif_reader_open(struct cif_reader *r,
+                         FILE *cif)
+{
+    assert(r);
+    assert(cif);
+
+    const char *token;
+    size_t len, prefix_len = strlen("_atom_site.");
+    enum cif_token type;
+    int *item, index;
+
+    r->line = NULL;
+    r->len = r->pos = 0;
+    r->item = NULL;
+    r->n_columns = 0;
+    r->peeked = 0;
+    r->long_chain_warned = 0;
+    for (int i = 0; i < CIF_N_ITEMS; ++i) r->has_item[i] = 0;
+
+    if (freesasa_pdb_reader_open(&r->lines, cif)) return fail_msg("");
+
+    // skip to the header of the loop
+    for (;;) {
+        type = cif_next_token(r, &token, &len);
+        if (type == CIF_TOKEN_END) {
+            if (r->lines.error) fail_msg("");
+            else freesasa_fail("in %s(): input has no _atom_site loop.", __func__);
+            goto fail;
+        }
+        if (type == CIF_TOKEN_RESERVED && cif_equals(token, len, "loop_")) {
+            type = cif_next_token(r, &token, &len);
+            if (type == CIF_TOKEN_TAG && cif_has_prefix(token, len, "_atom_site."))
+                break;
+            cif_push_back(r, token, len, type);
+        }
+    }
+
+    // the tags of the loop, the first one has already been read
+    do {
+        if (r->n_columns % 16 == 0) {
+            item = realloc(r->item, sizeof(int)*(r->n_columns + 16));
+            if (item == NULL) {
+                mem_fail();
+                goto fail;
+            }
+            r->item = item;
+        }
+        index = cif_item_index(token + prefix_len, len - prefix_len);
+        r->item[r->n_columns++] = index;
+        if (index >= 0) r->has_item[index] = 1;
+        type = cif_next_token(r, &token, &len);
+    } while (type == CIF_TOKEN_TAG && cif_has_prefix(token, len, "_atom_site."));
+    cif_push_back(r, token, len, type);
+
+    if (!r->has_item[CIF_CARTN_X] || !r->has_item[CIF_CARTN_Y] ||
+        !r->has_item[CIF_CARTN_Z] ||
+        !(r->has_item[CIF_LABEL_ATOM_ID] || r->has_item[CIF_AUTH_ATOM_ID]) ||
+        !(r->has_item[CIF_LABEL_COMP_ID] || r->has_item[CIF_AUTH_COMP_ID])) {
+        freesasa_fail("in %s(): the _atom_site loop lacks coordinates, "
+                      "atom names or residue names.", __func__);
+        goto fail;
+    }
+
+    return FREESASA_SUCCESS;
+
+ fail:
+    freesasa_cif_reader_close(r);
+    return FREESASA_FAIL;
+}
+
+void
+freesasa_cif_reader_close(struct cif_reader *r)
+{
+    assert(r);
+    freesasa_pdb_reader_close(&r->lines);
+    free(r->item);
+    r->item = NULL;
+}
+
+//! The value of an item, or of the fallback item if it's missing, NULL if both are missing
+static const char *
+cif_value(const struct cif_reader *r,
+          int item,
+          int fallback)
+{
+    if (!r->missing[item]) return r->value[item];
+    if (fallback >= 0 && !r->missing[fallback]) return r->value[fallback];
+    return NULL;
+}
+
+/**
+    Reads a number. Plain decimals with up to 15 digits are converted
+    by dividing the integer mantissa by a power of ten, which is exact
+    (i.e. gives the same result as strtod()), but a lot faster. Other
+    numbers can have exponents, or a standard uncertainty in
+    parentheses, such as `12.345(6)`.
+ */
+static int
+cif_number(double *x,
+           const struct cif_reader *r,
+           int item)
+{
+    static const double scale[] = {1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                   1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+    const char *c = r->value[item];
+    char *end;
+    int neg = 0, n_digits = 0, n_dec = -1;
+    long long m = 0;
+
+    if (r->missing[item] || r->value_len[item] > CIF_VALUE_STRL)
+        return FREESASA_FAIL;
+
+    if (*c == '-' || *c == '+') neg = *c++ == '-';
+    for (; *c != '\0'; ++c) {
+        if (*c >= '0' && *c <= '9') {
+            m = 10*m + (*c - '0');
+            ++n_digits;
+            if (n_dec >= 0) ++n_dec;
+        } else if (*c == '.' && n_dec < 0) {
+            n_dec = 0;
+        } else {
+            break;
+        }
+    }
+    if (*c == '\0' && n_digits > 0 && n_digits <= 15) {
+        *x = n_dec > 0 ? m / scale[n_dec] : m;
+        if (neg) *x = -*x;
+        return FREESASA_SUCCESS;
+    }
+
+    *x = strtod(r->value[item], &end);
+    if (end == r->value[item] || (*end != '\0' && *end != '('))
+        return FREESASA_FAIL;
+    return FREESASA_SUCCESS;
+}
+
+//! Converts the values of the current row to an atom
+static int
+cif_row_to_atom(struct cif_reader *r,
+                struct cif_atom *a)
+{
+    const char *name = cif_value(r, CIF_AUTH_ATOM_ID, CIF_LABEL_ATOM_ID),
+        *res_name = cif_value(r, CIF_AUTH_COMP_ID, CIF_LABEL_COMP_ID),
+        *res_number = cif_value(r, CIF_AUTH_SEQ_ID, CIF_LABEL_SEQ_ID),
+        *chain = cif_value(r, CIF_AUTH_ASYM_ID, CIF_LABEL_ASYM_ID),
+        *symbol = cif_value(r, CIF_TYPE_SYMBOL, -1),
+        *alt = cif_value(r, CIF_LABEL_ALT_ID, -1),
+        *group = cif_value(r, CIF_GROUP_PDB, -1),
+        *model = cif_value(r, CIF_MODEL_NUM, -1);
+
+    if (name == NULL || res_name == NULL)
+        return freesasa_fail("in %s(): atom without atom or residue name.", __func__);
+
+    for (int i = 0; i < 3; ++i) {
+        if (cif_number(&a->xyz[i], r, CIF_CARTN_X + i))
+            return freesasa_fail("in %s(): can't read coordinates of atom '%s %s'.",
+                                 __func__, res_name, name);
+    }
+
+    a->symbol[0] = '\0';
+    if (symbol != NULL && strlen(symbol) <= PDB_ATOM_SYMBOL_STRL) {
+        sprintf(a->symbol, "%2s", symbol);
+        for (char *c = a->symbol; *c; ++c) *c = toupper((unsigned char) *c);
+    }
+
+    // like in PDB files, the second character is the first of one-letter elements
+    if (strlen(name) >= PDB_ATOM_NAME_STRL ||
+        (symbol != NULL && strlen(symbol) == 2))
+        sprintf(a->name, "%-4s", name);
+    else
+        sprintf(a->name, " %-3s", name);
+    sprintf(a->res_name, "%3s", res_name);
+    sprintf(a->res_number, "%4s", res_number ? res_number : "");
+
+    strcpy(a->chain, chain ? chain : " ");
+    a->chain_label = a->chain[0];
+    if (strlen(a->chain) > 1 && !r->long_chain_warned) {
+        freesasa_warn("chain id '%s' has more than one character, "
+                      "only the first one is used as chain label.", a->chain);
+        r->long_chain_warned = 1;
+    }
+
+    a->alt_label = alt ? alt[0] : ' ';
+    a->hetatm = group != NULL && strcmp(group, "HETATM") == 0;
+    if (a->symbol[0] != '\0')
+        a->hydrogen = strcmp(a->symbol, " H") == 0 || strcmp(a->symbol, " D") == 0;
+    else
+        a->hydrogen = a->name[0] == 'H' || a->name[1] == 'H' ||
+            a->name[0] == 'D' || a->name[1] == 'D';
+    a->model = model ? atoi(model) : 0;
+    a->has_occupancy = cif_number(&a->occupancy, r, CIF_OCCUPANCY) == FREESASA_SUCCESS;
+
+    return 1;
+}
+
+int
+freesasa_cif_reader_next(struct cif_reader *r,
+                         struct cif_atom *atom)
+{
+    assert(r);
+    assert(atom);
+
+    const char *token;
+    size_t len;
+    enum cif_token type;
+    size_t n;
+    int item;
+
+    for (int i = 0; i < CIF_N_ITEMS; ++i) {
+        r->value[i][0] = '\0';
+        r->value_len[i] = 0;
+        r->missing[i] = 1;
+    }
+
+    // rows can span several lines, the values are copied as they are read
+    for (int k = 0; k < r->n_columns; ++k) {
+        type = cif_next_token(r, &token, &len);
+        if (type == CIF_TOKEN_END || type == CIF_TOKEN_TAG ||
+            type == CIF_TOKEN_RESERVED) {
+            if (r->lines.error) return fail_msg("");
+            if (k == 0) {
+                cif_push_back(r, token, len, type);
+                return 0;
+            }
+            return freesasa_fail("in %s(): incomplete row in _atom_site loop.",
+                                 __func__);
+        }
+        item = r->item[k];
+        if (item < 0 || type == CIF_TOKEN_MISSING) continue;
+        n = len > CIF_VALUE_STRL ? CIF_VALUE_STRL : len;
+        memcpy(r->value[item], token, n);
+        r->value[item][n] = '\0';
+        r->value_len[item] = len;
+        r->missing[item] = 0;
+    }
+
+    return cif_row_to_atom(r, atom);
+}
@@ -0,0 +1,114 @@
+#ifndef FREESASA_CIF_H
+#define FREESASA_CIF_H
+
+#include "freesasa.h"
+#include "pdb.h"
+
+/**
+    @file
+    @author Simon Mitternacht
+
+    Streaming reader for the `_atom_site` loop of mmCIF (PDBx)
+    files. The input is tokenized as it is read, and only the current
+    row of the loop is stored, so that the memory needed does not
+    depend on the size of the file.
+
+    The values of each row are converted to the same format as the
+    fields of a PDB `ATOM` line, i.e. `" CA "`, `"ALA"`, `"  12"`,
+    etc., so that the atoms can be treated exactly like atoms read
+    from PDB files.
+ */
+
+#define CIF_VALUE_STRL 31 //!< Longest value that is stored, longer values are truncated
+
+//! The `_atom_site` items that are used.
+enum cif_item {
+    CIF_GROUP_PDB, CIF_TYPE_SYMBOL,
+    CIF_LABEL_ATOM_ID, CIF_AUTH_ATOM_ID,
+    CIF_LABEL_ALT_ID,
+    CIF_LABEL_COMP_ID, CIF_AUTH_COMP_ID,
+    CIF_LABEL_ASYM_ID, CIF_AUTH_ASYM_ID,
+    CIF_LABEL_SEQ_ID, CIF_AUTH_SEQ_ID,
+    CIF_CARTN_X, CIF_CARTN_Y, CIF_CARTN_Z,
+    CIF_OCCUPANCY, CIF_MODEL_NUM,
+    CIF_N_ITEMS
+};
+
+/**
+    Reads the rows of the `_atom_site` loop of an mmCIF file. Lines
+    are read using a ::pdb_reader.
+ */
+struct cif_reader {
+    struct pdb_reader lines; //!< The lines of the file
+    const char *line; //!< Current line, NULL before the first one
+    size_t len; //!< Length of the current line
+    size_t pos; //!< Position of the next token in the current line
+    int *item; //!< The ::cif_item of each column of the loop, -1 for unused columns
+    int n_columns; //!< Number of columns in the loop
+    int has_item[CIF_N_ITEMS]; //!< Flags which items are present in the loop
+    char value[CIF_N_ITEMS][CIF_VALUE_STRL+1]; //!< The values of the current row
+    size_t value_len[CIF_N_ITEMS]; //!< The lengths of the values, before truncation
+    int missing[CIF_N_ITEMS]; //!< Flags values that are missing ('.' or '?')
+    int peeked; //!< A token has been pushed back
+    int token_type; //!< Type of the pushed back token
+    const char *token; //!< The pushed back token
+    size_t token_len; //!< Length of the pushed back token
+    int long_chain_warned; //!< A warning about long chain ids has been printed
+};
+
+/**
+    An atom from the `_atom_site` loop, with the strings padded like
+    the fields of a PDB file.
+ */
+struct cif_atom {
+    char name[CIF_VALUE_STRL+2]; //!< Atom name, such as `" CA "`
+    char res_name[CIF_VALUE_STRL+1]; //!< Residue name
+    char res_number[CIF_VALUE_STRL+1]; //!< Residue number, author numbering if available
+    char symbol[PDB_ATOM_SYMBOL_STRL+1]; //!< Element symbol, empty string if missing
+    char chain[CIF_VALUE_STRL+1]; //!< The full chain id, author id if available
+    char chain_label; //!< Chain label, first character of the chain id
+    char alt_label; //!< Alternate location label, `' '` if missing
+    int hetatm; //!< 1 if the group is `HETATM`, 0 else
+    int hydrogen; //!< 1 if the atom is hydrogen or deuterium, 0 else
+    int model; //!< Model number, 0 if not specified
+    int has_occupancy; //!< 1 if the occupancy is specified, 0 else
+    double occupancy; //!< The occupancy
+    double xyz[3]; //!< Coordinates
+};
+
+/**
+    Prepares to read atoms from the current position of a file, by
+    skipping forward to the header of the `_atom_site` loop.
+
+    @param reader The reader to initialize.
+    @param cif The file, has to stay open until the reader is closed.
+    @return ::FREESASA_SUCCESS. ::FREESASA_FAIL if the file has no
+      `_atom_site` loop with coordinates, or if malloc fails. The
+      reader only needs to be closed if the function succeeds.
+ */
+int
+freesasa_cif_reader_open(struct cif_reader *reader,
+                         FILE *cif);
+
+/**
+    Get the next atom.
+
+    @param reader The reader.
+    @param atom The atom is written here.
+    @return 1 if an atom was read, 0 at the end of the loop.
+      ::FREESASA_FAIL if the row is incomplete, or if the coordinates
+      can't be read.
+ */
+int
+freesasa_cif_reader_next(struct cif_reader *reader,
+                         struct cif_atom *atom);
+
+/**
+    Frees the resources of the reader.
+
+    @param reader The reader.
+ */
+void
+freesasa_cif_reader_close(struct cif_reader *reader);
+
+#endif /* FREESASA_CIF_H */
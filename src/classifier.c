@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <ctype.h>
 #include "classifier.h"
 #include "freesasa_internal.h"
 
@@ -14,7 +15,7 @@ static const struct classifier_types empty_types = {0, 0, NULL, NULL, NULL, NULL
 
 const struct classifier_residue empty_residue = {0,NULL,NULL,NULL,NULL};
 
-const struct classifier_config empty_config = {0, 0, NULL, NULL, NULL};
+const struct classifier_config empty_config = {0, 0, NULL, NULL, NULL, 0, NULL};
 
 static struct classifier_types*
 classifier_types_new()
@@ -112,6 +113,7 @@ classifier_config_free(void *p)
             classifier_residue_free(c->residue[i]);
     free(c->residue);
     free(c->residue_name);
+    free(c->table);
 
     free(c);
 }
@@ -540,6 +542,74 @@ config_copy_classes(struct classifier_config *config,
     return FREESASA_SUCCESS;
 }
 
+/**
+    Finds the first word of a string, to ignore whitespace the same
+    way as find_string(). Returns a pointer to the beginning of the
+    word and stores its length in len.
+ */
+static const char *
+config_word(const char *str,
+            size_t *len)
+{
+    size_t n = 0;
+    while (isspace((unsigned char)*str)) ++str;
+    while (str[n] != '\0' && !isspace((unsigned char)str[n])) ++n;
+    *len = n;
+    return str;
+}
+
+//! FNV-1a hash of a residue and atom name, config2c.pl uses the same function
+static unsigned int
+config_hash(const char *res_name,
+            size_t res_len,
+            const char *atom_name,
+            size_t atom_len)
+{
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < res_len; ++i)
+        h = (h ^ (unsigned char)res_name[i]) * 16777619u;
+    h = (h ^ ' ') * 16777619u;
+    for (size_t i = 0; i < atom_len; ++i)
+        h = (h ^ (unsigned char)atom_name[i]) * 16777619u;
+    return h;
+}
+
+/**
+    Builds the hash table of the configuration, with room for at
+    least twice as many entries as there are atoms. The tables of
+    the built-in classifiers are generated by config2c.pl, in the
+    same way.
+ */
+static int
+config_build_table(struct classifier_config *config)
+{
+    int n_atoms = 0, size = 16, i, j;
+    unsigned int h;
+    const struct classifier_residue *res;
+
+    for (i = 0; i < config->n_residues; ++i)
+        n_atoms += config->residue[i]->n_atoms;
+    while (size < 2*n_atoms) size *= 2;
+
+    config->table = malloc(sizeof(struct classifier_entry)*size);
+    if (config->table == NULL) return mem_fail();
+    config->table_size = size;
+    for (i = 0; i < size; ++i) config->table[i].residue = -1;
+
+    for (i = 0; i < config->n_residues; ++i) {
+        res = config->residue[i];
+        for (j = 0; j < res->n_atoms; ++j) {
+            h = config_hash(res->name, strlen(res->name),
+                            res->atom_name[j], strlen(res->atom_name[j]));
+            h &= size - 1;
+            while (config->table[h].residue >= 0) h = (h + 1) & (size - 1);
+            config->table[h].residue = i;
+            config->table[h].atom = j;
+        }
+    }
+    return FREESASA_SUCCESS;
+}
+
 static struct classifier_config*
 read_config(FILE *input) 
 {
@@ -553,7 +623,8 @@ read_config(FILE *input)
         check_file(input, &types_section, &atoms_section) ||
         read_types(types, input, types_section) ||
         read_atoms(config, types, input, atoms_section) ||
-        config_copy_classes(config, types)) {
+        config_copy_classes(config, types) ||
+        config_build_table(config)) {
         classifier_config_free(config);
         config = NULL;
     }
@@ -563,21 +634,36 @@ read_config(FILE *input)
 }
 
 /**
-    See if an atom_name has been defined for the residue ANY (writes
-    indices to the provided pointers).
+    Look up an atom in the hash table of the configuration. Returns
+    FREESASA_SUCCESS if found, FREESASA_FAIL if not.
  */
-static void 
-find_any(const struct classifier_config *config,
-         const char *atom_name,
-         int *res, int *atom)
-{
-    *res = find_string(config->residue_name,"ANY",config->n_residues);
-    if (*res >= 0) {
-        *atom = find_string(config->residue[*res]->atom_name,
-                            atom_name,
-                            config->residue[*res]->n_atoms); 
+static int
+find_in_table(const struct classifier_config *config,
+              const char *res_name,
+              size_t res_len,
+              const char *atom_name,
+              size_t atom_len,
+              int *res,
+              int *atom)
+{
+    const unsigned int mask = config->table_size - 1;
+    unsigned int h = config_hash(res_name, res_len, atom_name, atom_len) & mask;
+    const struct classifier_entry *e;
+    const struct classifier_residue *r;
+
+    for (e = &config->table[h]; e->residue >= 0; e = &config->table[h = (h + 1) & mask]) {
+        r = config->residue[e->residue];
+        if (strncmp(r->name, res_name, res_len) == 0 && r->name[res_len] == '\0' &&
+            strncmp(r->atom_name[e->atom], atom_name, atom_len) == 0 &&
+            r->atom_name[e->atom][atom_len] == '\0') {
+            *res = e->residue;
+            *atom = e->atom;
+            return FREESASA_SUCCESS;
+        }
     }
+    return FREESASA_FAIL;
 }
+
 /**
     Find the residue and atom index of an atom in the supplied
     configuration. Prints error and returns FREESASA_WARN if not
@@ -590,18 +676,16 @@ find_atom(const struct classifier_config *config,
           int* res,
           int* atom)
 {
-    *atom = -1;
-    *res = find_string(config->residue_name,res_name,config->n_residues);
-    if (*res < 0) {
-        find_any(config,atom_name,res,atom);
-    } else {        
-        const struct classifier_residue *residue = config->residue[*res];
-        *atom = find_string(residue->atom_name,atom_name,residue->n_atoms);
-        if (*atom < 0) {
-            find_any(config,atom_name,res,atom);
-        }
-    }
-    if (*atom < 0) {
+    assert(config->table);
+    size_t res_len, atom_len;
+
+    // if the atom isn't defined for the residue, see if it has been
+    // defined for the residue ANY
+    res_name = config_word(res_name, &res_len);
+    atom_name = config_word(atom_name, &atom_len);
+    if (find_in_table(config, res_name, res_len, atom_name, atom_len, res, atom) &&
+        find_in_table(config, "ANY", 3, atom_name, atom_len, res, atom)) {
+        *atom = -1;
         return FREESASA_WARN;
     }
     return FREESASA_SUCCESS;
@@ -44,6 +44,16 @@ struct classifier_residue {
     int *atom_class; //!< Classes of atoms
 };
 
+/**
+    Entry in the hash table of a configuration, the indices of an atom
+    in the arrays of struct classifier_config and struct
+    classifier_residue. Empty entries have residue < 0.
+ */
+struct classifier_entry {
+    int residue; //!< Index of the residue
+    int atom; //!< Index of the atom in the residue
+};
+
 /**
     Stores a user-configuration as extracted from a configuration
     file. No info about types, since those are only a tool used
@@ -54,6 +64,9 @@ struct classifier_residue {
     be a clone of that found in struct types (can be done bye
     config_copy_classes()).
 
+    Atoms are looked up by residue and atom name in a hash table with
+    linear probing.
+
     Only for internal use.
  */
 struct classifier_config {
@@ -61,7 +74,9 @@ struct classifier_config {
     int n_classes; //!< Number of classes
     char **residue_name; //!< Names of residues
     char **class_name; //!< Names of classes
-    struct classifier_residue **residue;
+    struct classifier_residue **residue; //!< The residues
+    int table_size; //!< Size of the hash table, a power of two
+    struct classifier_entry *table; //!< The hash table
 };
 
 /** To be used in classifiers based on config-files */
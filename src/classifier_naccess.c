@@ -5,54 +5,54 @@
 static const char *naccess_residue_name[] = {"A", "ANY", "ARG", "ASN", "ASP", "C", "CYS", "DA", "DC", "DG", "DI", "DT", "DU", "G", "GLN", "GLU", "HIS", "I", "ILE", "LEU", "LYS", "MET", "PHE", "PRO", "SEC", "SER", "T", "THR", "TRP", "TYR", "U", "VAL", };
 static const char *naccess_class_name[] = {"apolar", "polar", };
 
-static const char *naccess_A_atom_name[] = {"N1", "C6", "N6", "C5", "N9", "N3", "N7", "C4", "C8", "C2", };
-static double naccess_A_atom_radius[] = {1.60, 1.80, 1.60, 1.80, 1.60, 1.60, 1.60, 1.80, 1.80, 1.80, };
-static int naccess_A_atom_class[] = {1, 0, 1, 0, 1, 1, 1, 0, 0, 0, };
+static const char *naccess_A_atom_name[] = {"C2", "C4", "C5", "C6", "C8", "N1", "N3", "N6", "N7", "N9", };
+static double naccess_A_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.60, 1.60, 1.60, };
+static int naccess_A_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue naccess_A_cfg = {
     .name = "A", .n_atoms = 10,
     .atom_name = (char**) naccess_A_atom_name,
     .atom_radius = (double*) naccess_A_atom_radius,
     .atom_class = (int*) naccess_A_atom_class };
 
-static const char *naccess_ANY_atom_name[] = {"OP1", "N", "CB", "C3'", "C", "CA", "O", "C1'", "P", "O4'", "O3'", "OP2", "C5'", "C2'", "C4'", "O5'", "OP3", "O2'", "OXT", };
-static double naccess_ANY_atom_radius[] = {1.40, 1.65, 1.87, 1.80, 1.76, 1.87, 1.40, 1.80, 1.90, 1.40, 1.40, 1.40, 1.80, 1.80, 1.80, 1.40, 1.40, 1.40, 1.40, };
-static int naccess_ANY_atom_class[] = {1, 1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, };
+static const char *naccess_ANY_atom_name[] = {"C", "C1'", "C2'", "C3'", "C4'", "C5'", "CA", "CB", "N", "O", "O2'", "O3'", "O4'", "O5'", "OP1", "OP2", "OP3", "OXT", "P", };
+static double naccess_ANY_atom_radius[] = {1.76, 1.80, 1.80, 1.80, 1.80, 1.80, 1.87, 1.87, 1.65, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.90, };
+static int naccess_ANY_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, };
 static struct classifier_residue naccess_ANY_cfg = {
     .name = "ANY", .n_atoms = 19,
     .atom_name = (char**) naccess_ANY_atom_name,
     .atom_radius = (double*) naccess_ANY_atom_radius,
     .atom_class = (int*) naccess_ANY_atom_class };
 
-static const char *naccess_ARG_atom_name[] = {"CD", "CZ", "NE", "CG", "NH2", "NH1", };
-static double naccess_ARG_atom_radius[] = {1.87, 1.76, 1.65, 1.87, 1.65, 1.65, };
-static int naccess_ARG_atom_class[] = {0, 0, 1, 0, 1, 1, };
+static const char *naccess_ARG_atom_name[] = {"CD", "CG", "CZ", "NE", "NH1", "NH2", };
+static double naccess_ARG_atom_radius[] = {1.87, 1.87, 1.76, 1.65, 1.65, 1.65, };
+static int naccess_ARG_atom_class[] = {0, 0, 0, 1, 1, 1, };
 static struct classifier_residue naccess_ARG_cfg = {
     .name = "ARG", .n_atoms = 6,
     .atom_name = (char**) naccess_ARG_atom_name,
     .atom_radius = (double*) naccess_ARG_atom_radius,
     .atom_class = (int*) naccess_ARG_atom_class };
 
-static const char *naccess_ASN_atom_name[] = {"OD1", "CG", "ND2", };
-static double naccess_ASN_atom_radius[] = {1.40, 1.76, 1.65, };
-static int naccess_ASN_atom_class[] = {1, 0, 1, };
+static const char *naccess_ASN_atom_name[] = {"CG", "ND2", "OD1", };
+static double naccess_ASN_atom_radius[] = {1.76, 1.65, 1.40, };
+static int naccess_ASN_atom_class[] = {0, 1, 1, };
 static struct classifier_residue naccess_ASN_cfg = {
     .name = "ASN", .n_atoms = 3,
     .atom_name = (char**) naccess_ASN_atom_name,
     .atom_radius = (double*) naccess_ASN_atom_radius,
     .atom_class = (int*) naccess_ASN_atom_class };
 
-static const char *naccess_ASP_atom_name[] = {"OD2", "OD1", "CG", };
-static double naccess_ASP_atom_radius[] = {1.40, 1.40, 1.76, };
-static int naccess_ASP_atom_class[] = {1, 1, 0, };
+static const char *naccess_ASP_atom_name[] = {"CG", "OD1", "OD2", };
+static double naccess_ASP_atom_radius[] = {1.76, 1.40, 1.40, };
+static int naccess_ASP_atom_class[] = {0, 1, 1, };
 static struct classifier_residue naccess_ASP_cfg = {
     .name = "ASP", .n_atoms = 3,
     .atom_name = (char**) naccess_ASP_atom_name,
     .atom_radius = (double*) naccess_ASP_atom_radius,
     .atom_class = (int*) naccess_ASP_atom_class };
 
-static const char *naccess_C_atom_name[] = {"C6", "N1", "C5", "N3", "O2", "C4", "C2", "N4", };
-static double naccess_C_atom_radius[] = {1.80, 1.60, 1.80, 1.60, 1.40, 1.80, 1.80, 1.60, };
-static int naccess_C_atom_class[] = {0, 1, 0, 1, 1, 0, 0, 1, };
+static const char *naccess_C_atom_name[] = {"C2", "C4", "C5", "C6", "N1", "N3", "N4", "O2", };
+static double naccess_C_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.60, 1.40, };
+static int naccess_C_atom_class[] = {0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue naccess_C_cfg = {
     .name = "C", .n_atoms = 8,
     .atom_name = (char**) naccess_C_atom_name,
@@ -68,106 +68,106 @@ static struct classifier_residue naccess_CYS_cfg = {
     .atom_radius = (double*) naccess_CYS_atom_radius,
     .atom_class = (int*) naccess_CYS_atom_class };
 
-static const char *naccess_DA_atom_name[] = {"N1", "C6", "N6", "C5", "N9", "N3", "N7", "C4", "C8", "C2", };
-static double naccess_DA_atom_radius[] = {1.60, 1.80, 1.60, 1.80, 1.60, 1.60, 1.60, 1.80, 1.80, 1.80, };
-static int naccess_DA_atom_class[] = {1, 0, 1, 0, 1, 1, 1, 0, 0, 0, };
+static const char *naccess_DA_atom_name[] = {"C2", "C4", "C5", "C6", "C8", "N1", "N3", "N6", "N7", "N9", };
+static double naccess_DA_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.60, 1.60, 1.60, };
+static int naccess_DA_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue naccess_DA_cfg = {
     .name = "DA", .n_atoms = 10,
     .atom_name = (char**) naccess_DA_atom_name,
     .atom_radius = (double*) naccess_DA_atom_radius,
     .atom_class = (int*) naccess_DA_atom_class };
 
-static const char *naccess_DC_atom_name[] = {"C6", "N1", "C5", "N3", "O2", "C4", "C2", "N4", };
-static double naccess_DC_atom_radius[] = {1.80, 1.60, 1.80, 1.60, 1.40, 1.80, 1.80, 1.60, };
-static int naccess_DC_atom_class[] = {0, 1, 0, 1, 1, 0, 0, 1, };
+static const char *naccess_DC_atom_name[] = {"C2", "C4", "C5", "C6", "N1", "N3", "N4", "O2", };
+static double naccess_DC_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.60, 1.40, };
+static int naccess_DC_atom_class[] = {0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue naccess_DC_cfg = {
     .name = "DC", .n_atoms = 8,
     .atom_name = (char**) naccess_DC_atom_name,
     .atom_radius = (double*) naccess_DC_atom_radius,
     .atom_class = (int*) naccess_DC_atom_class };
 
-static const char *naccess_DG_atom_name[] = {"N1", "C6", "C5", "N9", "N3", "N2", "N7", "C4", "C8", "O6", "C2", };
-static double naccess_DG_atom_radius[] = {1.60, 1.80, 1.80, 1.60, 1.60, 1.60, 1.60, 1.80, 1.80, 1.40, 1.80, };
-static int naccess_DG_atom_class[] = {1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0, };
+static const char *naccess_DG_atom_name[] = {"C2", "C4", "C5", "C6", "C8", "N1", "N2", "N3", "N7", "N9", "O6", };
+static double naccess_DG_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.60, 1.60, 1.60, 1.40, };
+static int naccess_DG_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue naccess_DG_cfg = {
     .name = "DG", .n_atoms = 11,
     .atom_name = (char**) naccess_DG_atom_name,
     .atom_radius = (double*) naccess_DG_atom_radius,
     .atom_class = (int*) naccess_DG_atom_class };
 
-static const char *naccess_DI_atom_name[] = {"N1", "C6", "C5", "N9", "N3", "N7", "C4", "C8", "O6", "C2", };
-static double naccess_DI_atom_radius[] = {1.60, 1.80, 1.80, 1.60, 1.60, 1.60, 1.80, 1.80, 1.40, 1.80, };
-static int naccess_DI_atom_class[] = {1, 0, 0, 1, 1, 1, 0, 0, 1, 0, };
+static const char *naccess_DI_atom_name[] = {"C2", "C4", "C5", "C6", "C8", "N1", "N3", "N7", "N9", "O6", };
+static double naccess_DI_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.60, 1.60, 1.40, };
+static int naccess_DI_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue naccess_DI_cfg = {
     .name = "DI", .n_atoms = 10,
     .atom_name = (char**) naccess_DI_atom_name,
     .atom_radius = (double*) naccess_DI_atom_radius,
     .atom_class = (int*) naccess_DI_atom_class };
 
-static const char *naccess_DT_atom_name[] = {"C6", "N1", "C5", "N3", "O2", "C7", "C4", "O4", "C2", };
-static double naccess_DT_atom_radius[] = {1.80, 1.60, 1.80, 1.60, 1.40, 1.80, 1.80, 1.40, 1.80, };
-static int naccess_DT_atom_class[] = {0, 1, 0, 1, 1, 0, 0, 1, 0, };
+static const char *naccess_DT_atom_name[] = {"C2", "C4", "C5", "C6", "C7", "N1", "N3", "O2", "O4", };
+static double naccess_DT_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.40, 1.40, };
+static int naccess_DT_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue naccess_DT_cfg = {
     .name = "DT", .n_atoms = 9,
     .atom_name = (char**) naccess_DT_atom_name,
     .atom_radius = (double*) naccess_DT_atom_radius,
     .atom_class = (int*) naccess_DT_atom_class };
 
-static const char *naccess_DU_atom_name[] = {"C6", "N1", "C5", "N3", "O2", "C4", "O4", "C2", };
-static double naccess_DU_atom_radius[] = {1.80, 1.60, 1.80, 1.60, 1.40, 1.80, 1.40, 1.80, };
-static int naccess_DU_atom_class[] = {0, 1, 0, 1, 1, 0, 1, 0, };
+static const char *naccess_DU_atom_name[] = {"C2", "C4", "C5", "C6", "N1", "N3", "O2", "O4", };
+static double naccess_DU_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.40, 1.40, };
+static int naccess_DU_atom_class[] = {0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue naccess_DU_cfg = {
     .name = "DU", .n_atoms = 8,
     .atom_name = (char**) naccess_DU_atom_name,
     .atom_radius = (double*) naccess_DU_atom_radius,
     .atom_class = (int*) naccess_DU_atom_class };
 
-static const char *naccess_G_atom_name[] = {"N1", "C6", "C5", "N9", "N3", "N2", "N7", "C4", "C8", "O6", "C2", };
-static double naccess_G_atom_radius[] = {1.60, 1.80, 1.80, 1.60, 1.60, 1.60, 1.60, 1.80, 1.80, 1.40, 1.80, };
-static int naccess_G_atom_class[] = {1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0, };
+static const char *naccess_G_atom_name[] = {"C2", "C4", "C5", "C6", "C8", "N1", "N2", "N3", "N7", "N9", "O6", };
+static double naccess_G_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.60, 1.60, 1.60, 1.40, };
+static int naccess_G_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue naccess_G_cfg = {
     .name = "G", .n_atoms = 11,
     .atom_name = (char**) naccess_G_atom_name,
     .atom_radius = (double*) naccess_G_atom_radius,
     .atom_class = (int*) naccess_G_atom_class };
 
-static const char *naccess_GLN_atom_name[] = {"CD", "NE2", "OE1", "CG", };
-static double naccess_GLN_atom_radius[] = {1.76, 1.65, 1.40, 1.87, };
-static int naccess_GLN_atom_class[] = {0, 1, 1, 0, };
+static const char *naccess_GLN_atom_name[] = {"CD", "CG", "NE2", "OE1", };
+static double naccess_GLN_atom_radius[] = {1.76, 1.87, 1.65, 1.40, };
+static int naccess_GLN_atom_class[] = {0, 0, 1, 1, };
 static struct classifier_residue naccess_GLN_cfg = {
     .name = "GLN", .n_atoms = 4,
     .atom_name = (char**) naccess_GLN_atom_name,
     .atom_radius = (double*) naccess_GLN_atom_radius,
     .atom_class = (int*) naccess_GLN_atom_class };
 
-static const char *naccess_GLU_atom_name[] = {"OE2", "CD", "OE1", "CG", };
-static double naccess_GLU_atom_radius[] = {1.40, 1.76, 1.40, 1.87, };
-static int naccess_GLU_atom_class[] = {1, 0, 1, 0, };
+static const char *naccess_GLU_atom_name[] = {"CD", "CG", "OE1", "OE2", };
+static double naccess_GLU_atom_radius[] = {1.76, 1.87, 1.40, 1.40, };
+static int naccess_GLU_atom_class[] = {0, 0, 1, 1, };
 static struct classifier_residue naccess_GLU_cfg = {
     .name = "GLU", .n_atoms = 4,
     .atom_name = (char**) naccess_GLU_atom_name,
     .atom_radius = (double*) naccess_GLU_atom_radius,
     .atom_class = (int*) naccess_GLU_atom_class };
 
-static const char *naccess_HIS_atom_name[] = {"CD2", "NE2", "CE1", "CG", "ND1", };
-static double naccess_HIS_atom_radius[] = {1.76, 1.65, 1.76, 1.76, 1.65, };
-static int naccess_HIS_atom_class[] = {0, 1, 0, 0, 1, };
+static const char *naccess_HIS_atom_name[] = {"CD2", "CE1", "CG", "ND1", "NE2", };
+static double naccess_HIS_atom_radius[] = {1.76, 1.76, 1.76, 1.65, 1.65, };
+static int naccess_HIS_atom_class[] = {0, 0, 0, 1, 1, };
 static struct classifier_residue naccess_HIS_cfg = {
     .name = "HIS", .n_atoms = 5,
     .atom_name = (char**) naccess_HIS_atom_name,
     .atom_radius = (double*) naccess_HIS_atom_radius,
     .atom_class = (int*) naccess_HIS_atom_class };
 
-static const char *naccess_I_atom_name[] = {"N1", "C6", "C5", "N9", "N3", "N7", "C4", "C8", "O6", "C2", };
-static double naccess_I_atom_radius[] = {1.60, 1.80, 1.80, 1.60, 1.60, 1.60, 1.80, 1.80, 1.40, 1.80, };
-static int naccess_I_atom_class[] = {1, 0, 0, 1, 1, 1, 0, 0, 1, 0, };
+static const char *naccess_I_atom_name[] = {"C2", "C4", "C5", "C6", "C8", "N1", "N3", "N7", "N9", "O6", };
+static double naccess_I_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.60, 1.60, 1.40, };
+static int naccess_I_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue naccess_I_cfg = {
     .name = "I", .n_atoms = 10,
     .atom_name = (char**) naccess_I_atom_name,
     .atom_radius = (double*) naccess_I_atom_radius,
     .atom_class = (int*) naccess_I_atom_class };
 
-static const char *naccess_ILE_atom_name[] = {"CD1", "CG2", "CG1", };
+static const char *naccess_ILE_atom_name[] = {"CD1", "CG1", "CG2", };
 static double naccess_ILE_atom_radius[] = {1.87, 1.87, 1.87, };
 static int naccess_ILE_atom_class[] = {0, 0, 0, };
 static struct classifier_residue naccess_ILE_cfg = {
@@ -176,7 +176,7 @@ static struct classifier_residue naccess_ILE_cfg = {
     .atom_radius = (double*) naccess_ILE_atom_radius,
     .atom_class = (int*) naccess_ILE_atom_class };
 
-static const char *naccess_LEU_atom_name[] = {"CD2", "CD1", "CG", };
+static const char *naccess_LEU_atom_name[] = {"CD1", "CD2", "CG", };
 static double naccess_LEU_atom_radius[] = {1.87, 1.87, 1.87, };
 static int naccess_LEU_atom_class[] = {0, 0, 0, };
 static struct classifier_residue naccess_LEU_cfg = {
@@ -185,7 +185,7 @@ static struct classifier_residue naccess_LEU_cfg = {
     .atom_radius = (double*) naccess_LEU_atom_radius,
     .atom_class = (int*) naccess_LEU_atom_class };
 
-static const char *naccess_LYS_atom_name[] = {"CD", "CG", "CE", "NZ", };
+static const char *naccess_LYS_atom_name[] = {"CD", "CE", "CG", "NZ", };
 static double naccess_LYS_atom_radius[] = {1.87, 1.87, 1.87, 1.50, };
 static int naccess_LYS_atom_class[] = {0, 0, 0, 1, };
 static struct classifier_residue naccess_LYS_cfg = {
@@ -194,7 +194,7 @@ static struct classifier_residue naccess_LYS_cfg = {
     .atom_radius = (double*) naccess_LYS_atom_radius,
     .atom_class = (int*) naccess_LYS_atom_class };
 
-static const char *naccess_MET_atom_name[] = {"CG", "CE", "SD", };
+static const char *naccess_MET_atom_name[] = {"CE", "CG", "SD", };
 static double naccess_MET_atom_radius[] = {1.87, 1.87, 1.85, };
 static int naccess_MET_atom_class[] = {0, 0, 0, };
 static struct classifier_residue naccess_MET_cfg = {
@@ -203,7 +203,7 @@ static struct classifier_residue naccess_MET_cfg = {
     .atom_radius = (double*) naccess_MET_atom_radius,
     .atom_class = (int*) naccess_MET_atom_class };
 
-static const char *naccess_PHE_atom_name[] = {"CD2", "CD1", "CZ", "CE1", "CG", "CE2", };
+static const char *naccess_PHE_atom_name[] = {"CD1", "CD2", "CE1", "CE2", "CG", "CZ", };
 static double naccess_PHE_atom_radius[] = {1.76, 1.76, 1.76, 1.76, 1.76, 1.76, };
 static int naccess_PHE_atom_class[] = {0, 0, 0, 0, 0, 0, };
 static struct classifier_residue naccess_PHE_cfg = {
@@ -239,9 +239,9 @@ static struct classifier_residue naccess_SER_cfg = {
     .atom_radius = (double*) naccess_SER_atom_radius,
     .atom_class = (int*) naccess_SER_atom_class };
 
-static const char *naccess_T_atom_name[] = {"C6", "N1", "C5", "N3", "O2", "C7", "C4", "O4", "C2", };
-static double naccess_T_atom_radius[] = {1.80, 1.60, 1.80, 1.60, 1.40, 1.80, 1.80, 1.40, 1.80, };
-static int naccess_T_atom_class[] = {0, 1, 0, 1, 1, 0, 0, 1, 0, };
+static const char *naccess_T_atom_name[] = {"C2", "C4", "C5", "C6", "C7", "N1", "N3", "O2", "O4", };
+static double naccess_T_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.40, 1.40, };
+static int naccess_T_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue naccess_T_cfg = {
     .name = "T", .n_atoms = 9,
     .atom_name = (char**) naccess_T_atom_name,
@@ -257,34 +257,34 @@ static struct classifier_residue naccess_THR_cfg = {
     .atom_radius = (double*) naccess_THR_atom_radius,
     .atom_class = (int*) naccess_THR_atom_class };
 
-static const char *naccess_TRP_atom_name[] = {"CZ2", "CE2", "NE1", "CD1", "CD2", "CH2", "CG", "CE3", "CZ3", };
-static double naccess_TRP_atom_radius[] = {1.76, 1.76, 1.65, 1.76, 1.76, 1.76, 1.76, 1.76, 1.76, };
-static int naccess_TRP_atom_class[] = {0, 0, 1, 0, 0, 0, 0, 0, 0, };
+static const char *naccess_TRP_atom_name[] = {"CD1", "CD2", "CE2", "CE3", "CG", "CH2", "CZ2", "CZ3", "NE1", };
+static double naccess_TRP_atom_radius[] = {1.76, 1.76, 1.76, 1.76, 1.76, 1.76, 1.76, 1.76, 1.65, };
+static int naccess_TRP_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, };
 static struct classifier_residue naccess_TRP_cfg = {
     .name = "TRP", .n_atoms = 9,
     .atom_name = (char**) naccess_TRP_atom_name,
     .atom_radius = (double*) naccess_TRP_atom_radius,
     .atom_class = (int*) naccess_TRP_atom_class };
 
-static const char *naccess_TYR_atom_name[] = {"CD2", "CD1", "CZ", "CE1", "CG", "OH", "CE2", };
-static double naccess_TYR_atom_radius[] = {1.76, 1.76, 1.76, 1.76, 1.76, 1.40, 1.76, };
-static int naccess_TYR_atom_class[] = {0, 0, 0, 0, 0, 1, 0, };
+static const char *naccess_TYR_atom_name[] = {"CD1", "CD2", "CE1", "CE2", "CG", "CZ", "OH", };
+static double naccess_TYR_atom_radius[] = {1.76, 1.76, 1.76, 1.76, 1.76, 1.76, 1.40, };
+static int naccess_TYR_atom_class[] = {0, 0, 0, 0, 0, 0, 1, };
 static struct classifier_residue naccess_TYR_cfg = {
     .name = "TYR", .n_atoms = 7,
     .atom_name = (char**) naccess_TYR_atom_name,
     .atom_radius = (double*) naccess_TYR_atom_radius,
     .atom_class = (int*) naccess_TYR_atom_class };
 
-static const char *naccess_U_atom_name[] = {"C6", "N1", "C5", "N3", "O2", "C4", "O4", "C2", };
-static double naccess_U_atom_radius[] = {1.80, 1.60, 1.80, 1.60, 1.40, 1.80, 1.40, 1.80, };
-static int naccess_U_atom_class[] = {0, 1, 0, 1, 1, 0, 1, 0, };
+static const char *naccess_U_atom_name[] = {"C2", "C4", "C5", "C6", "N1", "N3", "O2", "O4", };
+static double naccess_U_atom_radius[] = {1.80, 1.80, 1.80, 1.80, 1.60, 1.60, 1.40, 1.40, };
+static int naccess_U_atom_class[] = {0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue naccess_U_cfg = {
     .name = "U", .n_atoms = 8,
     .atom_name = (char**) naccess_U_atom_name,
     .atom_radius = (double*) naccess_U_atom_radius,
     .atom_class = (int*) naccess_U_atom_class };
 
-static const char *naccess_VAL_atom_name[] = {"CG2", "CG1", };
+static const char *naccess_VAL_atom_name[] = {"CG1", "CG2", };
 static double naccess_VAL_atom_radius[] = {1.87, 1.87, };
 static int naccess_VAL_atom_class[] = {0, 0, };
 static struct classifier_residue naccess_VAL_cfg = {
@@ -293,6 +293,74 @@ static struct classifier_residue naccess_VAL_cfg = {
     .atom_radius = (double*) naccess_VAL_atom_radius,
     .atom_class = (int*) naccess_VAL_atom_class };
 
+/* Hash table for looking up atoms, at most 5 probes per atom */
+static struct classifier_entry naccess_table[] = {
+    {-1, -1}, {-1, -1}, {-1, -1}, {17, 7}, {-1, -1}, {-1, -1}, {28, 5}, {18, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {5, 7}, {1, 17}, {17, 8}, {5, 2}, {-1, -1},
+    {-1, -1}, {-1, -1}, {1, 11}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {10, 0}, {26, 4}, {30, 7}, {29, 4}, {13, 5},
+    {-1, -1}, {12, 5}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 18}, {7, 1}, {7, 9},
+    {9, 7}, {-1, -1}, {-1, -1}, {-1, -1}, {11, 8}, {15, 0}, {16, 0}, {16, 3},
+    {-1, -1}, {8, 4}, {28, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {20, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {2, 4}, {-1, -1},
+    {9, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {12, 6}, {-1, -1}, {-1, -1}, {12, 2}, {17, 6},
+    {0, 2}, {1, 1}, {23, 0}, {-1, -1}, {-1, -1}, {9, 10}, {11, 5}, {-1, -1},
+    {-1, -1}, {20, 3}, {-1, -1}, {-1, -1}, {28, 6}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {10, 7}, {22, 0}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {10, 3},
+    {-1, -1}, {7, 8}, {18, 0}, {0, 8}, {29, 2}, {14, 2}, {31, 1}, {-1, -1},
+    {-1, -1}, {7, 4}, {17, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {11, 4}, {22, 5}, {1, 8}, {5, 3}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {30, 1},
+    {26, 3}, {-1, -1}, {-1, -1}, {10, 9}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {7, 2}, {-1, -1}, {9, 6}, {29, 5}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 0}, {3, 0}, {-1, -1}, {28, 0},
+    {-1, -1}, {-1, -1}, {26, 8}, {13, 10}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {10, 4}, {-1, -1}, {2, 5}, {-1, -1}, {10, 6}, {1, 3}, {28, 8},
+    {-1, -1}, {-1, -1}, {-1, -1}, {7, 0}, {4, 2}, {7, 6}, {9, 9}, {0, 6},
+    {9, 4}, {13, 1}, {13, 9}, {5, 4}, {12, 3}, {17, 0}, {-1, -1}, {-1, -1},
+    {-1, -1}, {19, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {0, 4},
+    {5, 0}, {8, 1}, {14, 1}, {30, 5}, {26, 5}, {-1, -1}, {29, 0}, {22, 1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {29, 6}, {26, 0}, {-1, -1}, {7, 7}, {-1, -1},
+    {0, 7}, {2, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {16, 4}, {-1, -1},
+    {-1, -1}, {-1, -1}, {2, 0}, {-1, -1}, {-1, -1}, {15, 1}, {11, 3}, {-1, -1},
+    {1, 9}, {-1, -1}, {8, 6}, {14, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {10, 8},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {30, 2}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {9, 3}, {13, 8}, {12, 4}, {22, 4}, {-1, -1}, {-1, -1}, {7, 3},
+    {17, 4}, {1, 16}, {13, 4}, {16, 2}, {-1, -1}, {-1, -1}, {11, 7}, {12, 0},
+    {-1, -1}, {0, 3}, {1, 12}, {8, 5}, {-1, -1}, {21, 1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {22, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {13, 2}, {-1, -1}, {-1, -1}, {25, 0}, {31, 0}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {1, 10}, {-1, -1}, {28, 4}, {-1, -1}, {-1, -1},
+    {11, 6}, {26, 7}, {11, 0}, {-1, -1}, {8, 2}, {-1, -1}, {-1, -1}, {14, 0},
+    {-1, -1}, {-1, -1}, {-1, -1}, {29, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {1, 13}, {26, 2}, {-1, -1}, {13, 0}, {1, 5}, {0, 9}, {9, 0}, {13, 7},
+    {-1, -1}, {-1, -1}, {-1, -1}, {17, 1}, {-1, -1}, {9, 5}, {19, 1}, {2, 1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {11, 2}, {-1, -1}, {0, 0}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {17, 9}, {20, 1}, {-1, -1},
+    {-1, -1}, {30, 0}, {-1, -1}, {-1, -1}, {21, 2}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {4, 1}, {1, 15}, {28, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {5, 6}, {17, 5}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {1, 7}, {-1, -1}, {-1, -1}, {27, 0}, {-1, -1}, {22, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {15, 2}, {10, 5},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 4}, {10, 1}, {7, 5},
+    {13, 3}, {30, 6}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {3, 1}, {18, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {5, 1}, {8, 0}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {30, 3}, {26, 1}, {4, 0},
+    {-1, -1}, {-1, -1}, {13, 6}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 2},
+    {17, 2}, {-1, -1}, {-1, -1}, {19, 0}, {-1, -1}, {12, 7}, {-1, -1}, {-1, -1},
+    {11, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {16, 1}, {-1, -1}, {20, 0}, {-1, -1}, {-1, -1}, {8, 7}, {24, 0}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {9, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {1, 14}, {2, 3}, {0, 5}, {3, 2}, {9, 8},
+    {28, 3}, {5, 5}, {12, 1}, {0, 1}, {23, 1}, {-1, -1}, {-1, -1}, {1, 6},
+    {21, 0}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {8, 3}, {-1, -1}, {28, 7},
+    {27, 1}, {30, 4}, {26, 6}, {15, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {10, 2}, {-1, -1}, {6, 0}, {-1, -1}, {29, 3}, {-1, -1},
+};
+
 static struct classifier_residue *naccess_residue_cfg[] = {
     &naccess_A_cfg, &naccess_ANY_cfg, &naccess_ARG_cfg, &naccess_ASN_cfg, &naccess_ASP_cfg, &naccess_C_cfg, &naccess_CYS_cfg, &naccess_DA_cfg, &naccess_DC_cfg, &naccess_DG_cfg, &naccess_DI_cfg, &naccess_DT_cfg, &naccess_DU_cfg, &naccess_G_cfg, &naccess_GLN_cfg, &naccess_GLU_cfg, &naccess_HIS_cfg, &naccess_I_cfg, &naccess_ILE_cfg, &naccess_LEU_cfg, &naccess_LYS_cfg, &naccess_MET_cfg, &naccess_PHE_cfg, &naccess_PRO_cfg, &naccess_SEC_cfg, &naccess_SER_cfg, &naccess_T_cfg, &naccess_THR_cfg, &naccess_TRP_cfg, &naccess_TYR_cfg, &naccess_U_cfg, &naccess_VAL_cfg, };
 
@@ -300,7 +368,9 @@ static struct classifier_config naccess_auto_config = {
     .n_residues = 32, .n_classes = 2,
     .residue_name = (char**) naccess_residue_name,
     .class_name = (char**) naccess_class_name,
-    .residue = (struct classifier_residue **) naccess_residue_cfg
+    .residue = (struct classifier_residue **) naccess_residue_cfg,
+    .table_size = 512,
+    .table = naccess_table
 };
 
 static void naccess_dummy_free(void *arg) {}
@@ -14,26 +14,26 @@ static struct classifier_residue oons_ACE_cfg = {
     .atom_radius = (double*) oons_ACE_atom_radius,
     .atom_class = (int*) oons_ACE_atom_class };
 
-static const char *oons_ANY_atom_name[] = {"OXT", "P", "N", "C", "N7", "O5'", "C1'", "O2", "OP1", "CM2", "N3", "N9", "CA", "C7", "C4", "OP3", "C8", "O4", "N4", "OP2", "C5", "N6", "C5'", "O3'", "C4'", "C3'", "N2", "C2", "O2'", "C2'", "O4'", "N1", "O6", "CB", "O", "C6", };
-static double oons_ANY_atom_radius[] = {1.40, 1.80, 1.55, 1.55, 1.55, 1.40, 1.75, 1.40, 1.40, 2.00, 1.55, 1.55, 2.00, 1.75, 1.75, 1.40, 1.75, 1.40, 1.55, 1.40, 1.75, 1.55, 2.00, 1.40, 1.75, 1.75, 1.55, 1.75, 1.40, 1.75, 1.40, 1.55, 1.40, 2.00, 1.40, 1.75, };
-static int oons_ANY_atom_class[] = {1, 1, 1, 1, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, };
+static const char *oons_ANY_atom_name[] = {"C", "C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C7", "C8", "CA", "CB", "CM2", "N", "N1", "N2", "N3", "N4", "N6", "N7", "N9", "O", "O2", "O2'", "O3'", "O4", "O4'", "O5'", "O6", "OP1", "OP2", "OP3", "OXT", "P", };
+static double oons_ANY_atom_radius[] = {1.55, 1.75, 1.75, 1.75, 1.75, 1.75, 1.75, 1.75, 2.00, 1.75, 1.75, 1.75, 2.00, 2.00, 2.00, 1.55, 1.55, 1.55, 1.55, 1.55, 1.55, 1.55, 1.55, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.40, 1.80, };
+static int oons_ANY_atom_class[] = {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue oons_ANY_cfg = {
     .name = "ANY", .n_atoms = 36,
     .atom_name = (char**) oons_ANY_atom_name,
     .atom_radius = (double*) oons_ANY_atom_radius,
     .atom_class = (int*) oons_ANY_atom_class };
 
-static const char *oons_ARG_atom_name[] = {"CG", "CZ", "NH2", "NH1", "CD", "NE", };
-static double oons_ARG_atom_radius[] = {2.00, 2.00, 1.55, 1.55, 2.00, 1.55, };
-static int oons_ARG_atom_class[] = {0, 0, 1, 1, 0, 1, };
+static const char *oons_ARG_atom_name[] = {"CD", "CG", "CZ", "NE", "NH1", "NH2", };
+static double oons_ARG_atom_radius[] = {2.00, 2.00, 2.00, 1.55, 1.55, 1.55, };
+static int oons_ARG_atom_class[] = {0, 0, 0, 1, 1, 1, };
 static struct classifier_residue oons_ARG_cfg = {
     .name = "ARG", .n_atoms = 6,
     .atom_name = (char**) oons_ARG_atom_name,
     .atom_radius = (double*) oons_ARG_atom_radius,
     .atom_class = (int*) oons_ARG_atom_class };
 
-static const char *oons_ASN_atom_name[] = {"ND2", "OD1", "CG", };
-static double oons_ASN_atom_radius[] = {1.55, 1.40, 1.55, };
+static const char *oons_ASN_atom_name[] = {"CG", "ND2", "OD1", };
+static double oons_ASN_atom_radius[] = {1.55, 1.55, 1.40, };
 static int oons_ASN_atom_class[] = {1, 1, 1, };
 static struct classifier_residue oons_ASN_cfg = {
     .name = "ASN", .n_atoms = 3,
@@ -41,8 +41,8 @@ static struct classifier_residue oons_ASN_cfg = {
     .atom_radius = (double*) oons_ASN_atom_radius,
     .atom_class = (int*) oons_ASN_atom_class };
 
-static const char *oons_ASP_atom_name[] = {"OD1", "OD2", "CG", };
-static double oons_ASP_atom_radius[] = {1.40, 1.40, 1.55, };
+static const char *oons_ASP_atom_name[] = {"CG", "OD1", "OD2", };
+static double oons_ASP_atom_radius[] = {1.55, 1.40, 1.40, };
 static int oons_ASP_atom_class[] = {1, 1, 1, };
 static struct classifier_residue oons_ASP_cfg = {
     .name = "ASP", .n_atoms = 3,
@@ -50,8 +50,8 @@ static struct classifier_residue oons_ASP_cfg = {
     .atom_radius = (double*) oons_ASP_atom_radius,
     .atom_class = (int*) oons_ASP_atom_class };
 
-static const char *oons_ASX_atom_name[] = {"AD1", "CG", "XD2", "XD1", "AD2", };
-static double oons_ASX_atom_radius[] = {1.5, 1.55, 1.5, 1.5, 1.5, };
+static const char *oons_ASX_atom_name[] = {"AD1", "AD2", "CG", "XD1", "XD2", };
+static double oons_ASX_atom_radius[] = {1.5, 1.5, 1.55, 1.5, 1.5, };
 static int oons_ASX_atom_class[] = {1, 1, 1, 1, 1, };
 static struct classifier_residue oons_ASX_cfg = {
     .name = "ASX", .n_atoms = 5,
@@ -77,17 +77,17 @@ static struct classifier_residue oons_CYS_cfg = {
     .atom_radius = (double*) oons_CYS_atom_radius,
     .atom_class = (int*) oons_CYS_atom_class };
 
-static const char *oons_GLN_atom_name[] = {"CD", "NE2", "CG", "OE1", };
-static double oons_GLN_atom_radius[] = {1.55, 1.55, 2.00, 1.40, };
-static int oons_GLN_atom_class[] = {1, 1, 0, 1, };
+static const char *oons_GLN_atom_name[] = {"CD", "CG", "NE2", "OE1", };
+static double oons_GLN_atom_radius[] = {1.55, 2.00, 1.55, 1.40, };
+static int oons_GLN_atom_class[] = {1, 0, 1, 1, };
 static struct classifier_residue oons_GLN_cfg = {
     .name = "GLN", .n_atoms = 4,
     .atom_name = (char**) oons_GLN_atom_name,
     .atom_radius = (double*) oons_GLN_atom_radius,
     .atom_class = (int*) oons_GLN_atom_class };
 
-static const char *oons_GLU_atom_name[] = {"OE2", "CG", "OE1", "CD", };
-static double oons_GLU_atom_radius[] = {1.40, 2.00, 1.40, 1.55, };
+static const char *oons_GLU_atom_name[] = {"CD", "CG", "OE1", "OE2", };
+static double oons_GLU_atom_radius[] = {1.55, 2.00, 1.40, 1.40, };
 static int oons_GLU_atom_class[] = {1, 0, 1, 1, };
 static struct classifier_residue oons_GLU_cfg = {
     .name = "GLU", .n_atoms = 4,
@@ -95,18 +95,18 @@ static struct classifier_residue oons_GLU_cfg = {
     .atom_radius = (double*) oons_GLU_atom_radius,
     .atom_class = (int*) oons_GLU_atom_class };
 
-static const char *oons_GLX_atom_name[] = {"XE1", "AE1", "CD", "XE2", "CG", "AE2", };
-static double oons_GLX_atom_radius[] = {1.5, 1.5, 1.55, 1.5, 2.00, 1.5, };
-static int oons_GLX_atom_class[] = {1, 1, 1, 1, 0, 1, };
+static const char *oons_GLX_atom_name[] = {"AE1", "AE2", "CD", "CG", "XE1", "XE2", };
+static double oons_GLX_atom_radius[] = {1.5, 1.5, 1.55, 2.00, 1.5, 1.5, };
+static int oons_GLX_atom_class[] = {1, 1, 1, 0, 1, 1, };
 static struct classifier_residue oons_GLX_cfg = {
     .name = "GLX", .n_atoms = 6,
     .atom_name = (char**) oons_GLX_atom_name,
     .atom_radius = (double*) oons_GLX_atom_radius,
     .atom_class = (int*) oons_GLX_atom_class };
 
-static const char *oons_HIS_atom_name[] = {"CE1", "ND1", "CG", "CD2", "NE2", };
-static double oons_HIS_atom_radius[] = {1.75, 1.55, 1.75, 1.75, 1.55, };
-static int oons_HIS_atom_class[] = {0, 1, 0, 0, 1, };
+static const char *oons_HIS_atom_name[] = {"CD2", "CE1", "CG", "ND1", "NE2", };
+static double oons_HIS_atom_radius[] = {1.75, 1.75, 1.75, 1.55, 1.55, };
+static int oons_HIS_atom_class[] = {0, 0, 0, 1, 1, };
 static struct classifier_residue oons_HIS_cfg = {
     .name = "HIS", .n_atoms = 5,
     .atom_name = (char**) oons_HIS_atom_name,
@@ -122,7 +122,7 @@ static struct classifier_residue oons_HOH_cfg = {
     .atom_radius = (double*) oons_HOH_atom_radius,
     .atom_class = (int*) oons_HOH_atom_class };
 
-static const char *oons_ILE_atom_name[] = {"CD1", "CG2", "CG1", };
+static const char *oons_ILE_atom_name[] = {"CD1", "CG1", "CG2", };
 static double oons_ILE_atom_radius[] = {2.00, 2.00, 2.00, };
 static int oons_ILE_atom_class[] = {0, 0, 0, };
 static struct classifier_residue oons_ILE_cfg = {
@@ -131,7 +131,7 @@ static struct classifier_residue oons_ILE_cfg = {
     .atom_radius = (double*) oons_ILE_atom_radius,
     .atom_class = (int*) oons_ILE_atom_class };
 
-static const char *oons_LEU_atom_name[] = {"CG", "CD2", "CD1", };
+static const char *oons_LEU_atom_name[] = {"CD1", "CD2", "CG", };
 static double oons_LEU_atom_radius[] = {2.00, 2.00, 2.00, };
 static int oons_LEU_atom_class[] = {0, 0, 0, };
 static struct classifier_residue oons_LEU_cfg = {
@@ -140,9 +140,9 @@ static struct classifier_residue oons_LEU_cfg = {
     .atom_radius = (double*) oons_LEU_atom_radius,
     .atom_class = (int*) oons_LEU_atom_class };
 
-static const char *oons_LYS_atom_name[] = {"CD", "NZ", "CG", "CE", };
-static double oons_LYS_atom_radius[] = {2.00, 1.55, 2.00, 2.00, };
-static int oons_LYS_atom_class[] = {0, 1, 0, 0, };
+static const char *oons_LYS_atom_name[] = {"CD", "CE", "CG", "NZ", };
+static double oons_LYS_atom_radius[] = {2.00, 2.00, 2.00, 1.55, };
+static int oons_LYS_atom_class[] = {0, 0, 0, 1, };
 static struct classifier_residue oons_LYS_cfg = {
     .name = "LYS", .n_atoms = 4,
     .atom_name = (char**) oons_LYS_atom_name,
@@ -167,7 +167,7 @@ static struct classifier_residue oons_NH2_cfg = {
     .atom_radius = (double*) oons_NH2_atom_radius,
     .atom_class = (int*) oons_NH2_atom_class };
 
-static const char *oons_PHE_atom_name[] = {"CG", "CE2", "CD2", "CZ", "CE1", "CD1", };
+static const char *oons_PHE_atom_name[] = {"CD1", "CD2", "CE1", "CE2", "CG", "CZ", };
 static double oons_PHE_atom_radius[] = {1.75, 1.75, 1.75, 1.75, 1.75, 1.75, };
 static int oons_PHE_atom_class[] = {0, 0, 0, 0, 0, 0, };
 static struct classifier_residue oons_PHE_cfg = {
@@ -176,7 +176,7 @@ static struct classifier_residue oons_PHE_cfg = {
     .atom_radius = (double*) oons_PHE_atom_radius,
     .atom_class = (int*) oons_PHE_atom_class };
 
-static const char *oons_PRO_atom_name[] = {"CG", "CD", "CB", };
+static const char *oons_PRO_atom_name[] = {"CB", "CD", "CG", };
 static double oons_PRO_atom_radius[] = {1.75, 1.75, 1.75, };
 static int oons_PRO_atom_class[] = {0, 0, 0, };
 static struct classifier_residue oons_PRO_cfg = {
@@ -185,9 +185,9 @@ static struct classifier_residue oons_PRO_cfg = {
     .atom_radius = (double*) oons_PRO_atom_radius,
     .atom_class = (int*) oons_PRO_atom_class };
 
-static const char *oons_PYL_atom_name[] = {"CD2", "CG", "CE2", "CA2", "N2", "CB2", "NZ", "CG2", "CE", "C2", "O2", "CD", };
-static double oons_PYL_atom_radius[] = {1.75, 2.00, 1.75, 1.75, 1.55, 2.00, 1.55, 1.75, 2.00, 1.55, 1.40, 2.00, };
-static int oons_PYL_atom_class[] = {0, 0, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, };
+static const char *oons_PYL_atom_name[] = {"C2", "CA2", "CB2", "CD", "CD2", "CE", "CE2", "CG", "CG2", "N2", "NZ", "O2", };
+static double oons_PYL_atom_radius[] = {1.55, 1.75, 2.00, 2.00, 1.75, 2.00, 1.75, 2.00, 1.75, 1.55, 1.55, 1.40, };
+static int oons_PYL_atom_class[] = {1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, };
 static struct classifier_residue oons_PYL_cfg = {
     .name = "PYL", .n_atoms = 12,
     .atom_name = (char**) oons_PYL_atom_name,
@@ -212,34 +212,34 @@ static struct classifier_residue oons_SER_cfg = {
     .atom_radius = (double*) oons_SER_atom_radius,
     .atom_class = (int*) oons_SER_atom_class };
 
-static const char *oons_THR_atom_name[] = {"OG1", "CG2", };
-static double oons_THR_atom_radius[] = {1.40, 2.00, };
-static int oons_THR_atom_class[] = {1, 0, };
+static const char *oons_THR_atom_name[] = {"CG2", "OG1", };
+static double oons_THR_atom_radius[] = {2.00, 1.40, };
+static int oons_THR_atom_class[] = {0, 1, };
 static struct classifier_residue oons_THR_cfg = {
     .name = "THR", .n_atoms = 2,
     .atom_name = (char**) oons_THR_atom_name,
     .atom_radius = (double*) oons_THR_atom_radius,
     .atom_class = (int*) oons_THR_atom_class };
 
-static const char *oons_TRP_atom_name[] = {"NE1", "CZ3", "CE3", "CD1", "CH2", "CZ2", "CD2", "CG", "CE2", };
-static double oons_TRP_atom_radius[] = {1.55, 1.75, 1.75, 1.75, 1.75, 1.75, 1.75, 1.75, 1.75, };
-static int oons_TRP_atom_class[] = {1, 0, 0, 0, 0, 0, 0, 0, 0, };
+static const char *oons_TRP_atom_name[] = {"CD1", "CD2", "CE2", "CE3", "CG", "CH2", "CZ2", "CZ3", "NE1", };
+static double oons_TRP_atom_radius[] = {1.75, 1.75, 1.75, 1.75, 1.75, 1.75, 1.75, 1.75, 1.55, };
+static int oons_TRP_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, };
 static struct classifier_residue oons_TRP_cfg = {
     .name = "TRP", .n_atoms = 9,
     .atom_name = (char**) oons_TRP_atom_name,
     .atom_radius = (double*) oons_TRP_atom_radius,
     .atom_class = (int*) oons_TRP_atom_class };
 
-static const char *oons_TYR_atom_name[] = {"OH", "CE2", "CG", "CD2", "CZ", "CD1", "CE1", };
-static double oons_TYR_atom_radius[] = {1.40, 1.75, 1.75, 1.75, 1.75, 1.75, 1.75, };
-static int oons_TYR_atom_class[] = {1, 0, 0, 0, 0, 0, 0, };
+static const char *oons_TYR_atom_name[] = {"CD1", "CD2", "CE1", "CE2", "CG", "CZ", "OH", };
+static double oons_TYR_atom_radius[] = {1.75, 1.75, 1.75, 1.75, 1.75, 1.75, 1.40, };
+static int oons_TYR_atom_class[] = {0, 0, 0, 0, 0, 0, 1, };
 static struct classifier_residue oons_TYR_cfg = {
     .name = "TYR", .n_atoms = 7,
     .atom_name = (char**) oons_TYR_atom_name,
     .atom_radius = (double*) oons_TYR_atom_radius,
     .atom_class = (int*) oons_TYR_atom_class };
 
-static const char *oons_VAL_atom_name[] = {"CG2", "CG1", };
+static const char *oons_VAL_atom_name[] = {"CG1", "CG2", };
 static double oons_VAL_atom_radius[] = {2.00, 2.00, };
 static int oons_VAL_atom_class[] = {0, 0, };
 static struct classifier_residue oons_VAL_cfg = {
@@ -248,6 +248,74 @@ static struct classifier_residue oons_VAL_cfg = {
     .atom_radius = (double*) oons_VAL_atom_radius,
     .atom_class = (int*) oons_VAL_atom_class };
 
+/* Hash table for looking up atoms, at most 4 probes per atom */
+static struct classifier_entry oons_table[] = {
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {24, 5}, {13, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {1, 7}, {1, 34}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {1, 26}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {10, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {25, 4}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {1, 14}, {-1, -1}, {1, 35}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 11}, {9, 0}, {11, 0}, {11, 3},
+    {-1, -1}, {-1, -1}, {24, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {15, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {2, 4}, {-1, -1},
+    {20, 7}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {19, 1},
+    {1, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 27}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {15, 3}, {-1, -1}, {-1, -1}, {24, 6}, {1, 19}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {18, 0}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {13, 0}, {-1, -1}, {25, 2}, {26, 1}, {8, 2}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {1, 5}, {18, 5}, {-1, -1}, {1, 15}, {-1, -1}, {-1, -1}, {1, 16}, {20, 10},
+    {20, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {25, 5}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 0}, {3, 0}, {-1, -1}, {24, 0},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {2, 5}, {-1, -1}, {24, 8}, {1, 4}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {4, 2}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {6, 0}, {-1, -1},
+    {-1, -1}, {14, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {8, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {25, 0}, {18, 1},
+    {-1, -1}, {10, 2}, {-1, -1}, {25, 6}, {-1, -1}, {-1, -1}, {-1, -1}, {20, 2},
+    {2, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {11, 4}, {-1, -1},
+    {-1, -1}, {-1, -1}, {2, 0}, {-1, -1}, {-1, -1}, {9, 1}, {-1, -1}, {-1, -1},
+    {1, 23}, {-1, -1}, {-1, -1}, {1, 17}, {8, 3}, {-1, -1}, {-1, -1}, {20, 0},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {20, 3}, {18, 4}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {1, 33}, {-1, -1}, {11, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {1, 28}, {-1, -1}, {-1, -1}, {-1, -1}, {16, 1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {18, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {22, 0}, {26, 0}, {-1, -1},
+    {0, 0}, {19, 0}, {-1, -1}, {1, 25}, {-1, -1}, {24, 4}, {1, 24}, {-1, -1},
+    {5, 3}, {1, 10}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 20},
+    {8, 0}, {17, 0}, {-1, -1}, {25, 1}, {20, 6}, {-1, -1}, {-1, -1}, {-1, -1},
+    {1, 29}, {-1, -1}, {-1, -1}, {20, 11}, {1, 8}, {10, 4}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {14, 1}, {2, 1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {1, 18}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {15, 1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {16, 2}, {-1, -1}, {20, 5}, {5, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {4, 1}, {1, 32}, {24, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {20, 8}, {-1, -1},
+    {-1, -1}, {-1, -1}, {1, 13}, {1, 30}, {-1, -1}, {23, 0}, {-1, -1}, {18, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {5, 1}, {9, 2},
+    {10, 1}, {20, 9}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 6}, {-1, -1}, {-1, -1},
+    {-1, -1}, {20, 4}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {3, 1}, {13, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 9}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 21}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {4, 0},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 3},
+    {-1, -1}, {-1, -1}, {-1, -1}, {14, 0}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {11, 1}, {-1, -1}, {15, 0}, {-1, -1}, {-1, -1}, {-1, -1}, {21, 0}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {1, 31}, {2, 3}, {3, 2}, {12, 0}, {24, 3},
+    {-1, -1}, {-1, -1}, {19, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {1, 22}, {1, 12},
+    {16, 0}, {5, 4}, {1, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {24, 7},
+    {23, 1}, {-1, -1}, {-1, -1}, {5, 0}, {9, 3}, {10, 0}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {7, 0}, {10, 5}, {25, 3}, {-1, -1},
+};
+
 static struct classifier_residue *oons_residue_cfg[] = {
     &oons_ACE_cfg, &oons_ANY_cfg, &oons_ARG_cfg, &oons_ASN_cfg, &oons_ASP_cfg, &oons_ASX_cfg, &oons_CSE_cfg, &oons_CYS_cfg, &oons_GLN_cfg, &oons_GLU_cfg, &oons_GLX_cfg, &oons_HIS_cfg, &oons_HOH_cfg, &oons_ILE_cfg, &oons_LEU_cfg, &oons_LYS_cfg, &oons_MET_cfg, &oons_NH2_cfg, &oons_PHE_cfg, &oons_PRO_cfg, &oons_PYL_cfg, &oons_SEC_cfg, &oons_SER_cfg, &oons_THR_cfg, &oons_TRP_cfg, &oons_TYR_cfg, &oons_VAL_cfg, };
 
@@ -255,7 +323,9 @@ static struct classifier_config oons_auto_config = {
     .n_residues = 27, .n_classes = 3,
     .residue_name = (char**) oons_residue_name,
     .class_name = (char**) oons_class_name,
-    .residue = (struct classifier_residue **) oons_residue_cfg
+    .residue = (struct classifier_residue **) oons_residue_cfg,
+    .table_size = 512,
+    .table = oons_table
 };
 
 static void oons_dummy_free(void *arg) {}
@@ -5,189 +5,189 @@
 static const char *protor_residue_name[] = {"A", "ACE", "ALA", "ARG", "ASN", "ASP", "ASX", "C", "CYS", "DA", "DC", "DG", "DI", "DT", "DU", "G", "GLN", "GLU", "GLX", "GLY", "HIS", "HOH", "I", "ILE", "LEU", "LYS", "MET", "NH2", "PHE", "PRO", "PYL", "SEC", "SER", "T", "THR", "TRP", "TYR", "U", "VAL", };
 static const char *protor_class_name[] = {"Apolar", "Polar", "Water", };
 
-static const char *protor_A_atom_name[] = {"O4'", "OP1", "OP3", "C5'", "N1", "C5", "N6", "C8", "N9", "C2", "N3", "O2'", "P", "O3'", "C4'", "N7", "C6", "OP2", "C2'", "O5'", "C1'", "C3'", "C4", };
-static double protor_A_atom_radius[] = {1.46, 1.42, 1.46, 1.88, 1.64, 1.61, 1.64, 1.76, 1.64, 1.76, 1.64, 1.46, 1.8, 1.46, 1.88, 1.64, 1.61, 1.46, 1.88, 1.46, 1.88, 1.88, 1.61, };
-static int protor_A_atom_class[] = {1, 1, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, };
+static const char *protor_A_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "N1", "N3", "N6", "N7", "N9", "O2'", "O3'", "O4'", "O5'", "OP1", "OP2", "OP3", "P", };
+static double protor_A_atom_radius[] = {1.88, 1.76, 1.88, 1.88, 1.61, 1.88, 1.61, 1.88, 1.61, 1.76, 1.64, 1.64, 1.64, 1.64, 1.64, 1.46, 1.46, 1.46, 1.46, 1.42, 1.46, 1.46, 1.8, };
+static int protor_A_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_A_cfg = {
     .name = "A", .n_atoms = 23,
     .atom_name = (char**) protor_A_atom_name,
     .atom_radius = (double*) protor_A_atom_radius,
     .atom_class = (int*) protor_A_atom_class };
 
-static const char *protor_ACE_atom_name[] = {"C", "O", "CH3", };
-static double protor_ACE_atom_radius[] = {1.76, 1.42, 1.88, };
-static int protor_ACE_atom_class[] = {0, 1, 0, };
+static const char *protor_ACE_atom_name[] = {"C", "CH3", "O", };
+static double protor_ACE_atom_radius[] = {1.76, 1.88, 1.42, };
+static int protor_ACE_atom_class[] = {0, 0, 1, };
 static struct classifier_residue protor_ACE_cfg = {
     .name = "ACE", .n_atoms = 3,
     .atom_name = (char**) protor_ACE_atom_name,
     .atom_radius = (double*) protor_ACE_atom_radius,
     .atom_class = (int*) protor_ACE_atom_class };
 
-static const char *protor_ALA_atom_name[] = {"N", "OXT", "CA", "O", "CB", "C", };
-static double protor_ALA_atom_radius[] = {1.64, 1.46, 1.88, 1.42, 1.88, 1.61, };
-static int protor_ALA_atom_class[] = {1, 1, 0, 1, 0, 0, };
+static const char *protor_ALA_atom_name[] = {"C", "CA", "CB", "N", "O", "OXT", };
+static double protor_ALA_atom_radius[] = {1.61, 1.88, 1.88, 1.64, 1.42, 1.46, };
+static int protor_ALA_atom_class[] = {0, 0, 0, 1, 1, 1, };
 static struct classifier_residue protor_ALA_cfg = {
     .name = "ALA", .n_atoms = 6,
     .atom_name = (char**) protor_ALA_atom_name,
     .atom_radius = (double*) protor_ALA_atom_radius,
     .atom_class = (int*) protor_ALA_atom_class };
 
-static const char *protor_ARG_atom_name[] = {"C", "NH1", "CD", "CG", "CB", "OXT", "NH2", "CZ", "NE", "N", "O", "CA", };
-static double protor_ARG_atom_radius[] = {1.61, 1.64, 1.88, 1.88, 1.88, 1.46, 1.64, 1.61, 1.64, 1.64, 1.42, 1.88, };
-static int protor_ARG_atom_class[] = {0, 1, 0, 0, 0, 1, 1, 0, 1, 1, 1, 0, };
+static const char *protor_ARG_atom_name[] = {"C", "CA", "CB", "CD", "CG", "CZ", "N", "NE", "NH1", "NH2", "O", "OXT", };
+static double protor_ARG_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.88, 1.61, 1.64, 1.64, 1.64, 1.64, 1.42, 1.46, };
+static int protor_ARG_atom_class[] = {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_ARG_cfg = {
     .name = "ARG", .n_atoms = 12,
     .atom_name = (char**) protor_ARG_atom_name,
     .atom_radius = (double*) protor_ARG_atom_radius,
     .atom_class = (int*) protor_ARG_atom_class };
 
-static const char *protor_ASN_atom_name[] = {"CG", "C", "OD1", "N", "OXT", "ND2", "CB", "CA", "O", };
-static double protor_ASN_atom_radius[] = {1.61, 1.61, 1.42, 1.64, 1.46, 1.64, 1.88, 1.88, 1.42, };
-static int protor_ASN_atom_class[] = {0, 0, 1, 1, 1, 1, 0, 0, 1, };
+static const char *protor_ASN_atom_name[] = {"C", "CA", "CB", "CG", "N", "ND2", "O", "OD1", "OXT", };
+static double protor_ASN_atom_radius[] = {1.61, 1.88, 1.88, 1.61, 1.64, 1.64, 1.42, 1.42, 1.46, };
+static int protor_ASN_atom_class[] = {0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_ASN_cfg = {
     .name = "ASN", .n_atoms = 9,
     .atom_name = (char**) protor_ASN_atom_name,
     .atom_radius = (double*) protor_ASN_atom_radius,
     .atom_class = (int*) protor_ASN_atom_class };
 
-static const char *protor_ASP_atom_name[] = {"OD2", "O", "CA", "C", "OD1", "CG", "CB", "OXT", "N", };
-static double protor_ASP_atom_radius[] = {1.46, 1.42, 1.88, 1.61, 1.42, 1.61, 1.88, 1.46, 1.64, };
-static int protor_ASP_atom_class[] = {1, 1, 0, 0, 1, 0, 0, 1, 1, };
+static const char *protor_ASP_atom_name[] = {"C", "CA", "CB", "CG", "N", "O", "OD1", "OD2", "OXT", };
+static double protor_ASP_atom_radius[] = {1.61, 1.88, 1.88, 1.61, 1.64, 1.42, 1.42, 1.46, 1.46, };
+static int protor_ASP_atom_class[] = {0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_ASP_cfg = {
     .name = "ASP", .n_atoms = 9,
     .atom_name = (char**) protor_ASP_atom_name,
     .atom_radius = (double*) protor_ASP_atom_radius,
     .atom_class = (int*) protor_ASP_atom_class };
 
-static const char *protor_ASX_atom_name[] = {"CG", "XD1", "C", "OXT", "N", "CB", "XD2", "CA", "O", };
-static double protor_ASX_atom_radius[] = {1.61, 1.5, 1.61, 1.46, 1.64, 1.88, 1.5, 1.88, 1.42, };
-static int protor_ASX_atom_class[] = {0, 1, 0, 1, 1, 0, 1, 0, 1, };
+static const char *protor_ASX_atom_name[] = {"C", "CA", "CB", "CG", "N", "O", "OXT", "XD1", "XD2", };
+static double protor_ASX_atom_radius[] = {1.61, 1.88, 1.88, 1.61, 1.64, 1.42, 1.46, 1.5, 1.5, };
+static int protor_ASX_atom_class[] = {0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_ASX_cfg = {
     .name = "ASX", .n_atoms = 9,
     .atom_name = (char**) protor_ASX_atom_name,
     .atom_radius = (double*) protor_ASX_atom_radius,
     .atom_class = (int*) protor_ASX_atom_class };
 
-static const char *protor_C_atom_name[] = {"OP1", "OP3", "O4'", "C5'", "N1", "C5", "C2", "O2'", "N3", "C4'", "O3'", "N4", "P", "C2'", "OP2", "C6", "O2", "C4", "C3'", "O5'", "C1'", };
-static double protor_C_atom_radius[] = {1.42, 1.46, 1.46, 1.88, 1.64, 1.76, 1.61, 1.46, 1.64, 1.88, 1.46, 1.64, 1.8, 1.88, 1.46, 1.76, 1.42, 1.61, 1.88, 1.46, 1.88, };
-static int protor_C_atom_class[] = {1, 1, 1, 0, 1, 0, 0, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, };
+static const char *protor_C_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "N1", "N3", "N4", "O2", "O2'", "O3'", "O4'", "O5'", "OP1", "OP2", "OP3", "P", };
+static double protor_C_atom_radius[] = {1.88, 1.61, 1.88, 1.88, 1.61, 1.88, 1.76, 1.88, 1.76, 1.64, 1.64, 1.64, 1.42, 1.46, 1.46, 1.46, 1.46, 1.42, 1.46, 1.46, 1.8, };
+static int protor_C_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_C_cfg = {
     .name = "C", .n_atoms = 21,
     .atom_name = (char**) protor_C_atom_name,
     .atom_radius = (double*) protor_C_atom_radius,
     .atom_class = (int*) protor_C_atom_class };
 
-static const char *protor_CYS_atom_name[] = {"C", "CB", "O", "OXT", "N", "SG", "CA", };
-static double protor_CYS_atom_radius[] = {1.61, 1.88, 1.42, 1.46, 1.64, 1.77, 1.88, };
-static int protor_CYS_atom_class[] = {0, 0, 1, 1, 1, 1, 0, };
+static const char *protor_CYS_atom_name[] = {"C", "CA", "CB", "N", "O", "OXT", "SG", };
+static double protor_CYS_atom_radius[] = {1.61, 1.88, 1.88, 1.64, 1.42, 1.46, 1.77, };
+static int protor_CYS_atom_class[] = {0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue protor_CYS_cfg = {
     .name = "CYS", .n_atoms = 7,
     .atom_name = (char**) protor_CYS_atom_name,
     .atom_radius = (double*) protor_CYS_atom_radius,
     .atom_class = (int*) protor_CYS_atom_class };
 
-static const char *protor_DA_atom_name[] = {"C2", "C8", "N9", "N6", "C5", "C5'", "N1", "OP3", "OP1", "O4'", "C4", "C1'", "O5'", "C3'", "OP2", "C2'", "N7", "C6", "C4'", "P", "O3'", "N3", };
-static double protor_DA_atom_radius[] = {1.76, 1.76, 1.64, 1.64, 1.61, 1.88, 1.64, 1.46, 1.42, 1.46, 1.61, 1.88, 1.46, 1.88, 1.46, 1.88, 1.64, 1.61, 1.88, 1.8, 1.46, 1.64, };
-static int protor_DA_atom_class[] = {0, 0, 1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 1, 1, };
+static const char *protor_DA_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "N1", "N3", "N6", "N7", "N9", "O3'", "O4'", "O5'", "OP1", "OP2", "OP3", "P", };
+static double protor_DA_atom_radius[] = {1.88, 1.76, 1.88, 1.88, 1.61, 1.88, 1.61, 1.88, 1.61, 1.76, 1.64, 1.64, 1.64, 1.64, 1.64, 1.46, 1.46, 1.46, 1.42, 1.46, 1.46, 1.8, };
+static int protor_DA_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_DA_cfg = {
     .name = "DA", .n_atoms = 22,
     .atom_name = (char**) protor_DA_atom_name,
     .atom_radius = (double*) protor_DA_atom_radius,
     .atom_class = (int*) protor_DA_atom_class };
 
-static const char *protor_DC_atom_name[] = {"N3", "O3'", "P", "N4", "C4'", "C6", "O2", "C2'", "OP2", "C3'", "C1'", "O5'", "C4", "O4'", "OP3", "OP1", "C5'", "N1", "C5", "C2", };
-static double protor_DC_atom_radius[] = {1.64, 1.46, 1.8, 1.64, 1.88, 1.76, 1.42, 1.88, 1.46, 1.88, 1.88, 1.46, 1.61, 1.46, 1.46, 1.42, 1.88, 1.64, 1.76, 1.61, };
-static int protor_DC_atom_class[] = {1, 1, 1, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 1, 1, 1, 0, 1, 0, 0, };
+static const char *protor_DC_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "N1", "N3", "N4", "O2", "O3'", "O4'", "O5'", "OP1", "OP2", "OP3", "P", };
+static double protor_DC_atom_radius[] = {1.88, 1.61, 1.88, 1.88, 1.61, 1.88, 1.76, 1.88, 1.76, 1.64, 1.64, 1.64, 1.42, 1.46, 1.46, 1.46, 1.42, 1.46, 1.46, 1.8, };
+static int protor_DC_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_DC_cfg = {
     .name = "DC", .n_atoms = 20,
     .atom_name = (char**) protor_DC_atom_name,
     .atom_radius = (double*) protor_DC_atom_radius,
     .atom_class = (int*) protor_DC_atom_class };
 
-static const char *protor_DG_atom_name[] = {"C1'", "O5'", "C3'", "C4", "N7", "C6", "OP2", "C2'", "P", "N2", "O3'", "C4'", "N3", "C8", "N9", "C2", "O6", "C5", "N1", "C5'", "O4'", "OP3", "OP1", };
-static double protor_DG_atom_radius[] = {1.88, 1.46, 1.88, 1.61, 1.64, 1.61, 1.46, 1.88, 1.8, 1.64, 1.46, 1.88, 1.64, 1.76, 1.64, 1.61, 1.42, 1.61, 1.64, 1.88, 1.46, 1.46, 1.42, };
-static int protor_DG_atom_class[] = {0, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, };
+static const char *protor_DG_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "N1", "N2", "N3", "N7", "N9", "O3'", "O4'", "O5'", "O6", "OP1", "OP2", "OP3", "P", };
+static double protor_DG_atom_radius[] = {1.88, 1.61, 1.88, 1.88, 1.61, 1.88, 1.61, 1.88, 1.61, 1.76, 1.64, 1.64, 1.64, 1.64, 1.64, 1.46, 1.46, 1.46, 1.42, 1.42, 1.46, 1.46, 1.8, };
+static int protor_DG_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_DG_cfg = {
     .name = "DG", .n_atoms = 23,
     .atom_name = (char**) protor_DG_atom_name,
     .atom_radius = (double*) protor_DG_atom_radius,
     .atom_class = (int*) protor_DG_atom_class };
 
-static const char *protor_DI_atom_name[] = {"O4'", "OP3", "OP1", "N1", "C5'", "C5", "C8", "N9", "O6", "C2", "N3", "P", "O3'", "C4'", "C6", "N7", "OP2", "C2'", "O5'", "C1'", "C3'", "C4", };
-static double protor_DI_atom_radius[] = {1.46, 1.46, 1.42, 1.64, 1.88, 1.61, 1.76, 1.64, 1.42, 1.76, 1.64, 1.8, 1.46, 1.88, 1.61, 1.64, 1.46, 1.88, 1.46, 1.88, 1.88, 1.61, };
-static int protor_DI_atom_class[] = {1, 1, 1, 1, 0, 0, 0, 1, 1, 0, 1, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 0, };
+static const char *protor_DI_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "N1", "N3", "N7", "N9", "O3'", "O4'", "O5'", "O6", "OP1", "OP2", "OP3", "P", };
+static double protor_DI_atom_radius[] = {1.88, 1.76, 1.88, 1.88, 1.61, 1.88, 1.61, 1.88, 1.61, 1.76, 1.64, 1.64, 1.64, 1.64, 1.46, 1.46, 1.46, 1.42, 1.42, 1.46, 1.46, 1.8, };
+static int protor_DI_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_DI_cfg = {
     .name = "DI", .n_atoms = 22,
     .atom_name = (char**) protor_DI_atom_name,
     .atom_radius = (double*) protor_DI_atom_radius,
     .atom_class = (int*) protor_DI_atom_class };
 
-static const char *protor_DT_atom_name[] = {"OP1", "OP3", "O4'", "C5'", "N1", "C7", "C5", "C2", "O4", "N3", "C4'", "O3'", "P", "C2'", "OP2", "C6", "O2", "C4", "C3'", "O5'", "C1'", };
-static double protor_DT_atom_radius[] = {1.42, 1.46, 1.46, 1.88, 1.64, 1.88, 1.61, 1.61, 1.42, 1.64, 1.88, 1.46, 1.8, 1.88, 1.46, 1.76, 1.42, 1.61, 1.88, 1.46, 1.88, };
-static int protor_DT_atom_class[] = {1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 1, 1, 0, 1, 0, 1, 0, 0, 1, 0, };
+static const char *protor_DT_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C7", "N1", "N3", "O2", "O3'", "O4", "O4'", "O5'", "OP1", "OP2", "OP3", "P", };
+static double protor_DT_atom_radius[] = {1.88, 1.61, 1.88, 1.88, 1.61, 1.88, 1.61, 1.88, 1.76, 1.88, 1.64, 1.64, 1.42, 1.46, 1.42, 1.46, 1.46, 1.42, 1.46, 1.46, 1.8, };
+static int protor_DT_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_DT_cfg = {
     .name = "DT", .n_atoms = 21,
     .atom_name = (char**) protor_DT_atom_name,
     .atom_radius = (double*) protor_DT_atom_radius,
     .atom_class = (int*) protor_DT_atom_class };
 
-static const char *protor_DU_atom_name[] = {"C4'", "O3'", "P", "N3", "O4", "C4", "C3'", "C1'", "O5'", "C2'", "OP2", "C6", "O2", "N1", "C5'", "OP3", "OP1", "O4'", "C2", "C5", };
-static double protor_DU_atom_radius[] = {1.88, 1.46, 1.8, 1.64, 1.42, 1.61, 1.88, 1.88, 1.46, 1.88, 1.46, 1.76, 1.42, 1.64, 1.88, 1.46, 1.42, 1.46, 1.61, 1.76, };
-static int protor_DU_atom_class[] = {0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 0, };
+static const char *protor_DU_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "N1", "N3", "O2", "O3'", "O4", "O4'", "O5'", "OP1", "OP2", "OP3", "P", };
+static double protor_DU_atom_radius[] = {1.88, 1.61, 1.88, 1.88, 1.61, 1.88, 1.76, 1.88, 1.76, 1.64, 1.64, 1.42, 1.46, 1.42, 1.46, 1.46, 1.42, 1.46, 1.46, 1.8, };
+static int protor_DU_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_DU_cfg = {
     .name = "DU", .n_atoms = 20,
     .atom_name = (char**) protor_DU_atom_name,
     .atom_radius = (double*) protor_DU_atom_radius,
     .atom_class = (int*) protor_DU_atom_class };
 
-static const char *protor_G_atom_name[] = {"C6", "N7", "C2'", "OP2", "C3'", "O5'", "C1'", "C4", "N3", "O2'", "O3'", "N2", "P", "C4'", "C5", "N9", "C8", "O6", "C2", "O4'", "OP3", "OP1", "C5'", "N1", };
-static double protor_G_atom_radius[] = {1.61, 1.64, 1.88, 1.46, 1.88, 1.46, 1.88, 1.61, 1.64, 1.46, 1.46, 1.64, 1.8, 1.88, 1.61, 1.64, 1.76, 1.42, 1.61, 1.46, 1.46, 1.42, 1.88, 1.64, };
-static int protor_G_atom_class[] = {0, 1, 0, 1, 0, 1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, };
+static const char *protor_G_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "N1", "N2", "N3", "N7", "N9", "O2'", "O3'", "O4'", "O5'", "O6", "OP1", "OP2", "OP3", "P", };
+static double protor_G_atom_radius[] = {1.88, 1.61, 1.88, 1.88, 1.61, 1.88, 1.61, 1.88, 1.61, 1.76, 1.64, 1.64, 1.64, 1.64, 1.64, 1.46, 1.46, 1.46, 1.46, 1.42, 1.42, 1.46, 1.46, 1.8, };
+static int protor_G_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_G_cfg = {
     .name = "G", .n_atoms = 24,
     .atom_name = (char**) protor_G_atom_name,
     .atom_radius = (double*) protor_G_atom_radius,
     .atom_class = (int*) protor_G_atom_class };
 
-static const char *protor_GLN_atom_name[] = {"N", "OXT", "CB", "CD", "CG", "OE1", "C", "NE2", "CA", "O", };
-static double protor_GLN_atom_radius[] = {1.64, 1.46, 1.88, 1.61, 1.88, 1.42, 1.61, 1.64, 1.88, 1.42, };
-static int protor_GLN_atom_class[] = {1, 1, 0, 0, 0, 1, 0, 1, 0, 1, };
+static const char *protor_GLN_atom_name[] = {"C", "CA", "CB", "CD", "CG", "N", "NE2", "O", "OE1", "OXT", };
+static double protor_GLN_atom_radius[] = {1.61, 1.88, 1.88, 1.61, 1.88, 1.64, 1.64, 1.42, 1.42, 1.46, };
+static int protor_GLN_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_GLN_cfg = {
     .name = "GLN", .n_atoms = 10,
     .atom_name = (char**) protor_GLN_atom_name,
     .atom_radius = (double*) protor_GLN_atom_radius,
     .atom_class = (int*) protor_GLN_atom_class };
 
-static const char *protor_GLU_atom_name[] = {"O", "CA", "OE2", "CB", "OXT", "N", "C", "CD", "OE1", "CG", };
-static double protor_GLU_atom_radius[] = {1.42, 1.88, 1.46, 1.88, 1.46, 1.64, 1.61, 1.61, 1.42, 1.88, };
-static int protor_GLU_atom_class[] = {1, 0, 1, 0, 1, 1, 0, 0, 1, 0, };
+static const char *protor_GLU_atom_name[] = {"C", "CA", "CB", "CD", "CG", "N", "O", "OE1", "OE2", "OXT", };
+static double protor_GLU_atom_radius[] = {1.61, 1.88, 1.88, 1.61, 1.88, 1.64, 1.42, 1.42, 1.46, 1.46, };
+static int protor_GLU_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_GLU_cfg = {
     .name = "GLU", .n_atoms = 10,
     .atom_name = (char**) protor_GLU_atom_name,
     .atom_radius = (double*) protor_GLU_atom_radius,
     .atom_class = (int*) protor_GLU_atom_class };
 
-static const char *protor_GLX_atom_name[] = {"OXT", "N", "CB", "CD", "CG", "XE1", "C", "CA", "O", "XE2", };
-static double protor_GLX_atom_radius[] = {1.46, 1.64, 1.88, 1.61, 1.88, 1.5, 1.61, 1.88, 1.42, 1.5, };
-static int protor_GLX_atom_class[] = {1, 1, 0, 0, 0, 1, 0, 0, 1, 1, };
+static const char *protor_GLX_atom_name[] = {"C", "CA", "CB", "CD", "CG", "N", "O", "OXT", "XE1", "XE2", };
+static double protor_GLX_atom_radius[] = {1.61, 1.88, 1.88, 1.61, 1.88, 1.64, 1.42, 1.46, 1.5, 1.5, };
+static int protor_GLX_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_GLX_cfg = {
     .name = "GLX", .n_atoms = 10,
     .atom_name = (char**) protor_GLX_atom_name,
     .atom_radius = (double*) protor_GLX_atom_radius,
     .atom_class = (int*) protor_GLX_atom_class };
 
-static const char *protor_GLY_atom_name[] = {"C", "O", "N", "OXT", "CA", };
-static double protor_GLY_atom_radius[] = {1.61, 1.42, 1.64, 1.46, 1.88, };
-static int protor_GLY_atom_class[] = {0, 1, 1, 1, 0, };
+static const char *protor_GLY_atom_name[] = {"C", "CA", "N", "O", "OXT", };
+static double protor_GLY_atom_radius[] = {1.61, 1.88, 1.64, 1.42, 1.46, };
+static int protor_GLY_atom_class[] = {0, 0, 1, 1, 1, };
 static struct classifier_residue protor_GLY_cfg = {
     .name = "GLY", .n_atoms = 5,
     .atom_name = (char**) protor_GLY_atom_name,
     .atom_radius = (double*) protor_GLY_atom_radius,
     .atom_class = (int*) protor_GLY_atom_class };
 
-static const char *protor_HIS_atom_name[] = {"CB", "ND1", "OXT", "N", "CD2", "C", "NE2", "CG", "CE1", "O", "CA", };
-static double protor_HIS_atom_radius[] = {1.88, 1.64, 1.46, 1.64, 1.76, 1.61, 1.64, 1.61, 1.76, 1.42, 1.88, };
-static int protor_HIS_atom_class[] = {0, 1, 1, 1, 0, 0, 1, 0, 0, 1, 0, };
+static const char *protor_HIS_atom_name[] = {"C", "CA", "CB", "CD2", "CE1", "CG", "N", "ND1", "NE2", "O", "OXT", };
+static double protor_HIS_atom_radius[] = {1.61, 1.88, 1.88, 1.76, 1.76, 1.61, 1.64, 1.64, 1.64, 1.42, 1.46, };
+static int protor_HIS_atom_class[] = {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_HIS_cfg = {
     .name = "HIS", .n_atoms = 11,
     .atom_name = (char**) protor_HIS_atom_name,
@@ -203,45 +203,45 @@ static struct classifier_residue protor_HOH_cfg = {
     .atom_radius = (double*) protor_HOH_atom_radius,
     .atom_class = (int*) protor_HOH_atom_class };
 
-static const char *protor_I_atom_name[] = {"P", "O3'", "C4'", "N3", "O2'", "O5'", "C1'", "C3'", "C4", "C6", "N7", "OP2", "C2'", "C5'", "N1", "O4'", "OP1", "OP3", "C8", "N9", "C2", "O6", "C5", };
-static double protor_I_atom_radius[] = {1.8, 1.46, 1.88, 1.64, 1.46, 1.46, 1.88, 1.88, 1.61, 1.61, 1.64, 1.46, 1.88, 1.88, 1.64, 1.46, 1.42, 1.46, 1.76, 1.64, 1.76, 1.42, 1.61, };
-static int protor_I_atom_class[] = {1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 1, 1, 1, 1, 0, 1, 0, 1, 0, };
+static const char *protor_I_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C8", "N1", "N3", "N7", "N9", "O2'", "O3'", "O4'", "O5'", "O6", "OP1", "OP2", "OP3", "P", };
+static double protor_I_atom_radius[] = {1.88, 1.76, 1.88, 1.88, 1.61, 1.88, 1.61, 1.88, 1.61, 1.76, 1.64, 1.64, 1.64, 1.64, 1.46, 1.46, 1.46, 1.46, 1.42, 1.42, 1.46, 1.46, 1.8, };
+static int protor_I_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_I_cfg = {
     .name = "I", .n_atoms = 23,
     .atom_name = (char**) protor_I_atom_name,
     .atom_radius = (double*) protor_I_atom_radius,
     .atom_class = (int*) protor_I_atom_class };
 
-static const char *protor_ILE_atom_name[] = {"C", "CD1", "CB", "CG2", "N", "OXT", "CG1", "O", "CA", };
-static double protor_ILE_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.64, 1.46, 1.88, 1.42, 1.88, };
-static int protor_ILE_atom_class[] = {0, 0, 0, 0, 1, 1, 0, 1, 0, };
+static const char *protor_ILE_atom_name[] = {"C", "CA", "CB", "CD1", "CG1", "CG2", "N", "O", "OXT", };
+static double protor_ILE_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.88, 1.88, 1.64, 1.42, 1.46, };
+static int protor_ILE_atom_class[] = {0, 0, 0, 0, 0, 0, 1, 1, 1, };
 static struct classifier_residue protor_ILE_cfg = {
     .name = "ILE", .n_atoms = 9,
     .atom_name = (char**) protor_ILE_atom_name,
     .atom_radius = (double*) protor_ILE_atom_radius,
     .atom_class = (int*) protor_ILE_atom_class };
 
-static const char *protor_LEU_atom_name[] = {"C", "CG", "CD1", "CB", "CD2", "OXT", "N", "O", "CA", };
-static double protor_LEU_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.88, 1.46, 1.64, 1.42, 1.88, };
-static int protor_LEU_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 0, };
+static const char *protor_LEU_atom_name[] = {"C", "CA", "CB", "CD1", "CD2", "CG", "N", "O", "OXT", };
+static double protor_LEU_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.88, 1.88, 1.64, 1.42, 1.46, };
+static int protor_LEU_atom_class[] = {0, 0, 0, 0, 0, 0, 1, 1, 1, };
 static struct classifier_residue protor_LEU_cfg = {
     .name = "LEU", .n_atoms = 9,
     .atom_name = (char**) protor_LEU_atom_name,
     .atom_radius = (double*) protor_LEU_atom_radius,
     .atom_class = (int*) protor_LEU_atom_class };
 
-static const char *protor_LYS_atom_name[] = {"CD", "CG", "C", "OXT", "N", "CE", "CB", "CA", "NZ", "O", };
-static double protor_LYS_atom_radius[] = {1.88, 1.88, 1.61, 1.46, 1.64, 1.88, 1.88, 1.88, 1.64, 1.42, };
-static int protor_LYS_atom_class[] = {0, 0, 0, 1, 1, 0, 0, 0, 1, 1, };
+static const char *protor_LYS_atom_name[] = {"C", "CA", "CB", "CD", "CE", "CG", "N", "NZ", "O", "OXT", };
+static double protor_LYS_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.88, 1.88, 1.64, 1.64, 1.42, 1.46, };
+static int protor_LYS_atom_class[] = {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue protor_LYS_cfg = {
     .name = "LYS", .n_atoms = 10,
     .atom_name = (char**) protor_LYS_atom_name,
     .atom_radius = (double*) protor_LYS_atom_radius,
     .atom_class = (int*) protor_LYS_atom_class };
 
-static const char *protor_MET_atom_name[] = {"O", "SD", "CA", "C", "CG", "CB", "N", "OXT", "CE", };
-static double protor_MET_atom_radius[] = {1.42, 1.77, 1.88, 1.61, 1.88, 1.88, 1.64, 1.46, 1.88, };
-static int protor_MET_atom_class[] = {1, 1, 0, 0, 0, 0, 1, 1, 0, };
+static const char *protor_MET_atom_name[] = {"C", "CA", "CB", "CE", "CG", "N", "O", "OXT", "SD", };
+static double protor_MET_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.88, 1.64, 1.42, 1.46, 1.77, };
+static int protor_MET_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue protor_MET_cfg = {
     .name = "MET", .n_atoms = 9,
     .atom_name = (char**) protor_MET_atom_name,
@@ -257,105 +257,237 @@ static struct classifier_residue protor_NH2_cfg = {
     .atom_radius = (double*) protor_NH2_atom_radius,
     .atom_class = (int*) protor_NH2_atom_class };
 
-static const char *protor_PHE_atom_name[] = {"CA", "CE1", "O", "CZ", "OXT", "N", "CD2", "CB", "CD1", "CE2", "CG", "C", };
-static double protor_PHE_atom_radius[] = {1.88, 1.76, 1.42, 1.76, 1.46, 1.64, 1.76, 1.88, 1.76, 1.76, 1.61, 1.61, };
-static int protor_PHE_atom_class[] = {0, 0, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, };
+static const char *protor_PHE_atom_name[] = {"C", "CA", "CB", "CD1", "CD2", "CE1", "CE2", "CG", "CZ", "N", "O", "OXT", };
+static double protor_PHE_atom_radius[] = {1.61, 1.88, 1.88, 1.76, 1.76, 1.76, 1.76, 1.61, 1.76, 1.64, 1.42, 1.46, };
+static int protor_PHE_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, };
 static struct classifier_residue protor_PHE_cfg = {
     .name = "PHE", .n_atoms = 12,
     .atom_name = (char**) protor_PHE_atom_name,
     .atom_radius = (double*) protor_PHE_atom_radius,
     .atom_class = (int*) protor_PHE_atom_class };
 
-static const char *protor_PRO_atom_name[] = {"CA", "O", "OXT", "N", "CB", "CG", "CD", "C", };
-static double protor_PRO_atom_radius[] = {1.88, 1.42, 1.46, 1.64, 1.88, 1.88, 1.88, 1.61, };
-static int protor_PRO_atom_class[] = {0, 1, 1, 1, 0, 0, 0, 0, };
+static const char *protor_PRO_atom_name[] = {"C", "CA", "CB", "CD", "CG", "N", "O", "OXT", };
+static double protor_PRO_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.88, 1.64, 1.42, 1.46, };
+static int protor_PRO_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, };
 static struct classifier_residue protor_PRO_cfg = {
     .name = "PRO", .n_atoms = 8,
     .atom_name = (char**) protor_PRO_atom_name,
     .atom_radius = (double*) protor_PRO_atom_radius,
     .atom_class = (int*) protor_PRO_atom_class };
 
-static const char *protor_PYL_atom_name[] = {"CA2", "CB", "CE", "CD2", "C2", "C", "NZ", "CB2", "CA", "CG2", "OXT", "N", "O2", "CD", "CE2", "CG", "O", "N2", };
-static double protor_PYL_atom_radius[] = {1.88, 1.88, 1.88, 1.88, 1.61, 1.61, 1.64, 1.88, 1.88, 1.88, 1.46, 1.64, 1.42, 1.88, 1.76, 1.88, 1.42, 1.64, };
-static int protor_PYL_atom_class[] = {0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, };
+static const char *protor_PYL_atom_name[] = {"C", "C2", "CA", "CA2", "CB", "CB2", "CD", "CD2", "CE", "CE2", "CG", "CG2", "N", "N2", "NZ", "O", "O2", "OXT", };
+static double protor_PYL_atom_radius[] = {1.61, 1.61, 1.88, 1.88, 1.88, 1.88, 1.88, 1.88, 1.88, 1.76, 1.88, 1.88, 1.64, 1.64, 1.64, 1.42, 1.42, 1.46, };
+static int protor_PYL_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_PYL_cfg = {
     .name = "PYL", .n_atoms = 18,
     .atom_name = (char**) protor_PYL_atom_name,
     .atom_radius = (double*) protor_PYL_atom_radius,
     .atom_class = (int*) protor_PYL_atom_class };
 
-static const char *protor_SEC_atom_name[] = {"C", "CB", "O", "OXT", "SE", "N", "CA", };
-static double protor_SEC_atom_radius[] = {1.61, 1.88, 1.42, 1.46, 1.9, 1.64, 1.88, };
-static int protor_SEC_atom_class[] = {0, 0, 1, 1, 1, 1, 0, };
+static const char *protor_SEC_atom_name[] = {"C", "CA", "CB", "N", "O", "OXT", "SE", };
+static double protor_SEC_atom_radius[] = {1.61, 1.88, 1.88, 1.64, 1.42, 1.46, 1.9, };
+static int protor_SEC_atom_class[] = {0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue protor_SEC_cfg = {
     .name = "SEC", .n_atoms = 7,
     .atom_name = (char**) protor_SEC_atom_name,
     .atom_radius = (double*) protor_SEC_atom_radius,
     .atom_class = (int*) protor_SEC_atom_class };
 
-static const char *protor_SER_atom_name[] = {"CA", "OXT", "N", "CB", "O", "OG", "C", };
-static double protor_SER_atom_radius[] = {1.88, 1.46, 1.64, 1.88, 1.42, 1.46, 1.61, };
-static int protor_SER_atom_class[] = {0, 1, 1, 0, 1, 1, 0, };
+static const char *protor_SER_atom_name[] = {"C", "CA", "CB", "N", "O", "OG", "OXT", };
+static double protor_SER_atom_radius[] = {1.61, 1.88, 1.88, 1.64, 1.42, 1.46, 1.46, };
+static int protor_SER_atom_class[] = {0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue protor_SER_cfg = {
     .name = "SER", .n_atoms = 7,
     .atom_name = (char**) protor_SER_atom_name,
     .atom_radius = (double*) protor_SER_atom_radius,
     .atom_class = (int*) protor_SER_atom_class };
 
-static const char *protor_T_atom_name[] = {"C1'", "O5'", "C3'", "C4", "O2", "C6", "OP2", "C2'", "P", "O3'", "C4'", "O4", "N3", "C2", "C7", "C5", "C5'", "N1", "O4'", "OP1", "OP3", };
-static double protor_T_atom_radius[] = {1.88, 1.46, 1.88, 1.61, 1.42, 1.76, 1.46, 1.88, 1.8, 1.46, 1.88, 1.42, 1.64, 1.61, 1.88, 1.61, 1.88, 1.64, 1.46, 1.42, 1.46, };
-static int protor_T_atom_class[] = {0, 1, 0, 0, 1, 0, 1, 0, 1, 1, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, };
+static const char *protor_T_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "C7", "N1", "N3", "O2", "O3'", "O4", "O4'", "O5'", "OP1", "OP2", "OP3", "P", };
+static double protor_T_atom_radius[] = {1.88, 1.61, 1.88, 1.88, 1.61, 1.88, 1.61, 1.88, 1.76, 1.88, 1.64, 1.64, 1.42, 1.46, 1.42, 1.46, 1.46, 1.42, 1.46, 1.46, 1.8, };
+static int protor_T_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_T_cfg = {
     .name = "T", .n_atoms = 21,
     .atom_name = (char**) protor_T_atom_name,
     .atom_radius = (double*) protor_T_atom_radius,
     .atom_class = (int*) protor_T_atom_class };
 
-static const char *protor_THR_atom_name[] = {"OG1", "O", "CA", "C", "CB", "CG2", "N", "OXT", };
-static double protor_THR_atom_radius[] = {1.46, 1.42, 1.88, 1.61, 1.88, 1.88, 1.64, 1.46, };
-static int protor_THR_atom_class[] = {1, 1, 0, 0, 0, 0, 1, 1, };
+static const char *protor_THR_atom_name[] = {"C", "CA", "CB", "CG2", "N", "O", "OG1", "OXT", };
+static double protor_THR_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.64, 1.42, 1.46, 1.46, };
+static int protor_THR_atom_class[] = {0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue protor_THR_cfg = {
     .name = "THR", .n_atoms = 8,
     .atom_name = (char**) protor_THR_atom_name,
     .atom_radius = (double*) protor_THR_atom_radius,
     .atom_class = (int*) protor_THR_atom_class };
 
-static const char *protor_TRP_atom_name[] = {"CZ3", "NE1", "CH2", "CA", "O", "CE2", "CE3", "CG", "CD1", "C", "CZ2", "N", "OXT", "CD2", "CB", };
-static double protor_TRP_atom_radius[] = {1.76, 1.64, 1.76, 1.88, 1.42, 1.61, 1.76, 1.61, 1.76, 1.61, 1.76, 1.64, 1.46, 1.61, 1.88, };
-static int protor_TRP_atom_class[] = {0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, };
+static const char *protor_TRP_atom_name[] = {"C", "CA", "CB", "CD1", "CD2", "CE2", "CE3", "CG", "CH2", "CZ2", "CZ3", "N", "NE1", "O", "OXT", };
+static double protor_TRP_atom_radius[] = {1.61, 1.88, 1.88, 1.76, 1.61, 1.61, 1.76, 1.61, 1.76, 1.76, 1.76, 1.64, 1.64, 1.42, 1.46, };
+static int protor_TRP_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue protor_TRP_cfg = {
     .name = "TRP", .n_atoms = 15,
     .atom_name = (char**) protor_TRP_atom_name,
     .atom_radius = (double*) protor_TRP_atom_radius,
     .atom_class = (int*) protor_TRP_atom_class };
 
-static const char *protor_TYR_atom_name[] = {"OH", "OXT", "CD2", "CZ", "N", "CB", "CD1", "CE2", "CG", "C", "CA", "CE1", "O", };
-static double protor_TYR_atom_radius[] = {1.46, 1.46, 1.76, 1.61, 1.64, 1.88, 1.76, 1.76, 1.61, 1.61, 1.88, 1.76, 1.42, };
-static int protor_TYR_atom_class[] = {1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, };
+static const char *protor_TYR_atom_name[] = {"C", "CA", "CB", "CD1", "CD2", "CE1", "CE2", "CG", "CZ", "N", "O", "OH", "OXT", };
+static double protor_TYR_atom_radius[] = {1.61, 1.88, 1.88, 1.76, 1.76, 1.76, 1.76, 1.61, 1.61, 1.64, 1.42, 1.46, 1.46, };
+static int protor_TYR_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, };
 static struct classifier_residue protor_TYR_cfg = {
     .name = "TYR", .n_atoms = 13,
     .atom_name = (char**) protor_TYR_atom_name,
     .atom_radius = (double*) protor_TYR_atom_radius,
     .atom_class = (int*) protor_TYR_atom_class };
 
-static const char *protor_U_atom_name[] = {"C2", "C5", "N1", "C5'", "OP3", "OP1", "O4'", "C4", "C1'", "O5'", "C3'", "OP2", "C2'", "O2", "C6", "C4'", "P", "O3'", "O2'", "O4", "N3", };
-static double protor_U_atom_radius[] = {1.61, 1.76, 1.64, 1.88, 1.46, 1.42, 1.46, 1.61, 1.88, 1.46, 1.88, 1.46, 1.88, 1.42, 1.76, 1.88, 1.8, 1.46, 1.46, 1.42, 1.64, };
-static int protor_U_atom_class[] = {0, 0, 1, 0, 1, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 1, 1, 1, 1, };
+static const char *protor_U_atom_name[] = {"C1'", "C2", "C2'", "C3'", "C4", "C4'", "C5", "C5'", "C6", "N1", "N3", "O2", "O2'", "O3'", "O4", "O4'", "O5'", "OP1", "OP2", "OP3", "P", };
+static double protor_U_atom_radius[] = {1.88, 1.61, 1.88, 1.88, 1.61, 1.88, 1.76, 1.88, 1.76, 1.64, 1.64, 1.42, 1.46, 1.46, 1.42, 1.46, 1.46, 1.42, 1.46, 1.46, 1.8, };
+static int protor_U_atom_class[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, };
 static struct classifier_residue protor_U_cfg = {
     .name = "U", .n_atoms = 21,
     .atom_name = (char**) protor_U_atom_name,
     .atom_radius = (double*) protor_U_atom_radius,
     .atom_class = (int*) protor_U_atom_class };
 
-static const char *protor_VAL_atom_name[] = {"CG1", "O", "CA", "C", "CG2", "CB", "OXT", "N", };
-static double protor_VAL_atom_radius[] = {1.88, 1.42, 1.88, 1.61, 1.88, 1.88, 1.46, 1.64, };
-static int protor_VAL_atom_class[] = {0, 1, 0, 0, 0, 0, 1, 1, };
+static const char *protor_VAL_atom_name[] = {"C", "CA", "CB", "CG1", "CG2", "N", "O", "OXT", };
+static double protor_VAL_atom_radius[] = {1.61, 1.88, 1.88, 1.88, 1.88, 1.64, 1.42, 1.46, };
+static int protor_VAL_atom_class[] = {0, 0, 0, 0, 0, 1, 1, 1, };
 static struct classifier_residue protor_VAL_cfg = {
     .name = "VAL", .n_atoms = 8,
     .atom_name = (char**) protor_VAL_atom_name,
     .atom_radius = (double*) protor_VAL_atom_radius,
     .atom_class = (int*) protor_VAL_atom_class };
 
+/* Hash table for looking up atoms, at most 12 probes per atom */
+static struct classifier_entry protor_table[] = {
+    {-1, -1}, {-1, -1}, {22, 14}, {-1, -1}, {12, 18}, {9, 3}, {7, 19}, {15, 23},
+    {23, 5}, {16, 0}, {-1, -1}, {-1, -1}, {33, 18}, {22, 13}, {38, 5}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {12, 1}, {37, 14}, {-1, -1}, {36, 7}, {30, 4},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {11, 12},
+    {-1, -1}, {-1, -1}, {31, 1}, {-1, -1}, {17, 3}, {35, 13}, {20, 7}, {30, 17},
+    {23, 2}, {10, 9}, {32, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {6, 5}, {25, 5},
+    {-1, -1}, {22, 17}, {-1, -1}, {22, 20}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {11, 6}, {6, 1}, {30, 10}, {-1, -1}, {-1, -1}, {-1, -1}, {14, 18}, {-1, -1},
+    {13, 16}, {-1, -1}, {-1, -1}, {-1, -1}, {26, 6}, {-1, -1}, {-1, -1}, {22, 11},
+    {0, 6}, {19, 3}, {29, 3}, {-1, -1}, {8, 3}, {-1, -1}, {33, 16}, {-1, -1},
+    {25, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {35, 9}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {0, 0}, {16, 9}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {0, 13}, {15, 2}, {36, 5}, {22, 2}, {38, 4},
+    {29, 1}, {9, 9}, {22, 8}, {-1, -1}, {-1, -1}, {20, 1}, {0, 2}, {-1, -1},
+    {-1, -1}, {28, 8}, {-1, -1}, {7, 8}, {9, 18}, {38, 1}, {-1, -1}, {-1, -1},
+    {30, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {37, 4},
+    {33, 8}, {33, 2}, {-1, -1}, {10, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {34, 4},
+    {-1, -1}, {5, 4}, {9, 6}, {-1, -1}, {-1, -1}, {36, 8}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {4, 3}, {33, 0}, {35, 3},
+    {10, 5}, {15, 16}, {-1, -1}, {15, 19}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {13, 0}, {-1, -1}, {-1, -1}, {3, 9}, {33, 5}, {12, 11}, {35, 12}, {10, 17},
+    {-1, -1}, {-1, -1}, {5, 0}, {9, 1}, {14, 5}, {9, 11}, {32, 3}, {11, 9},
+    {-1, -1}, {-1, -1}, {-1, -1}, {14, 8}, {0, 22}, {12, 19}, {2, 5}, {4, 2},
+    {33, 3}, {-1, -1}, {-1, -1}, {15, 18}, {-1, -1}, {33, 17}, {-1, -1}, {0, 9},
+    {7, 0}, {10, 4}, {-1, -1}, {37, 10}, {-1, -1}, {-1, -1}, {-1, -1}, {18, 0},
+    {11, 21}, {28, 4}, {-1, -1}, {36, 11}, {22, 22}, {-1, -1}, {9, 12}, {18, 7},
+    {3, 5}, {12, 14}, {15, 15}, {35, 14}, {-1, -1}, {-1, -1}, {3, 10}, {20, 8},
+    {7, 17}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {17, 4}, {8, 1}, {12, 7},
+    {13, 8}, {7, 3}, {10, 11}, {16, 8}, {23, 1}, {24, 7}, {33, 13}, {9, 7},
+    {12, 13}, {34, 7}, {37, 13}, {-1, -1}, {2, 2}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {11, 8}, {30, 6}, {8, 5}, {4, 6}, {9, 2}, {-1, -1}, {-1, -1},
+    {-1, -1}, {15, 9}, {37, 17}, {-1, -1}, {22, 5}, {-1, -1}, {17, 2}, {-1, -1},
+    {-1, -1}, {0, 8}, {25, 0}, {10, 10}, {11, 22}, {26, 4}, {-1, -1}, {-1, -1},
+    {-1, -1}, {25, 1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {22, 0}, {0, 15}, {22, 15}, {28, 0}, {37, 0}, {-1, -1}, {-1, -1},
+    {14, 16}, {-1, -1}, {15, 6}, {-1, -1}, {19, 4}, {38, 3}, {9, 5}, {-1, -1},
+    {1, 1}, {29, 2}, {-1, -1}, {34, 1}, {-1, -1}, {35, 7}, {26, 2}, {19, 1},
+    {6, 7}, {22, 16}, {23, 6}, {0, 20}, {31, 0}, {9, 19}, {33, 12}, {16, 3},
+    {31, 5}, {37, 2}, {38, 2}, {36, 4}, {30, 9}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {33, 6}, {-1, -1}, {15, 1}, {18, 8}, {0, 14}, {15, 12}, {29, 6},
+    {30, 16}, {34, 0}, {-1, -1}, {22, 4}, {-1, -1}, {-1, -1}, {24, 4}, {3, 4},
+    {35, 2}, {0, 18}, {23, 0}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {16, 1}, {-1, -1}, {6, 6}, {16, 5}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {11, 17}, {37, 1}, {15, 0}, {26, 8}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {35, 5},
+    {3, 2}, {9, 15}, {14, 19}, {-1, -1}, {-1, -1}, {-1, -1}, {13, 18}, {-1, -1},
+    {-1, -1}, {-1, -1}, {20, 9}, {-1, -1}, {-1, -1}, {12, 3}, {34, 3}, {28, 5},
+    {37, 16}, {38, 7}, {-1, -1}, {11, 15}, {-1, -1}, {-1, -1}, {-1, -1}, {12, 10},
+    {14, 0}, {18, 5}, {28, 1}, {-1, -1}, {-1, -1}, {7, 14}, {12, 4}, {9, 10},
+    {11, 3}, {37, 11}, {-1, -1}, {9, 17}, {-1, -1}, {1, 2}, {-1, -1}, {-1, -1},
+    {11, 16}, {7, 18}, {23, 4}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {33, 19},
+    {-1, -1}, {10, 1}, {38, 6}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {10, 13},
+    {-1, -1}, {14, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {2, 1}, {-1, -1}, {5, 3},
+    {-1, -1}, {-1, -1}, {2, 4}, {30, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {7, 16},
+    {-1, -1}, {-1, -1}, {-1, -1}, {12, 16}, {-1, -1}, {-1, -1}, {-1, -1}, {35, 11},
+    {13, 4}, {-1, -1}, {-1, -1}, {-1, -1}, {17, 6}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {6, 4}, {25, 3}, {-1, -1}, {-1, -1}, {10, 12}, {22, 19}, {31, 6},
+    {5, 2}, {-1, -1}, {-1, -1}, {11, 4}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {14, 17}, {-1, -1}, {11, 13}, {37, 19}, {0, 10}, {10, 0}, {26, 5},
+    {-1, -1}, {7, 10}, {29, 4}, {0, 4}, {19, 2}, {-1, -1}, {-1, -1}, {8, 4},
+    {24, 1}, {6, 8}, {26, 3}, {31, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {35, 10},
+    {34, 6}, {28, 11}, {10, 2}, {17, 8}, {33, 11}, {-1, -1}, {36, 9}, {18, 2},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {18, 9}, {36, 6}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {22, 12}, {32, 0}, {-1, -1}, {35, 8}, {-1, -1},
+    {-1, -1}, {-1, -1}, {25, 9}, {7, 12}, {24, 8}, {-1, -1}, {7, 6}, {13, 2},
+    {30, 12}, {16, 2}, {23, 8}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {18, 4}, {-1, -1}, {-1, -1}, {33, 9}, {-1, -1}, {-1, -1}, {-1, -1}, {15, 10},
+    {-1, -1}, {14, 10}, {-1, -1}, {-1, -1}, {-1, -1}, {9, 4}, {11, 7}, {9, 14},
+    {25, 8}, {3, 1}, {37, 7}, {-1, -1}, {13, 14}, {20, 3}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {15, 22}, {35, 4}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {10, 15}, {3, 8}, {-1, -1},
+    {17, 9}, {28, 2}, {10, 16}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {0, 17}, {-1, -1}, {-1, -1}, {14, 11}, {-1, -1}, {14, 12}, {14, 6}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {11, 18}, {13, 10}, {-1, -1},
+    {-1, -1}, {25, 7}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {10, 19}, {12, 12}, {28, 3}, {11, 20}, {-1, -1}, {-1, -1}, {-1, -1}, {12, 8},
+    {-1, -1}, {9, 13}, {23, 3}, {28, 9}, {-1, -1}, {16, 6}, {36, 0}, {-1, -1},
+    {-1, -1}, {3, 6}, {5, 8}, {-1, -1}, {12, 2}, {37, 15}, {-1, -1}, {14, 15},
+    {35, 0}, {13, 9}, {-1, -1}, {24, 6}, {-1, -1}, {-1, -1}, {30, 14}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {30, 0},
+    {-1, -1}, {5, 1}, {29, 7}, {7, 7}, {12, 17}, {-1, -1}, {-1, -1}, {4, 4},
+    {-1, -1}, {-1, -1}, {3, 0}, {-1, -1}, {11, 11}, {-1, -1}, {20, 0}, {20, 10},
+    {26, 0}, {31, 2}, {-1, -1}, {-1, -1}, {24, 0}, {-1, -1}, {12, 5}, {32, 1},
+    {7, 2}, {37, 12}, {33, 14}, {-1, -1}, {-1, -1}, {13, 5}, {-1, -1}, {-1, -1},
+    {22, 21}, {12, 9}, {-1, -1}, {12, 0}, {-1, -1}, {27, 0}, {7, 15}, {-1, -1},
+    {-1, -1}, {-1, -1}, {7, 20}, {9, 0}, {5, 7}, {11, 14}, {15, 3}, {0, 11},
+    {15, 4}, {15, 14}, {-1, -1}, {7, 9}, {-1, -1}, {22, 1}, {34, 2}, {-1, -1},
+    {-1, -1}, {24, 5}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {0, 19}, {7, 1},
+    {-1, -1}, {-1, -1}, {16, 4}, {-1, -1}, {33, 10}, {-1, -1}, {36, 3}, {-1, -1},
+    {-1, -1}, {18, 3}, {-1, -1}, {-1, -1}, {33, 1}, {-1, -1}, {-1, -1}, {30, 5},
+    {0, 12}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {15, 7},
+    {17, 0}, {-1, -1}, {3, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {4, 8}, {10, 7}, {-1, -1}, {-1, -1}, {-1, -1}, {16, 7}, {-1, -1}, {30, 1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {0, 16}, {32, 6}, {36, 12}, {37, 6}, {-1, -1},
+    {-1, -1}, {15, 13}, {28, 7}, {14, 9}, {34, 5}, {13, 20}, {5, 5}, {9, 8},
+    {22, 9}, {-1, -1}, {-1, -1}, {8, 0}, {20, 5}, {-1, -1}, {13, 12}, {14, 1},
+    {-1, -1}, {13, 19}, {-1, -1}, {-1, -1}, {15, 20}, {20, 6}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {28, 6}, {-1, -1}, {-1, -1}, {-1, -1}, {9, 21}, {-1, -1},
+    {-1, -1}, {-1, -1}, {6, 0}, {13, 13}, {10, 18}, {11, 5}, {18, 6}, {-1, -1},
+    {32, 4}, {-1, -1}, {12, 15}, {-1, -1}, {-1, -1}, {32, 5}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {12, 20}, {4, 1}, {-1, -1}, {-1, -1}, {12, 21}, {-1, -1},
+    {13, 11}, {11, 0}, {13, 1}, {-1, -1}, {10, 6}, {10, 14}, {19, 0}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {7, 13}, {2, 3}, {11, 1}, {11, 2},
+    {4, 0}, {36, 1}, {-1, -1}, {14, 7}, {-1, -1}, {11, 10}, {22, 7}, {-1, -1},
+    {-1, -1}, {13, 15}, {3, 11}, {8, 2}, {13, 6}, {0, 1}, {0, 7}, {17, 5},
+    {38, 0}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {22, 18}, {25, 4}, {33, 15},
+    {14, 2}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {30, 8}, {6, 3},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {5, 6}, {14, 14}, {37, 18},
+    {-1, -1}, {-1, -1}, {-1, -1}, {17, 1}, {7, 11}, {22, 10}, {30, 11}, {22, 3},
+    {-1, -1}, {-1, -1}, {24, 2}, {31, 4}, {-1, -1}, {-1, -1}, {-1, -1}, {0, 3},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {17, 7}, {30, 13},
+    {6, 2}, {36, 10}, {18, 1}, {-1, -1}, {0, 5}, {-1, -1}, {-1, -1}, {15, 8},
+    {-1, -1}, {29, 0}, {30, 7}, {33, 7}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {4, 5}, {-1, -1}, {26, 1}, {13, 7}, {-1, -1}, {23, 7}, {-1, -1},
+    {0, 21}, {7, 4}, {9, 20}, {30, 15}, {37, 20}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {15, 17}, {33, 20}, {-1, -1}, {37, 8}, {33, 4}, {-1, -1},
+    {-1, -1}, {-1, -1}, {15, 11}, {29, 5}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {22, 6}, {25, 6}, {9, 16}, {24, 3}, {20, 2}, {14, 13}, {35, 1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {15, 21}, {13, 3}, {-1, -1},
+    {20, 4}, {-1, -1}, {-1, -1}, {37, 3}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {15, 5}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {4, 7}, {3, 7}, {21, 0}, {35, 6}, {-1, -1},
+    {37, 5}, {1, 0}, {14, 4}, {13, 17}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+    {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {10, 8}, {-1, -1}, {-1, -1},
+    {-1, -1}, {37, 9}, {7, 5}, {-1, -1}, {-1, -1}, {-1, -1}, {11, 19}, {-1, -1},
+    {26, 7}, {-1, -1}, {12, 6}, {-1, -1}, {8, 6}, {28, 10}, {2, 0}, {36, 2},
+};
+
 static struct classifier_residue *protor_residue_cfg[] = {
     &protor_A_cfg, &protor_ACE_cfg, &protor_ALA_cfg, &protor_ARG_cfg, &protor_ASN_cfg, &protor_ASP_cfg, &protor_ASX_cfg, &protor_C_cfg, &protor_CYS_cfg, &protor_DA_cfg, &protor_DC_cfg, &protor_DG_cfg, &protor_DI_cfg, &protor_DT_cfg, &protor_DU_cfg, &protor_G_cfg, &protor_GLN_cfg, &protor_GLU_cfg, &protor_GLX_cfg, &protor_GLY_cfg, &protor_HIS_cfg, &protor_HOH_cfg, &protor_I_cfg, &protor_ILE_cfg, &protor_LEU_cfg, &protor_LYS_cfg, &protor_MET_cfg, &protor_NH2_cfg, &protor_PHE_cfg, &protor_PRO_cfg, &protor_PYL_cfg, &protor_SEC_cfg, &protor_SER_cfg, &protor_T_cfg, &protor_THR_cfg, &protor_TRP_cfg, &protor_TYR_cfg, &protor_U_cfg, &protor_VAL_cfg, };
 
@@ -363,7 +495,9 @@ static struct classifier_config protor_auto_config = {
     .n_residues = 39, .n_classes = 3,
     .residue_name = (char**) protor_residue_name,
     .class_name = (char**) protor_class_name,
-    .residue = (struct classifier_residue **) protor_residue_cfg
+    .residue = (struct classifier_residue **) protor_residue_cfg,
+    .table_size = 1024,
+    .table = protor_table
 };
 
 static void protor_dummy_free(void *arg) {}
@@ -10,6 +10,9 @@ struct coord_t {
     /** number of 3-vectors */
     int n; 
 
+    /** number of 3-vectors there is room for in xyz */
+    int capacity;
+
     /** If these coordinates are only a link to an externally stored
         array this is 1, else 0. If it it is set, the coordinates can
         not be changed and the array not freed. */
@@ -27,6 +30,7 @@ freesasa_coord_new()
     if (c != NULL) {
         c->xyz = NULL;
         c->n = 0;
+        c->capacity = 0;
         c->is_linked = 0;
     } else {
         mem_fail();
@@ -52,6 +56,7 @@ coord_clear(coord_t *c)
         c->xyz = NULL;
     }
     c->n = 0;
+    c->capacity = 0;
 }
 
 coord_t *
@@ -79,6 +84,23 @@ freesasa_coord_new_linked(const double *xyz,
     return c;
 }
 
+int
+freesasa_coord_reserve(coord_t *c,
+                       int n)
+{
+    assert(c); assert(!c->is_linked);
+    double *xyz;
+
+    if (n <= c->capacity) return FREESASA_SUCCESS;
+
+    xyz = (double*) realloc(c->xyz, sizeof(double)*3*n);
+    if (xyz == NULL) return mem_fail();
+    c->xyz = xyz;
+    c->capacity = n;
+
+    return FREESASA_SUCCESS;
+}
+
 int
 freesasa_coord_append(coord_t *c,
                       const double *xyz,
@@ -87,15 +109,13 @@ freesasa_coord_append(coord_t *c,
     assert(c); assert(xyz); assert(!c->is_linked);
 
     int n_old = c->n;
-    double *xyz_old = c->xyz;
 
     if (n == 0) return FREESASA_SUCCESS;
 
-    c->xyz = (double*) realloc(c->xyz, sizeof(double)*3*(c->n+n));
-    if (c->xyz == NULL) {
-        free(xyz_old);
+    // grow geometrically, so that appending one at a time is linear
+    if (c->n + n > c->capacity &&
+        freesasa_coord_reserve(c, c->n + n > 2*c->capacity ? c->n + n : 2*c->capacity))
         return mem_fail();
-    }
     c->n += n;
 
     memcpy(&(c->xyz[3*n_old]), xyz, sizeof(double)*n*3);
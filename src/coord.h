@@ -83,6 +83,22 @@ coord_t *
 freesasa_coord_new_linked(const double *xyz,
                           int n);
 
+/**
+    Makes room for at least `n` coordinates in a ::coord_t object,
+    without changing its size.
+
+    Appending coordinates makes room for more coordinates by itself,
+    this only saves reallocations when the final size is known.
+
+    @param coord A ::coord_t object
+    @param n Number of coordinates.
+    @return FREESASA_SUCCESS if successful, FREESASA_FAIL if out of
+      memory (the object is left unchanged).
+ */
+int
+freesasa_coord_reserve(coord_t *coord,
+                       int n);
+
 /**
     Append coordinates to ::coord_t object from one array.
 
@@ -19,6 +19,8 @@
 #include "freesasa_internal.h"
 #include "pdb.h"
 #include "classifier.h"
+#include "nb.h"
+#include "thread.h"
 
 #ifdef PACKAGE_VERSION
 const char *freesasa_version = PACKAGE_VERSION;
@@ -45,9 +47,14 @@ const freesasa_parameters freesasa_default_parameters = {
     .shrake_rupley_n_points = FREESASA_DEF_SR_N,
     .lee_richards_n_slices = FREESASA_DEF_LR_N,
     .n_threads = DEF_NUMBER_THREADS,
+    .lee_richards_approx = 0,
+    .reorder_atoms = 0,
+    .thread_chunk_size = FREESASA_DEF_THREAD_CHUNK,
+    .thread_pool = NULL,
 };
 
-const char *freesasa_alg_names[] = {"Lee & Richards", "Shrake & Rupley"};
+const char *freesasa_alg_names[] = {"Lee & Richards", "Shrake & Rupley",
+                                    "Shrake & Rupley (lookup table)"};
 
 freesasa_strvp*
 freesasa_strvp_new(int n);
@@ -62,6 +69,7 @@ freesasa_result_classify(const freesasa_result *result,
 
     int n_atoms;
     int n_classes;
+    int *atom_class;
     freesasa_strvp *strvp;
 
     if (classifier == NULL) {
@@ -83,13 +91,19 @@ freesasa_result_classify(const freesasa_result *result,
     if (strvp->string[n_classes] == NULL) {mem_fail(); return NULL;}
     strvp->value[n_classes] = 0;
 
+    atom_class = malloc(sizeof(int)*(n_atoms > 0 ? n_atoms : 1));
+    if (atom_class == NULL) {
+        freesasa_strvp_free(strvp);
+        mem_fail();
+        return NULL;
+    }
+    freesasa_structure_atom_classes(structure, classifier, atom_class);
     for (int i = 0; i < n_atoms; ++i) {
-        const char *res_name = freesasa_structure_atom_res_name(structure,i);
-        const char *atom_name = freesasa_structure_atom_name(structure,i);
-        int c = classifier->sasa_class(res_name,atom_name,classifier);
+        int c = atom_class[i];
         if (c == FREESASA_WARN) c = n_classes; // unknown
         strvp->value[c] += result->sasa[i];
     }
+    free(atom_class);
 
     return strvp;
 }
@@ -103,6 +117,88 @@ freesasa_result_free(freesasa_result *r)
     }
 }
 
+//! Calls the algorithm selected in the parameters
+static int
+calc_alg(double *sasa,
+         const coord_t *c,
+         const double *radii,
+         const freesasa_parameters *parameters)
+{
+    const freesasa_parameters *p = parameters;
+    if (p == NULL) p = &freesasa_default_parameters;
+
+    switch(p->alg) {
+    case FREESASA_SHRAKE_RUPLEY:
+        return freesasa_shrake_rupley(sasa, c, radii, parameters);
+    case FREESASA_SHRAKE_RUPLEY_LUT:
+        return freesasa_shrake_rupley_lut(sasa, c, radii, parameters);
+    case FREESASA_LEE_RICHARDS:
+        return freesasa_lee_richards(sasa, c, radii, parameters);
+    default:
+        assert(0); //should never get here
+        break;
+    }
+    return FREESASA_FAIL;
+}
+
+/**
+    Calculates SASA with the atoms sorted along a space-filling curve
+    (see freesasa_nb_spatial_order()), so that neighbors are mostly
+    close to each other also in memory. The results are written to
+    sasa in the original order.
+ */
+static int
+calc_reordered(double *sasa,
+               const coord_t *c,
+               const double *radii,
+               const freesasa_parameters *p)
+{
+    const int n = freesasa_coord_n(c);
+    const double *v = freesasa_coord_all(c);
+    int *order = malloc(sizeof(int)*n);
+    double *xyz = malloc(sizeof(double)*3*n);
+    double *r = malloc(sizeof(double)*n);
+    double *s = malloc(sizeof(double)*n);
+    double r_max = 0;
+    coord_t *c2 = NULL;
+    int ret = FREESASA_FAIL;
+
+    if (!order || !xyz || !r || !s) {
+        mem_fail();
+        goto cleanup;
+    }
+
+    for (int i = 0; i < n; ++i) r_max = fmax(r_max, radii[i]);
+    if (freesasa_nb_spatial_order(c, 2*(r_max + p->probe_radius), order))
+        goto cleanup;
+
+    for (int k = 0; k < n; ++k) {
+        const int i = order[k];
+        xyz[3*k]   = v[3*i];
+        xyz[3*k+1] = v[3*i+1];
+        xyz[3*k+2] = v[3*i+2];
+        r[k] = radii[i];
+    }
+    c2 = freesasa_coord_new_linked(xyz, n);
+    if (c2 == NULL) {
+        mem_fail();
+        goto cleanup;
+    }
+
+    ret = calc_alg(s, c2, r, p);
+    if (ret != FREESASA_FAIL) {
+        for (int k = 0; k < n; ++k) sasa[order[k]] = s[k];
+    }
+
+ cleanup:
+    freesasa_coord_free(c2);
+    free(order);
+    free(xyz);
+    free(r);
+    free(s);
+    return ret;
+}
+
 static freesasa_result*
 freesasa_calc(const coord_t *c, 
               const double *radii,
@@ -123,17 +219,10 @@ freesasa_calc(const coord_t *c,
     result->sasa = malloc(sizeof(double)*result->n_atoms);
     if(result->sasa == NULL) { mem_fail(); freesasa_result_free(result); return NULL; }
 
-    switch(p->alg) {
-    case FREESASA_SHRAKE_RUPLEY:
-      ret = freesasa_shrake_rupley(result->sasa, c, radii, parameters);
-        break;
-    case FREESASA_LEE_RICHARDS:
-        ret = freesasa_lee_richards(result->sasa, c, radii, parameters);
-        break;
-    default:
-        assert(0); //should never get here
-        break;
-    }
+    if (p->reorder_atoms && result->n_atoms > 1)
+        ret = calc_reordered(result->sasa, c, radii, p);
+    else
+        ret = calc_alg(result->sasa, c, radii, parameters);
     if (ret == FREESASA_FAIL) {
         freesasa_result_free(result);
         return NULL;
@@ -163,8 +252,7 @@ freesasa_calc_coord(const double *xyz,
     coord = freesasa_coord_new_linked(xyz,n);
     if (coord != NULL) result = freesasa_calc(coord,radii,parameters);
     if (coord == NULL || result == NULL) {
-       freesasa_result_free(result);
-        freesasa_coord_free(coord);
+        freesasa_result_free(result);
         mem_fail();
         result = NULL;
     }
@@ -183,6 +271,78 @@ freesasa_calc_structure(const freesasa_structure* structure,
                          freesasa_structure_radius(structure),
                          parameters);
 }
+
+freesasa_result *
+freesasa_calc_verlet(const coord_t *c,
+                     const double *radii,
+                     nb_verlet *verlet,
+                     const freesasa_parameters *parameters)
+{
+    assert(c);
+    assert(radii);
+    assert(verlet);
+
+    const freesasa_parameters *p = parameters;
+    const int n = freesasa_coord_n(c);
+    int n_threads, ret;
+    double *r = NULL;
+    const nb_list *nb;
+    freesasa_result *result = NULL;
+
+    if (p == NULL) p = &freesasa_default_parameters;
+    if (n == 0) {
+        freesasa_fail("in %s(): empty coordinates", __func__);
+        return NULL;
+    }
+
+    n_threads = p->thread_pool ? freesasa_thread_pool_size(p->thread_pool) : p->n_threads;
+#if !USE_THREADS
+    n_threads = 1;
+#endif
+    if (n_threads < 1) n_threads = 1;
+
+    result = malloc(sizeof(freesasa_result));
+    r = malloc(sizeof(double)*n);
+    if (result) result->sasa = malloc(sizeof(double)*n);
+    if (!result || !r || !result->sasa) {
+        mem_fail();
+        goto fail;
+    }
+    result->n_atoms = n;
+
+    // the list and the algorithms both use the radii including the probe
+    for (int i = 0; i < n; ++i) r[i] = radii[i] + p->probe_radius;
+    nb = freesasa_nb_verlet_update(verlet, c, r, p->thread_pool, n_threads);
+    if (nb == NULL) goto fail;
+
+    switch (p->alg) {
+    case FREESASA_SHRAKE_RUPLEY:
+    case FREESASA_SHRAKE_RUPLEY_LUT:
+        ret = freesasa_shrake_rupley_subset(result->sasa, c, r, nb, NULL, n, p, NULL);
+        break;
+    case FREESASA_LEE_RICHARDS:
+        ret = freesasa_lee_richards_subset(result->sasa, c, r, nb, NULL, n, p);
+        break;
+    default:
+        assert(0); //should never get here
+        ret = FREESASA_FAIL;
+        break;
+    }
+    if (ret == FREESASA_FAIL) goto fail;
+
+    result->total = 0;
+    for (int i = 0; i < n; ++i) result->total += result->sasa[i];
+
+    free(r);
+    return result;
+
+ fail:
+    fail_msg("");
+    if (result && !result->sasa) free(result);
+    else freesasa_result_free(result);
+    free(r);
+    return NULL;
+}
 int
 freesasa_log(FILE *log,
              freesasa_result *result,
@@ -257,10 +417,13 @@ int freesasa_write_parameters(FILE *log,
 
     switch(p->alg) {
     case FREESASA_SHRAKE_RUPLEY:
+    case FREESASA_SHRAKE_RUPLEY_LUT:
         fprintf(log,"testpoints   : %d\n",p->shrake_rupley_n_points);
         break;
     case FREESASA_LEE_RICHARDS:
         fprintf(log,"slices       : %d\n",p->lee_richards_n_slices);
+        if (p->lee_richards_approx)
+            fprintf(log,"approx. acos : yes\n");
         break;
     default:
         assert(0);
@@ -27,7 +27,8 @@ extern "C"{
 //! The FreeSASA algorithms. 
 typedef enum {
     FREESASA_LEE_RICHARDS, //!< Lee & Richards' algorithm
-    FREESASA_SHRAKE_RUPLEY //!< Shrake & Rupley's algorithm
+    FREESASA_SHRAKE_RUPLEY, //!< Shrake & Rupley's algorithm
+    FREESASA_SHRAKE_RUPLEY_LUT //!< Shrake & Rupley's algorithm, approximated using a lookup table (at most 512 test points)
 } freesasa_algorithm;
 
 //! Verbosity levels. @see freesasa_set_verbosity() @see freesasa_get_verbosity()
@@ -43,6 +44,8 @@ typedef enum {
 #define FREESASA_DEF_PROBE_RADIUS 1.4 //!< Default probe radius (in Ångström).
 #define FREESASA_DEF_SR_N 100 //!< Default number of test points in S&R.
 #define FREESASA_DEF_LR_N 20 //!< Default number of slices per atom  in L&R.
+#define FREESASA_DEF_THREAD_CHUNK 32 //!< Default number of atoms handed to a thread at a time.
+#define FREESASA_DEF_TRAJECTORY_SKIN 1.0 //!< Default skin of neighbor lists in trajectories (in Ångström).
 
 //! Default ::freesasa_classifier
 #define freesasa_default_classifier freesasa_protor_classifier
@@ -83,6 +86,19 @@ enum freesasa_structure_options {
 //! The maximum length of a selection name @see freesasa_select_area()
 #define FREESASA_MAX_SELECTION_NAME 50
 
+/**
+    Pool of threads that can be reused by several calculations.
+    @see freesasa_thread_pool_new() @ingroup API
+ */
+typedef struct freesasa_thread_pool freesasa_thread_pool;
+
+/**
+    Context for calculations where only some atoms move between
+    updates.
+    @see freesasa_calculation_new() @ingroup API
+ */
+typedef struct freesasa_calculation freesasa_calculation;
+
 //! Struct to store parameters for SASA calculation @ingroup API
 typedef struct {
     freesasa_algorithm alg;       //!< Algorithm
@@ -90,6 +106,10 @@ typedef struct {
     int shrake_rupley_n_points;   //!< Number of test points in S&R calculation
     int lee_richards_n_slices;    //!< Number of slices per atom in L&R calculation
     int n_threads;                //!< Number of threads to use, if compiled with thread-support
+    int lee_richards_approx;      //!< If non-zero, L&R uses a faster approximation of acos() (absolute error < 2e-8 rad), default 0
+    int reorder_atoms;            //!< If non-zero, atoms are sorted spatially before the calculation, for better cache use with large structures (results are the same), default 0
+    int thread_chunk_size;        //!< Number of atoms handed to a thread at a time, if < 1 ::FREESASA_DEF_THREAD_CHUNK is used
+    freesasa_thread_pool *thread_pool; //!< If not NULL, use the threads of this pool instead of creating new ones (n_threads is ignored)
 } freesasa_parameters;
 
 //! The default parameters for FreeSASA
@@ -122,6 +142,13 @@ typedef struct {
  */
 typedef struct freesasa_structure freesasa_structure;
 
+/**
+    Reads the frames of a trajectory (a PDB file with several MODELs)
+    one at a time.
+    @see freesasa_trajectory_from_pdb() @ingroup API
+ */
+typedef struct freesasa_trajectory freesasa_trajectory;
+
 /**
     Struct used to store n string-value-pairs (strvp) in arrays of
     doubles and strings. freesasa_strvp_free() assumes both arrays
@@ -251,6 +278,118 @@ freesasa_calc_coord(const double *xyz,
 void
 freesasa_result_free(freesasa_result *result);
 
+/**
+    Creates a calculation context for a set of coordinates and radii,
+    for updating the SASA when only some of the atoms move (for
+    example when a few side chains are rotated in a simulation).
+
+    The SASA is first calculated with freesasa_calc_coord(). The
+    context keeps the coordinates, the per-atom SASA and a grid for
+    looking up neighbors. After a call to
+    freesasa_calculation_move(), only the atoms whose surroundings
+    have changed are recalculated. The SASA of each atom is identical
+    to that of freesasa_calc_coord() with the new coordinates. The
+    total is updated with the change in SASA of the recalculated
+    atoms, using compensated summation, and agrees with the sum over
+    all atoms to within rounding errors.
+
+    Return value is dynamically allocated, should be freed with
+    freesasa_calculation_free(). The coordinates and radii are copied.
+    If a thread pool is given in the parameters, it has to be kept
+    alive as long as the context is used.
+
+    @param xyz Array of coordinates in the form x1,y1,z1,x2,y2,z2,...,xn,yn,zn.
+    @param radii Radii, this array should have n elements.
+    @param n Number of coordinates (i.e. xyz has size 3*n, radii size n).
+    @param parameters Parameters for the calculation, if NULL
+    defaults are used.
+    @return The context, NULL if something went wrong.
+ */
+freesasa_calculation *
+freesasa_calculation_new(const double *xyz,
+                         const double *radii,
+                         int n,
+                         const freesasa_parameters *parameters);
+
+/**
+    Moves atoms and updates the SASA.
+
+    The atoms that are recalculated are the moved atoms and their
+    neighbors before and after the move. The cost depends on the
+    number of recalculated atoms, not on the size of the structure.
+
+    @param calc The calculation context.
+    @param atoms Indices of the atoms to move.
+    @param xyz New coordinates of the atoms, x1,y1,z1,x2,... in the
+    same order as atoms.
+    @param n Number of atoms to move.
+    @return ::FREESASA_SUCCESS on success, ::FREESASA_WARN if multiple
+    threads are requested when compiled in single-threaded mode.
+    ::FREESASA_FAIL if an index is out of range, in which case nothing
+    is changed, or if memory allocation fails, in which case the
+    context can only be freed.
+ */
+int
+freesasa_calculation_move(freesasa_calculation *calc,
+                          const int *atoms,
+                          const double *xyz,
+                          int n);
+
+/**
+    The current results of a calculation context.
+
+    @param calc The calculation context.
+    @return The results, owned by the context, and updated by
+    freesasa_calculation_move().
+ */
+const freesasa_result *
+freesasa_calculation_result(const freesasa_calculation *calc);
+
+/**
+    Frees a calculation context.
+
+    @param calc The calculation context.
+ */
+void
+freesasa_calculation_free(freesasa_calculation *calc);
+
+/**
+    Creates a pool of threads for SASA calculations.
+
+    Creating threads is expensive compared to calculating the SASA of
+    small molecules. Applications that do many calculations can
+    instead create a pool once, and pass it to the calculations
+    through freesasa_parameters::thread_pool. The threads of the pool
+    wait for work between calculations.
+
+    The calling thread takes part in the calculations, so the pool
+    only starts n_threads-1 threads. The pool can be shared between
+    threads, but calculations using the same pool are then run one at
+    a time.
+
+    Return value is dynamically allocated, should be freed with
+    freesasa_thread_pool_free().
+
+    @param n_threads Number of threads to use in each calculation
+    (including the calling thread). If the library was compiled
+    without thread support, the pool will only use the calling
+    thread.
+    @return The pool. NULL if n_threads < 1, or if threads couldn't
+    be created or memory allocation failure.
+ */
+freesasa_thread_pool *
+freesasa_thread_pool_new(int n_threads);
+
+/**
+    Stops the threads of a pool and frees it.
+
+    Should not be called while a calculation is using the pool.
+
+    @param pool The pool.
+ */
+void
+freesasa_thread_pool_free(freesasa_thread_pool *pool);
+
 /**
     Generate a classifier from a config-file.
 
@@ -599,7 +738,8 @@ freesasa_structure_free(freesasa_structure* structure);
     Return value is dynamically allocated, should be freed with
     freesasa_structure_free().
 
-    @param pdb A PDB file
+    @param pdb A PDB file, can be gzip-compressed (if FreeSASA was
+      built with zlib).
 
     @param classifier A freesasa_classifier to determine radius of
       atom. If NULL default classifier is used.
@@ -648,6 +788,171 @@ freesasa_structure_array(FILE *pdb,
                          const freesasa_classifier *classifier,
                          int options);
 
+/**
+    Init structure with coordinates from mmCIF (PDBx) file.
+
+    Reads the `_atom_site` loop of the file, starting at the current
+    position. The file is tokenized as it is read, only one row of
+    the loop is stored at a time, so the file can be arbitrarily
+    large, and can be a pipe.
+
+    The atoms are treated exactly like atoms from a PDB file, and the
+    same options apply as for freesasa_structure_from_pdb(), with
+    `_atom_site.group_PDB` determining if an atom is a HETATM,
+    `_atom_site.type_symbol` if it's a hydrogen and
+    `_atom_site.pdbx_PDB_model_num` the model. Author atom names,
+    residue names, residue numbers and chain ids are used when
+    present, the label ones otherwise. Atom names are padded like in
+    PDB files (i.e. `"CA"` becomes `" CA "`). Only the first character
+    of chain ids is used as chain label.
+
+    Structures read from mmCIF can not be written as PDB using
+    freesasa_write_pdb().
+
+    @param cif An mmCIF file.
+    @param classifier A freesasa_classifier to determine radius of
+      atom. If NULL default classifier is used.
+    @param options A bitfield to determine what atoms to include and
+      what to do when atoms are not recognized by classifier, see
+      freesasa_structure_from_pdb().
+    @return The generated structure. Returns `NULL` and prints error
+      if input is invalid or memory allocation failure.
+ */
+freesasa_structure*
+freesasa_structure_from_cif(FILE *cif,
+                            const freesasa_classifier *classifier,
+                            int options);
+
+/**
+    Init array of structures from mmCIF (PDBx) file.
+
+    Like freesasa_structure_array(), but for mmCIF files (see
+    freesasa_structure_from_cif()). Chains are separated using the
+    full chain ids, also when they are longer than one character.
+
+    @param cif Input mmCIF-file.
+    @param n Number of structures found are written to this integer.
+    @param classifier A classifier to calculate atomic radii.
+    @param options Bitfield, see freesasa_structure_array().
+    @return Array of structures. Prints error message(s) and returns
+      NULL if there were problems reading input, if invalid value of
+      `options`, or upon a memory allocation failure.
+ */
+freesasa_structure **
+freesasa_structure_array_from_cif(FILE *cif,
+                                  int *n,
+                                  const freesasa_classifier *classifier,
+                                  int options);
+
+/**
+    Opens a trajectory, i.e. a PDB file where all MODELs have the same
+    atoms, for example from a molecular dynamics simulation.
+
+    The first MODEL is read as a structure, which determines the atoms
+    and their names, radii and classes (these are not changed by
+    later frames). The following frames are streamed from the file
+    with freesasa_trajectory_next(), which only updates the
+    coordinates of the structure. In contrast to
+    freesasa_structure_array() only one frame is stored at a time, and
+    the file is only read forward (i.e. it can be a pipe).
+
+    In subsequent frames atoms are matched to the first frame by name,
+    residue and chain, atoms that were skipped in the first frame
+    (hydrogens, unknown atoms, etc) are skipped.
+
+    Return value is dynamically allocated, should be freed with
+    freesasa_trajectory_free(). The file is not closed.
+
+    @param pdb Input PDB file, positioned at the start of the first
+      MODEL.
+    @param classifier A classifier to calculate atomic radii.
+    @param options Bitfield, same options as
+      freesasa_structure_from_pdb(), except ::FREESASA_JOIN_MODELS,
+      ::FREESASA_SEPARATE_MODELS and ::FREESASA_SEPARATE_CHAINS.
+    @return The trajectory, NULL if there were problems reading the
+      first frame, invalid options or memory allocation failure.
+ */
+freesasa_trajectory *
+freesasa_trajectory_from_pdb(FILE *pdb,
+                             const freesasa_classifier *classifier,
+                             int options);
+
+/**
+    Reads the next frame of a trajectory.
+
+    The first call gives the frame read by
+    freesasa_trajectory_from_pdb(). The coordinates and model number
+    of the structure returned by freesasa_trajectory_structure() are
+    updated.
+
+    @param trajectory The trajectory.
+    @return 1 if a frame was read, 0 at the end of the trajectory.
+      ::FREESASA_FAIL if a frame lacks atoms of the first frame, or
+      if coordinates can't be read.
+ */
+int
+freesasa_trajectory_next(freesasa_trajectory *trajectory);
+
+/**
+    The structure of a trajectory, with the coordinates of the
+    current frame.
+
+    @param trajectory The trajectory.
+    @return The structure, owned by the trajectory.
+ */
+const freesasa_structure *
+freesasa_trajectory_structure(const freesasa_trajectory *trajectory);
+
+/**
+    Calculates the SASA of the current frame of a trajectory.
+
+    Gives the same result as freesasa_calc_structure() with the
+    structure of the trajectory, but the neighbor lists are reused
+    between frames: the candidate neighbors are found with the cutoff
+    extended by a skin distance (see freesasa_trajectory_set_skin()),
+    and only need to be found again when some atom has moved more than
+    half the skin since they were found. In the other frames only the
+    candidates are checked.
+
+    Return value is dynamically allocated, should be freed with
+    freesasa_result_free().
+
+    @param trajectory The trajectory.
+    @param parameters Parameters for the calculation, if NULL
+    defaults are used. freesasa_parameters::reorder_atoms is ignored.
+    @return The result of the calculation, NULL if something went wrong.
+ */
+freesasa_result *
+freesasa_trajectory_calc(freesasa_trajectory *trajectory,
+                         const freesasa_parameters *parameters);
+
+/**
+    Sets the skin distance used for the neighbor lists of a trajectory
+    (see freesasa_trajectory_calc()).
+
+    A larger skin means more candidate neighbors to check in each
+    frame, but fewer frames where they have to be found again. The
+    default is ::FREESASA_DEF_TRAJECTORY_SKIN. With skin 0 the
+    neighbors are found for each frame.
+
+    @param trajectory The trajectory.
+    @param skin The skin in Ångström.
+    @return ::FREESASA_SUCCESS, or ::FREESASA_FAIL if skin is negative.
+ */
+int
+freesasa_trajectory_set_skin(freesasa_trajectory *trajectory,
+                             double skin);
+
+/**
+    Frees a trajectory, but doesn't close its file. The file should
+    not be closed before the trajectory is freed, it is left
+    positioned after the last line that was read.
+
+    @param trajectory The trajectory.
+ */
+void
+freesasa_trajectory_free(freesasa_trajectory *trajectory);
+
 /**
     Add individual atom to structure using default behavior.
     
@@ -728,6 +1033,60 @@ freesasa_structure_add_atom_wopt(freesasa_structure *structure,
                                  const freesasa_classifier *classifier,
                                  int options);
 
+/**
+    Make room for atoms in a structure.
+
+    The arrays of a structure grow by themselves when atoms are
+    added, but if the final number of atoms is known, calling this
+    first avoids reallocating them along the way.
+
+    @param structure The structure.
+    @param n_atoms The total number of atoms to make room for.
+    @return ::FREESASA_SUCCESS on normal execution. ::FREESASA_FAIL if
+      memory allocation fails.
+ */
+int
+freesasa_structure_reserve(freesasa_structure *structure,
+                           int n_atoms);
+
+/**
+    Add several atoms to a structure.
+
+    Equivalent to calling freesasa_structure_add_atom_wopt() for each
+    atom, after making room for all of them with
+    freesasa_structure_reserve(). The atoms are added in the order
+    they are given, and unknown atoms are handled according to
+    `options` in the same way.
+
+    @param structure The structure to add to.
+    @param n The number of atoms.
+    @param atom_names Array of `n` atom names: `" CA "`, `" OXT"`, etc.
+    @param residue_names Array of `n` residue names: `"ALA"`, `"PHE"`, etc.
+    @param residue_numbers Array of `n` residue numbers: `"   1"`, `" 123"`, etc.
+    @param chain_labels Array of `n` chain labels (not a string, doesn't
+      need to be null-terminated).
+    @param xyz Array of coordinates `x1,y1,z1,x2,y2,z2,...`, of size `3*n`.
+    @param classifier A freesasa_classifier to determine radius of atoms and to
+      decide if to keep atoms or not. If NULL default classifier is used.
+    @param options A bitfield to determine what to do with unknown atoms
+      (see freesasa_structure_add_atom_wopt()).
+
+    @return ::FREESASA_SUCCESS on normal execution. ::FREESASA_FAIL if
+       memory allocation fails or if halting at unknown atom, the
+       atoms before it have then been added. ::FREESASA_WARN if
+       skipping atoms.
+ */
+int
+freesasa_structure_add_atoms(freesasa_structure *structure,
+                             int n,
+                             const char **atom_names,
+                             const char **residue_names,
+                             const char **residue_numbers,
+                             const char *chain_labels,
+                             const double *xyz,
+                             const freesasa_classifier *classifier,
+                             int options);
+
 /**
     Create new structure consisting of a selection chains from the
     provided structure.
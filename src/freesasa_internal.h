@@ -2,8 +2,10 @@
 #define FREESASA_INTERNAL_H
 
 #include <stdio.h>
+#include <stdint.h>
 #include "freesasa.h"
 #include "coord.h"
+#include "nb.h"
 
 //! The name of the library, to be used in error messages and logging
 extern const char *freesasa_name;
@@ -45,6 +47,76 @@ freesasa_shrake_rupley(double *sasa,
                        const double *radii,
 		       const freesasa_parameters *param);
 
+//! Number of 64 bit words needed for the S&R bitmask of one atom
+#define FREESASA_SR_MASK_WORDS(n_points) (((n_points)+63)/64)
+
+/**
+    Calculate SASA using S&R algorithm, and store which test points
+    are buried.
+
+    Same as freesasa_shrake_rupley(), but also stores a bitmask for
+    each atom where bit j is set if test point j is buried. The
+    bitmask of atom i starts at word i*FREESASA_SR_MASK_WORDS(n),
+    where n is the number of test points, and bit j is stored in bit
+    j%64 of word j/64. The test points are numbered in the order they
+    are stored internally, which is the same for all atoms and only
+    depends on n.
+
+    @param sasa The results are written to this array, the user has to
+    make sure it is large enough.
+    @param buried The bitmasks are written to this array, of length
+    n_atoms*FREESASA_SR_MASK_WORDS(n). If NULL, it is ignored.
+    @param c Coordinates of the object to calculate SASA for.
+    @param radii Array of radii for each sphere.
+    @param param Parameters specifying resolution, probe radius and
+    number of threads. If NULL :.freesasa_default_parameters is used.
+    @return Same as freesasa_shrake_rupley().
+ */
+int
+freesasa_shrake_rupley_buried(double *sasa,
+                              uint64_t *buried,
+                              const coord_t *c,
+                              const double *radii,
+                              const freesasa_parameters *param);
+
+/**
+    Calculate SASA using a lookup table approximation of the S&R
+    algorithm.
+
+    Instead of testing each test point against the neighbors, the
+    bitmask of the points buried by a neighbor is looked up in a table
+    indexed by the neighbor's (quantized) direction and the opening
+    angle of the cap it buries. This is considerably faster than
+    freesasa_shrake_rupley(), but points close to the edges of the
+    caps can be misclassified. It supports at most 512 test points.
+    The table of the last number of test points used is kept for the
+    following calculations, see freesasa_shrake_rupley_lut_clear().
+
+    @param sasa The results are written to this array, the user has to
+    make sure it is large enough.
+    @param c Coordinates of the object to calculate SASA for.
+    @param radii Array of radii for each sphere.
+    @param param Parameters specifying resolution, probe radius and
+    number of threads. If NULL :.freesasa_default_parameters is used.
+    @return ::FREESASA_SUCCESS on success, ::FREESASA_WARN if
+    multiple threads are requested when compiled in single-threaded
+    mode (with error message). ::FREESASA_FAIL if memory allocation
+    failure, or too many test points requested.
+ */
+int
+freesasa_shrake_rupley_lut(double *sasa,
+                           const coord_t *c,
+                           const double *radii,
+                           const freesasa_parameters *param);
+
+/**
+    Drops the cached lookup table of freesasa_shrake_rupley_lut(). It
+    is freed as soon as no calculation uses it, and the next
+    calculation builds a new table.
+ */
+void
+freesasa_shrake_rupley_lut_clear(void);
+
 /**
     Calculate SASA using L&R algorithm.
 
@@ -71,6 +143,122 @@ int freesasa_lee_richards(double* sasa,
                           const double *radii,
 			  const freesasa_parameters *param);
 
+/**
+    Test points and per-thread work space for repeated S&R
+    calculations with the same parameters, see
+    freesasa_shrake_rupley_subset(). A workspace can only be used by
+    one calculation at a time.
+ */
+typedef struct freesasa_sr_workspace freesasa_sr_workspace;
+
+/**
+    Creates a workspace for S&R calculations with the number of test
+    points, and algorithm variant, in param.
+
+    @param param Parameters. If NULL :.freesasa_default_parameters is used.
+    @return The workspace, or NULL if the parameters are invalid or
+      memory allocation fails.
+ */
+freesasa_sr_workspace *
+freesasa_sr_workspace_new(const freesasa_parameters *param);
+
+/**
+    Frees a workspace.
+
+    @param ws The workspace. If NULL, nothing is done.
+ */
+void
+freesasa_sr_workspace_free(freesasa_sr_workspace *ws);
+
+/**
+    Calculate SASA for a subset of the atoms using the S&R algorithm.
+
+    Only sasa[subset[k]] is written, for k in [0,n_subset). The radii
+    have to include the probe radius, and be the ones the neighbor
+    list was created with. If subset is not NULL, row k of the
+    neighbor list holds the neighbors of atom subset[k] (see
+    freesasa_nb_new_subset()), so that the cost only depends on the
+    size of the subset. If subset is NULL, all atoms are calculated
+    and row i holds the neighbors of atom i. The lookup table variant
+    is used if param->alg is ::FREESASA_SHRAKE_RUPLEY_LUT.
+
+    @param sasa The results are written to this array.
+    @param c Coordinates of all atoms.
+    @param radii Array of radii for each sphere, including the probe.
+    @param nb Neighbor list.
+    @param subset Indices of the atoms to calculate, or NULL for all.
+    @param n_subset Number of atoms in the subset.
+    @param param Parameters. If NULL :.freesasa_default_parameters is used.
+    @param ws Workspace created with the same parameters, or NULL to
+      set up test points and work space for this call only.
+    @return Same as freesasa_shrake_rupley() and freesasa_shrake_rupley_lut().
+ */
+int
+freesasa_shrake_rupley_subset(double *sasa,
+                              const coord_t *c,
+                              const double *radii,
+                              const nb_list *nb,
+                              const int *subset,
+                              int n_subset,
+                              const freesasa_parameters *param,
+                              freesasa_sr_workspace *ws);
+
+/**
+    Calculate SASA for a subset of the atoms using the L&R algorithm.
+
+    Same conventions as freesasa_shrake_rupley_subset(). The
+    algorithm needs no work space beyond the stack.
+
+    @param sasa The results are written to this array.
+    @param c Coordinates of all atoms.
+    @param radii Array of radii for each sphere, including the probe.
+    @param nb Neighbor list.
+    @param subset Indices of the atoms to calculate, or NULL for all.
+    @param n_subset Number of atoms in the subset.
+    @param param Parameters. If NULL :.freesasa_default_parameters is used.
+    @return Same as freesasa_lee_richards().
+ */
+int
+freesasa_lee_richards_subset(double *sasa,
+                             const coord_t *c,
+                             const double *radii,
+                             const nb_list *nb,
+                             const int *subset,
+                             int n_subset,
+                             const freesasa_parameters *param);
+
+
+/**
+    Calculates SASA using a neighbor list from a Verlet list, which is
+    updated for the coordinates.
+
+    The same as freesasa_calc_coord(), except that the neighbor list
+    is reused from earlier calls as long as the coordinates haven't
+    changed too much, see freesasa_nb_verlet_update(). The option
+    freesasa_parameters::reorder_atoms is ignored.
+
+    @param c The coordinates.
+    @param radii The atomic radii.
+    @param verlet The Verlet list.
+    @param parameters Parameters. If NULL :.freesasa_default_parameters is used.
+    @return The result, should be freed with freesasa_result_free(),
+      NULL if something went wrong.
+ */
+freesasa_result *
+freesasa_calc_verlet(const coord_t *c,
+                     const double *radii,
+                     nb_verlet *verlet,
+                     const freesasa_parameters *parameters);
+
+/**
+    Number of atoms recalculated by the last successful call to
+    freesasa_calculation_move() (0 if there has been none).
+
+    @param calc The calculation context.
+    @return The number of atoms.
+ */
+int
+freesasa_calculation_n_recalculated(const freesasa_calculation *calc);
 
 /**
     Get coordinates.
@@ -86,14 +274,36 @@ freesasa_structure_xyz(const freesasa_structure *s);
     Format: "A    1 ALA  CA " 
     (chain label, residue number, residue type, atom name)
 
+    The descriptor is created the first time it is asked for, this
+    function is therefore not thread-safe.
+
     @param s A structure.
     @param i Atom index
-    @return Descriptor string. 
+    @return Descriptor string. NULL if memory allocation fails.
  */
 const char*
 freesasa_structure_atom_descriptor(const freesasa_structure *s,
                                    int i);
 
+/**
+    Get the class of each atom, as given by the classifier
+    (::FREESASA_WARN for unknown atoms).
+
+    If the structure was built using only one of the built-in
+    classifiers, the classes according to that classifier are
+    calculated when the atoms are added, and are copied from the
+    structure. For other classifiers each atom is classified.
+
+    @param s A structure.
+    @param classifier The classifier.
+    @param atom_class The class of each atom is written to this array,
+      which should have freesasa_structure_n() elements.
+ */
+void
+freesasa_structure_atom_classes(const freesasa_structure *s,
+                                const freesasa_classifier *classifier,
+                                int *atom_class);
+
 /**
     Get the index of a chain.
 
@@ -143,14 +353,6 @@ struct file_range {
     long end; //!< Position of end of range
 };
 
-/**
-    For convenience, get a file range that covers a whole file.
-
-    @param file The file to study
-    @return the ::file_range.
- */
-struct file_range
-freesasa_whole_file(FILE* file);
 
 /**
     Print failure message using format string and arguments.
@@ -6,6 +6,7 @@
 #include <string.h>
 #include <getopt.h>
 #include <stdarg.h>
+#include <math.h>
 #if HAVE_CONFIG_H
 #  include <config.h>
 #endif
@@ -50,6 +51,8 @@ int printlog = 1;
 int printpdb = 0;
 int printrsa = 0;
 int static_config = 0;
+int trajectory = 0;
+int cif = 0;
 
 // chain groups
 int n_chain_groups = 0;
@@ -69,7 +72,11 @@ help(void)
             "  -v (--version)        Print version of the program\n");
     fprintf(stderr, "\nPARAMETERS\n"
             "  -S (--shrake-rupley)  Use Shrake & Rupley algorithm\n"
-            "  -L (--lee-richards)   Use Lee & Richards algorithm [default]\n");
+            "  -L (--lee-richards)   Use Lee & Richards algorithm [default]\n"
+            "  --shrake-rupley-lut   Use lookup table approximation of Shrake & Rupley,\n"
+            "                        faster but less accurate, at most 512 test points\n"
+            "  --lee-richards-approx Use approximate arc cosines in Lee & Richards,\n"
+            "                        faster, relative error in SASA of order 1e-8\n");
     fprintf(stderr,
             "\n"
             "  -p <value>  (--probe-radius=<value>)\n"
@@ -111,6 +118,14 @@ help(void)
             "  -m (--join-models)    Join all MODELs in input into one big structure.\n"
             "  -C (--separate-chains) Calculate SASA for each chain separately.\n"
             "  -M (--separate-models) Calculate SASA for each MODEL separately.\n"
+            "  --trajectory          Treat the MODELs as frames of a trajectory, with the\n"
+            "                        same atoms in each. The frames are read and calculated\n"
+            "                        one at a time and the output of each is written when\n"
+            "                        it's done, followed by the average over all frames.\n"
+            "                        Cannot be combined with -m, -M, -C or -g.\n"
+            "  --cif                 Input is in mmCIF (PDBx) format, instead of PDB.\n"
+            "                        Cannot be combined with --trajectory, -B or\n"
+            "                        --B-value-file.\n"
             "\n"
             "  -g <chains> (--chain-groups=<chains>)\n"
             "                        Select chain or group of chains, several groups can be \n"
@@ -160,7 +175,11 @@ help(void)
             "                        which will be reused in output. See documentation for\n"
             "                        full syntax specification.\n");
     fprintf(stderr,
-            "\nIf no pdb-file is specified STDIN is used for input.\n\n"
+            "\nIf no pdb-file is specified STDIN is used for input.\n"
+#if USE_ZLIB
+            "Input files (and STDIN) can be gzip-compressed.\n"
+#endif
+            "\n"
             "To calculate SASA of one or several PDB file using default parameters simply\ntype:\n\n"
             "   '%s pdb-file(s)'     or    '%s < pdb-file'\n\n",
             program_name,program_name);
@@ -218,7 +237,8 @@ get_structures(FILE *input, int *n)
    *n = 0;
    if ((structure_options & FREESASA_SEPARATE_CHAINS) ||
        (structure_options & FREESASA_SEPARATE_MODELS)) {
-       structures = freesasa_structure_array(input, n, classifier, structure_options);
+       if (cif) structures = freesasa_structure_array_from_cif(input, n, classifier, structure_options);
+       else structures = freesasa_structure_array(input, n, classifier, structure_options);
        if (structures == NULL) abort_msg("Invalid input.");
        for (int i = 0; i < *n; ++i) {
            if (structures[i] == NULL) abort_msg("Invalid input.");
@@ -229,7 +249,8 @@ get_structures(FILE *input, int *n)
            abort_msg("Out of memory.");
        }
        *n = 1;
-       structures[0] = freesasa_structure_from_pdb(input, classifier, structure_options);
+       if (cif) structures[0] = freesasa_structure_from_cif(input, classifier, structure_options);
+       else structures[0] = freesasa_structure_from_pdb(input, classifier, structure_options);
        if (structures[0] == NULL) {
            abort_msg("Invalid input.");
        }
@@ -258,6 +279,48 @@ get_structures(FILE *input, int *n)
 }
 
 
+void
+write_results(freesasa_result *result,
+              const freesasa_strvp *classes,
+              const freesasa_structure *structure,
+              const char *name,
+              int several)
+{
+    if (printlog) {
+        if (several) fprintf(output,"\n\n####################\n");
+        freesasa_write_result(output, result, name, 
+                              freesasa_structure_chain_labels(structure), classes);
+        freesasa_per_chain(output, result, structure);
+    }
+    if (per_residue_type) {
+        if (several) fprintf(per_residue_type_file, "\n## %s\n", name);
+        freesasa_per_residue_type(per_residue_type_file, result, structure);
+    }
+    if (per_residue) {
+        if (several) fprintf(per_residue_file, "\n## %s\n", name);
+        freesasa_per_residue(per_residue_file, result, structure);
+    }
+    if (printpdb) {
+        freesasa_write_pdb(output_pdb, result, structure);
+    }
+    if (n_select > 0) {
+        fprintf(output,"\nSELECTIONS\n");
+        for (int c = 0; c < n_select; ++c) {
+            double a;
+            char sel_name[FREESASA_MAX_SELECTION_NAME+1];
+            if (freesasa_select_area(select_cmd[c], sel_name, &a, structure, result)
+                == FREESASA_SUCCESS) {
+                fprintf(output, "%s : %10.2f\n", sel_name, a);
+            } else {
+                abort_msg("Illegal selection");
+            }
+        }
+    }
+    if (printrsa) {
+        freesasa_write_rsa(rsa_file, result, structure, name, rsa_reference);
+    }
+}
+
 void
 run_analysis(FILE *input,
              const char *name)
@@ -286,39 +349,7 @@ run_analysis(FILE *input,
         strcpy(name_i,name);
         if (n > 1 && (structure_options & FREESASA_SEPARATE_MODELS))
             sprintf(name_i+strlen(name_i), ":%d", freesasa_structure_model(structures[i]));
-        if (printlog) {
-            if (n > 1) fprintf(output,"\n\n####################\n");
-            freesasa_write_result(output, result, name_i, 
-                                  freesasa_structure_chain_labels(structures[i]), classes);
-            freesasa_per_chain(output, result, structures[i]);
-        }
-        if (per_residue_type) {
-            if (n > 1) fprintf(per_residue_type_file, "\n## %s\n", name_i);
-            freesasa_per_residue_type(per_residue_type_file, result, structures[i]);
-        }
-        if (per_residue) {
-            if (n > 1) fprintf(per_residue_file, "\n## %s\n", name_i);
-            freesasa_per_residue(per_residue_file, result, structures[i]);
-        }
-        if (printpdb) {
-            freesasa_write_pdb(output_pdb, result, structures[i]);
-        }
-        if (n_select > 0) {
-            fprintf(output,"\nSELECTIONS\n");
-            for (int c = 0; c < n_select; ++c) {
-                double a;
-                char sel_name[FREESASA_MAX_SELECTION_NAME+1];
-                if (freesasa_select_area(select_cmd[c], sel_name, &a, structures[i], result)
-                    == FREESASA_SUCCESS) {
-                    fprintf(output, "%s : %10.2f\n", sel_name, a);
-                } else {
-                    abort_msg("Illegal selection");
-                }
-            }
-        }
-        if (printrsa) {
-            freesasa_write_rsa(rsa_file, result, structures[i], name_i, rsa_reference);
-        }
+        write_results(result, classes, structures[i], name_i, n > 1);
         freesasa_result_free(result);
         freesasa_strvp_free(classes);
         freesasa_structure_free(structures[i]);
@@ -326,6 +357,101 @@ run_analysis(FILE *input,
     free(structures);
 }
 
+/**
+    Calculates the SASA of each frame of a trajectory as it is read,
+    and prints the average over all frames at the end.
+ */
+void
+run_trajectory(FILE *input,
+               const char *name)
+{
+    int name_len = strlen(name), n_frames = 0, ret;
+    freesasa_trajectory *trajectory;
+    const freesasa_structure *structure;
+    freesasa_result *result = NULL;
+    freesasa_strvp *classes = NULL, *first_classes = NULL;
+    freesasa_parameters param = parameters;
+    freesasa_thread_pool *pool = NULL;
+    double sum = 0, sum2 = 0, min = 0, max = 0, *class_sum = NULL;
+    int n_classes = 0;
+
+    trajectory = freesasa_trajectory_from_pdb(input, classifier, structure_options);
+    if (trajectory == NULL) abort_msg("Invalid input.");
+    structure = freesasa_trajectory_structure(trajectory);
+
+    // the same threads and neighbor lists are used for all frames
+    if (param.n_threads > 1 && param.thread_pool == NULL) {
+        pool = freesasa_thread_pool_new(param.n_threads);
+        if (pool == NULL) abort_msg("Can't create threads.");
+        param.thread_pool = pool;
+    }
+
+    if (printlog) {
+        freesasa_write_parameters(output, &parameters);
+    }
+
+    while ((ret = freesasa_trajectory_next(trajectory)) == 1) {
+        char name_i[name_len+10];
+        result = freesasa_trajectory_calc(trajectory, &param);
+        if (result == NULL)        abort_msg("Can't calculate SASA.");
+        classes = freesasa_result_classify(result, structure, classifier);
+        if (classes == NULL)       abort_msg("Can't determine atom classes. Aborting.");
+        sprintf(name_i, "%s:%d", name, freesasa_structure_model(structure));
+        write_results(result, classes, structure, name_i, 1);
+
+        if (n_frames == 0) {
+            // the class names of the first frame are used in the summary
+            first_classes = classes;
+            n_classes = classes->n;
+            class_sum = calloc(n_classes, sizeof(double));
+            if (class_sum == NULL) abort_msg("Out of memory.");
+            min = max = result->total;
+        }
+        for (int c = 0; c < n_classes && c < classes->n; ++c)
+            class_sum[c] += classes->value[c];
+        sum += result->total;
+        sum2 += result->total * result->total;
+        if (result->total < min) min = result->total;
+        if (result->total > max) max = result->total;
+        ++n_frames;
+
+        // make each frame available as soon as it's done
+        fflush(output);
+        if (per_residue_type) fflush(per_residue_type_file);
+        if (per_residue) fflush(per_residue_file);
+        if (printpdb) fflush(output_pdb);
+        if (printrsa) fflush(rsa_file);
+
+        if (classes != first_classes) freesasa_strvp_free(classes);
+        freesasa_result_free(result);
+    }
+    if (ret == FREESASA_FAIL) abort_msg("Invalid input.");
+
+    if (printlog && n_frames > 0) {
+        const double mean = sum / n_frames,
+            var = sum2 / n_frames - mean * mean;
+        fprintf(output, "\n\n####################\n");
+        fprintf(output, "\nTRAJECTORY\n");
+        fprintf(output, "source  : %s\n", name);
+        fprintf(output, "frames  : %d\n", n_frames);
+        fprintf(output, "\nAVERAGE OVER FRAMES (A^2)\n");
+        fprintf(output, "Total   : %10.2f\n", mean);
+        fprintf(output, "St.dev. : %10.2f\n", var > 0 ? sqrt(var) : 0);
+        fprintf(output, "Min     : %10.2f\n", min);
+        fprintf(output, "Max     : %10.2f\n", max);
+        for (int c = 0; c < n_classes; ++c) {
+            if (class_sum[c] > 0)
+                fprintf(output, "%-7s : %10.2f\n",
+                        first_classes->string[c], class_sum[c] / n_frames);
+        }
+    }
+
+    freesasa_strvp_free(first_classes);
+    free(class_sum);
+    freesasa_thread_pool_free(pool);
+    freesasa_trajectory_free(trajectory);
+}
+
 FILE*
 fopen_werr(const char* filename,
            const char* mode) 
@@ -434,7 +560,8 @@ main(int argc,
     char opt_set[n_opt];
     int option_index = 0;
     int option_flag;
-    enum {B_FILE, RES_FILE, SEQ_FILE, SELECT, UNKNOWN, RSA_FILE, RSA, RADII};
+    enum {B_FILE, RES_FILE, SEQ_FILE, SELECT, UNKNOWN, RSA_FILE, RSA, RADII, SR_LUT, LR_APPROX,
+          TRAJECTORY, CIF};
     parameters = freesasa_default_parameters;
     memset(opt_set, 0, n_opt);
     program_name = "freesasa";
@@ -470,6 +597,10 @@ main(int argc,
         {"rsa-file",             required_argument, &option_flag, RSA_FILE},
         {"rsa",                  no_argument,       &option_flag, RSA},
         {"radii",                required_argument, &option_flag, RADII},
+        {"shrake-rupley-lut",    no_argument,       &option_flag, SR_LUT},
+        {"lee-richards-approx",  no_argument,       &option_flag, LR_APPROX},
+        {"trajectory",           no_argument,       &option_flag, TRAJECTORY},
+        {"cif",                  no_argument,       &option_flag, CIF},
         {0,0,0,0}
     };
     options_string = ":hvlwLSHYOCMmBrRc:n:t:p:g:e:o:";
@@ -525,6 +656,19 @@ main(int argc,
                               "can only be 'protor' or 'naccess')", optarg);
                 }
                 break;
+            case SR_LUT:
+                parameters.alg = FREESASA_SHRAKE_RUPLEY_LUT;
+                ++alg_set;
+                break;
+            case LR_APPROX:
+                parameters.lee_richards_approx = 1;
+                break;
+            case TRAJECTORY:
+                trajectory = 1;
+                break;
+            case CIF:
+                cif = 1;
+                break;
             default:
                 abort(); // what does this even mean?
             }
@@ -640,6 +784,10 @@ main(int argc,
     if (opt_set['c'] && static_config) abort_msg("The options -c and --radii cannot be combined");
     if (opt_set['O'] && static_config) abort_msg("The options -O and --radii cannot be combined");
     if (opt_set['c'] && opt_set['O']) abort_msg("The option -c and -O can't be combined");
+    if (trajectory && (opt_set['m'] || opt_set['M'] || opt_set['C'] || opt_set['g']))
+        abort_msg("The option --trajectory can't be combined with -m, -M, -C or -g");
+    if (cif && (trajectory || printpdb))
+        abort_msg("The option --cif can't be combined with --trajectory, -B or --B-value-file");
     if (printrsa && (opt_set['c'] || opt_set['O'])) {
         freesasa_warn("Will skip REL columns in RSA when custom atomic radii selected.");
     }
@@ -648,11 +796,15 @@ main(int argc,
         for (int i = optind; i < argc; ++i) {
             errno = 0;
             input = fopen_werr(argv[i],"r");
-            run_analysis(input, argv[i]);
+            if (trajectory) run_trajectory(input, argv[i]);
+            else run_analysis(input, argv[i]);
             fclose(input);
         }
     } else {
-        if (!isatty(STDIN_FILENO)) run_analysis(stdin, "stdin");
+        if (!isatty(STDIN_FILENO)) {
+            if (trajectory) run_trajectory(stdin, "stdin");
+            else run_analysis(stdin, "stdin");
+        }
         else abort_msg("No input.", program_name);
     }
 
@@ -1,13 +1,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <assert.h>
+#include <stdint.h>
+#include <string.h>
 #include "freesasa.h"
 #include "freesasa_internal.h"
 #include "nb.h"
-
-#ifndef FREESASA_NB_CHUNK
-#define FREESASA_NB_CHUNK 128
-#endif
+#include "thread.h"
 
 typedef struct cell cell;
 struct cell {
@@ -34,6 +33,14 @@ typedef struct cell_list {
 
 static struct cell_list empty_cell_list = {NULL,0,0,0,0,0,0,0,0,0,0,0};
 
+/* If the bounding box of the coordinates would have more cells than
+   this per coordinate, most cells are empty (for example two
+   molecules far apart, or a long fibril along a diagonal), and only
+   the occupied cells are stored. Proteins typically have more than
+   ten atoms per cell. Small grids are always stored in full. */
+#define NB_SPARSE_CELLS_PER_ATOM 1
+#define NB_SPARSE_MIN_CELLS 4096
+
 //! Finds the bounds of the cell list and writes them to the provided cell list
 static void
 cell_list_bounds(cell_list *c, 
@@ -61,7 +68,6 @@ cell_list_bounds(cell_list *c,
     c->nx = ceil((c->x_max - c->x_min)/d);
     c->ny = ceil((c->y_max - c->y_min)/d);
     c->nz = ceil((c->z_max - c->z_min)/d);
-    c->n = c->nx*c->ny*c->nz;
 }
 
 static inline int
@@ -168,10 +174,146 @@ cell_list_free(cell_list *c)
     }
 }
 
+//! Position of a cell in the full grid, as a 64-bit integer
+static inline uint64_t
+cell_key(const cell_list *c,
+         int ix,
+         int iy,
+         int iz)
+{
+    return (uint64_t)ix + (uint64_t)c->nx*((uint64_t)iy + (uint64_t)c->ny*iz);
+}
+
+struct cell_key_atom {
+    uint64_t key;
+    int atom;
+};
+
+//! For qsort(), sorts by key and then atom
+static int
+cell_key_atom_cmp(const void *a,
+                  const void *b)
+{
+    const struct cell_key_atom *ka = a, *kb = b;
+    if (ka->key < kb->key) return -1;
+    if (ka->key > kb->key) return 1;
+    return ka->atom - kb->atom;
+}
+
+//! Hash table slot of a cell key, the table has 2^bits slots
+static inline unsigned
+cell_hash(uint64_t key,
+          int bits)
+{
+    return (unsigned)((key * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+}
+
+//! Slot in the hash table of occupied cells
+struct cell_slot {
+    uint64_t key;
+    int cell; //! -1 if slot is empty
+};
+
+/**
+    Creates only the occupied cells of the grid. The atoms are sorted
+    by cell, the cells are stored in the order of their position in
+    the full grid, and the neighbors of each cell are looked up in a
+    hash table with the occupied cells. The resulting neighbor list
+    is thus the same as with the full grid (empty cells don't
+    contribute any neighbors).
+
+    Returns FREESASA_FAIL if malloc fails, FREESASA_SUCCESS else.
+ */
+static int
+fill_cells_sparse(cell_list *c,
+                  const coord_t *coord)
+{
+    const int n = freesasa_coord_n(coord);
+    struct cell_key_atom *ka = malloc(sizeof(struct cell_key_atom)*n);
+    struct cell_slot *table = NULL;
+    int n_cells = 0, bits = 1, ret = FREESASA_FAIL;
+    unsigned mask;
+
+    if (ka == NULL) { mem_fail(); goto cleanup; }
+
+    for (int i = 0; i < n; ++i) {
+        const double *v = freesasa_coord_i(coord,i);
+        ka[i].key = cell_key(c, (int)((v[0] - c->x_min)/c->d),
+                             (int)((v[1] - c->y_min)/c->d),
+                             (int)((v[2] - c->z_min)/c->d));
+        ka[i].atom = i;
+    }
+    qsort(ka, n, sizeof(struct cell_key_atom), cell_key_atom_cmp);
+    for (int i = 0; i < n; ++i) {
+        if (i == 0 || ka[i].key != ka[i-1].key) ++n_cells;
+    }
+
+    c->cell = malloc(sizeof(cell)*n_cells);
+    if (c->cell == NULL) { mem_fail(); goto cleanup; }
+    c->n = n_cells;
+    for (int i = 0; i < n_cells; ++i) c->cell[i] = empty_cell;
+
+    // hash table with at most 50 % load
+    while ((1 << bits) < 2*n_cells) ++bits;
+    mask = (1u << bits) - 1;
+    table = malloc(sizeof(struct cell_slot)*(mask + 1));
+    if (table == NULL) { mem_fail(); goto cleanup; }
+    for (unsigned h = 0; h <= mask; ++h) table[h].cell = -1;
+
+    for (int i = 0, ic = 0; i < n; ++ic) {
+        int j = i;
+        cell *ci = &c->cell[ic];
+        unsigned h = cell_hash(ka[i].key, bits);
+        while (j < n && ka[j].key == ka[i].key) ++j;
+        ci->atom = malloc(sizeof(int)*(j-i));
+        if (ci->atom == NULL) { mem_fail(); goto cleanup; }
+        ci->n_atoms = j-i;
+        for (int k = i; k < j; ++k) ci->atom[k-i] = ka[k].atom;
+        while (table[h].cell >= 0) h = (h + 1) & mask;
+        table[h].key = ka[i].key;
+        table[h].cell = ic;
+        i = j;
+    }
+
+    // forward neighbors, in the same order as fill_nb()
+    for (int ic = 0; ic < n_cells; ++ic) {
+        cell *ci = &c->cell[ic];
+        const double *v = freesasa_coord_i(coord, ci->atom[0]);
+        const int ix = (int)((v[0] - c->x_min)/c->d),
+            iy = (int)((v[1] - c->y_min)/c->d),
+            iz = (int)((v[2] - c->z_min)/c->d);
+        int n_nb = 0;
+        for (int i = ix > 0 ? ix - 1 : 0; i <= ix + 1 && i < c->nx; ++i) {
+            for (int j = iy > 0 ? iy - 1 : 0; j <= iy + 1 && j < c->ny; ++j) {
+                for (int k = iz > 0 ? iz - 1 : 0; k <= iz + 1 && k < c->nz; ++k) {
+                    if (i-ix+j-iy+k-iz < 0) continue;
+                    const uint64_t key = cell_key(c,i,j,k);
+                    for (unsigned h = cell_hash(key, bits); table[h].cell >= 0;
+                         h = (h + 1) & mask) {
+                        if (table[h].key == key) {
+                            ci->nb[n_nb++] = &c->cell[table[h].cell];
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        ci->n_nb = n_nb;
+        assert(n_nb > 0);
+    }
+    ret = FREESASA_SUCCESS;
+
+ cleanup:
+    free(ka);
+    free(table);
+    return ret;
+}
+
 /**
     Creates a cell list with provided cell-size assigning cells to
     each of the provided coordinates. The created cell list should be
-    freed using cell_list_free().
+    freed using cell_list_free(). The full grid is stored if it is
+    reasonably well occupied, else only the occupied cells.
     
     Returns NULL if there are malloc fails.
  */
@@ -190,6 +332,18 @@ cell_list_new(double cell_size,
     c->d = cell_size;
     cell_list_bounds(c,coord);
 
+    const double n_cells = (double)c->nx*c->ny*c->nz;
+    if (n_cells > NB_SPARSE_MIN_CELLS &&
+        n_cells > (double)NB_SPARSE_CELLS_PER_ATOM*freesasa_coord_n(coord)) {
+        if (fill_cells_sparse(c,coord)) {
+            cell_list_free(c);
+            mem_fail();
+            return NULL;
+        }
+        return c;
+    }
+
+    c->n = c->nx*c->ny*c->nz;
     c->cell = malloc(sizeof(cell)*c->n);
     if (!c->cell) {
         cell_list_free(c);
@@ -223,8 +377,9 @@ max_array(const double *a,
 }
 
 /**
-    Allocate memory for ::nb_list object. Tries to free everything
-    and returns NULL if malloc somewhere along the way.
+    Allocate memory for ::nb_list object, except the pairs, which are
+    allocated once their number is known. Tries to free everything and
+    returns NULL if malloc somewhere along the way.
  */
 static nb_list*
 freesasa_nb_alloc(int n)
@@ -234,113 +389,92 @@ freesasa_nb_alloc(int n)
     if (!nb) {mem_fail(); return NULL;}
 
     nb->n = n;
-    
-    // in case the mallocs break, we can clean up in a safer way
-    nb->nn = NULL;
-    nb->nb = NULL;
-    nb->capacity = NULL; 
-    nb->xyd = nb->xd = nb->yd = NULL;
-
-    nb->nn = malloc(sizeof(int)*n);
-    nb->nb = malloc(sizeof(int *)*n);
-    nb->xyd = malloc(sizeof(double *)*n);
-    nb->xd = malloc(sizeof(double *)*n);
-    nb->yd = malloc(sizeof(double *)*n);
-    nb->capacity = malloc(sizeof(int)*n);
-
-    if (!nb->nn || !nb->nb || !nb->xyd || 
-        !nb->xd || !nb->yd || !nb->capacity) {
-        free(nb->nn); free(nb->nb); free(nb->xyd); 
-        free(nb->xd); free(nb->yd); free(nb->capacity);
+    nb->pair = NULL;
+
+    // nn and first share one allocation
+    nb->nn = malloc(sizeof(int)*(2*n+1));
+    if (!nb->nn) {
         free(nb);
-        mem_fail(); 
+        mem_fail();
         return NULL;
     }
+    nb->first = nb->nn + n;
+
+    for (int i = 0; i < n; ++i) nb->nn[i] = 0;
 
-    for (int i=0; i < n; ++i) {
-        nb->nn[i] = 0;
-        nb->capacity[i] = FREESASA_NB_CHUNK;
-        // again prepare for a potential cleanup
-        nb->nb[i] = NULL;
-        nb->xyd[i] = nb->xd[i] = nb->yd[i] = NULL;
-    }
-    for (int i=0; i < n; ++i) {
-        nb->nb[i] = malloc(sizeof(int)*FREESASA_NB_CHUNK);
-        nb->xyd[i] = malloc(sizeof(double)*FREESASA_NB_CHUNK);
-        nb->xd[i] = malloc(sizeof(double)*FREESASA_NB_CHUNK);
-        nb->yd[i] = malloc(sizeof(double)*FREESASA_NB_CHUNK);
-        if (!nb->nb[i] || !nb->xyd[i] || !nb->xd[i] || !nb->yd[i]) {
-            freesasa_nb_free(nb);
-            mem_fail();
-            return NULL;
-        }
-    }
     return nb;
 }
 
 void
 freesasa_nb_free(nb_list *nb)
 {
-    int n;
     if (nb != NULL) {
-        n = nb->n;
-        if (nb->nb)  for (int i = 0; i < n; ++i) free(nb->nb[i]);
-        if (nb->xyd) for (int i = 0; i < n; ++i) free(nb->xyd[i]);
-        if (nb->xd)  for (int i = 0; i < n; ++i) free(nb->xd[i]);
-        if (nb->yd)  for (int i = 0; i < n; ++i) free(nb->yd[i]);
-        free(nb->nb);
         free(nb->nn);
-        free(nb->capacity);
-        free(nb->xyd);
-        free(nb->xd);
-        free(nb->yd);
+        free(nb->pair);
         free(nb);
     }
 }
 
+//! A contact found by one of the threads in nb_build_threads()
+struct nb_contact {
+    int i, j;
+    double dx, dy;
+};
+
 /**
-    Increases sizes of arrays when they cross a threshold. Returns
-    FREESASA_FAIL if realloc fails, FREESASA_SUCCESS else
+    The contacts found in a block of consecutive cells, by one
+    thread. Before the contacts are written to the list, nn is
+    converted to the positions in the pair array of the list where
+    the block writes its neighbors of each element.
  */
-static int
-chunk_up(nb_list *nb_list,
-         int i)
-{
-    int nni = nb_list->nn[i];
+struct nb_block {
+    int cell_begin, cell_end; //! the cells [cell_begin,cell_end)
+    int *nn; //! number of neighbors of each element found in block
+    struct nb_contact *contact;
+    int n_contacts;
+    int capacity;
+    int fail; //! set if contact array couldn't be grown
+};
 
-    if (nni > nb_list->capacity[i]) {
-        int **nbi = &nb_list->nb[i];
-        int *nbi_b = *nbi;
-        double **xydi = &nb_list->xyd[i];
-        double **xdi = &nb_list->xd[i];
-        double **ydi = &nb_list->yd[i];
-        double *xydi_b = *xydi, *xdi_b = *xdi, *ydi_b = *ydi;
-        int new_cap = (nb_list->capacity[i] += FREESASA_NB_CHUNK);
+//! Arguments for the threads in nb_build_threads()
+struct nb_threads {
+    nb_list *nb_list;
+    cell_list *c;
+    const coord_t *coord;
+    const double *radii;
+    struct nb_block *block;
+};
 
-        *nbi = realloc(*nbi,sizeof(int)*new_cap);
-        if (*nbi == NULL)  { nb_list->nb[i]  = nbi_b;  return mem_fail(); }
+//! Writes the pair i,j to the two provided positions
+static inline void
+nb_write_pair(nb_pair *pi,
+              nb_pair *pj,
+              int i,
+              int j,
+              double dx,
+              double dy)
+{
+    const double d = sqrt(dx*dx+dy*dy);
 
-        *xydi = realloc(*xydi,sizeof(double)*new_cap);
-        if (*xydi == NULL) { nb_list->xyd[i] = xydi_b; return mem_fail(); }
+    pi->j = j;
+    pj->j = i;
 
-        *xdi = realloc(*xdi,sizeof(double)*new_cap);
-        if (*xdi == NULL)  { nb_list->xd[i]  = xdi_b;  return mem_fail(); }
+    pi->xyd = d;
+    pj->xyd = d;
 
-        *ydi = realloc(*ydi,sizeof(double)*new_cap);
-        if (*ydi == NULL)  { nb_list->yd[i]  = ydi_b;  return mem_fail(); }
-    }
-    return FREESASA_SUCCESS;
+    pi->xd = dx;
+    pj->xd = -dx;
+    pi->yd = dy;
+    pj->yd = -dy;
 }
 
 /**
     Assumes the coordinates i and j have been determined to be
     neighbors and adds them both to the provided nb lists,
-    symmetrically.
-
-    Returns FREESASA_FAIL if can't allocate memory. FREESASA_SUCCESS
-    else.
+    symmetrically. If the pairs haven't been allocated yet, they are
+    only counted.
 */
-static int
+static inline void
 nb_add_pair(nb_list *nb_list,
             int i,
             int j,
@@ -349,48 +483,56 @@ nb_add_pair(nb_list *nb_list,
 {
     assert(i != j);
 
-    int ** nb;
     int * nn = nb_list->nn;
-    int nni, nnj;
-    double ** xyd;
-    double ** xd;
-    double ** yd;
-    double d;
-
-    nni = nn[i]++;
-    nnj = nn[j]++;
-
-    if (chunk_up(nb_list,i)) return mem_fail();
-    if (chunk_up(nb_list,j)) return mem_fail();
-
-    nb = nb_list->nb;
-    xyd = nb_list->xyd;
-    xd = nb_list->xd;
-    yd = nb_list->yd;
-
-    nb[i][nni] = j;
-    nb[j][nnj] = i;
-
-    d = sqrt(dx*dx+dy*dy);
+    const int nni = nn[i]++;
+    const int nnj = nn[j]++;
 
-    xyd[i][nni] = d;
-    xyd[j][nnj] = d;
+    if (nb_list->pair) {
+        nb_write_pair(&nb_list->pair[nb_list->first[i] + nni],
+                      &nb_list->pair[nb_list->first[j] + nnj],
+                      i, j, dx, dy);
+    }
+}
 
-    xd[i][nni] = dx;
-    xd[j][nnj] = -dx;
-    yd[i][nni] = dy;
-    yd[j][nnj] = -dy;
+/**
+    Stores the contact between i and j in the block, growing the
+    contact array if necessary. Returns FREESASA_FAIL if realloc
+    fails, FREESASA_SUCCESS else.
+ */
+static inline int
+nb_block_add(struct nb_block *block,
+             int i,
+             int j,
+             double dx,
+             double dy)
+{
+    assert(i != j);
 
+    if (block->n_contacts == block->capacity) {
+        struct nb_contact *contact = block->contact;
+        int new_cap = 2*block->capacity;
+        contact = realloc(contact, sizeof(struct nb_contact)*new_cap);
+        if (contact == NULL) return mem_fail();
+        block->contact = contact;
+        block->capacity = new_cap;
+    }
+    block->contact[block->n_contacts++] = (struct nb_contact){i, j, dx, dy};
+    ++block->nn[i];
+    ++block->nn[j];
     return FREESASA_SUCCESS;
 }
 
 /**
-    Fills the nb list for all contacts between coordinates
-    belonging to the cells ci and cj. Handles the case ci == cj
-    correctly.
+    Fills the nb list, or if block is not NULL, the block, with all
+    contacts between coordinates belonging to the cells ci and
+    cj. Handles the case ci == cj correctly.
+
+    Returns FREESASA_FAIL if the block can't be grown,
+    FREESASA_SUCCESS else.
 */
-static int 
+static int
 nb_calc_cell_pair(nb_list *nb_list,
+                  struct nb_block *block,
                   const coord_t *coord,
                   const double *radii,
                   const cell *ci,
@@ -415,8 +557,11 @@ nb_calc_cell_pair(nb_list *nb_list,
             cut2 = (ri+rj)*(ri+rj);
             dx = xj-xi; dy = yj-yi; dz = zj-zi;
             if (dx*dx + dy*dy + dz*dz < cut2) {
-                if (nb_add_pair(nb_list,ia,ja,dx,dy))
-                    return mem_fail();
+                if (block == NULL) {
+                    nb_add_pair(nb_list,ia,ja,dx,dy);
+                } else if (nb_block_add(block,ia,ja,dx,dy)) {
+                    return FREESASA_FAIL;
+                }
             }
         }
     }
@@ -424,35 +569,221 @@ nb_calc_cell_pair(nb_list *nb_list,
 }
                              
 /**
-    Iterates through the cells and records all contacts in the
-    provided nb list
+    Iterates through the cells [begin,end) and records all contacts
+    in the provided nb list, or block if not NULL.
+
+    Returns FREESASA_FAIL if the block can't be grown,
+    FREESASA_SUCCESS else.
  */
 static int
 nb_fill_list(nb_list *nb_list,
+             struct nb_block *block,
              cell_list *c,
+             int begin,
+             int end,
              const coord_t *coord,
              const double *radii)
 {
-    int nc = c->n;
-    for (int ic = 0; ic < nc; ++ic) {
+    for (int ic = begin; ic < end; ++ic) {
         const cell *ci = &c->cell[ic];
         for (int jc = 0; jc < ci->n_nb; ++jc) {
             const cell *cj = ci->nb[jc];
-            if (nb_calc_cell_pair(nb_list,coord,radii,ci,cj))
-                return mem_fail();
+            if (nb_calc_cell_pair(nb_list,block,coord,radii,ci,cj))
+                return FREESASA_FAIL;
         }
     }
     return FREESASA_SUCCESS;
 }
 
+/**
+    Builds the list in two passes over the cells: the first counts
+    the neighbors of each element, which determines where in the pair
+    array the neighbors of each element start, the second fills in
+    the pairs. Returns FREESASA_FAIL if the pairs can't be allocated.
+ */
+static int
+nb_build(nb_list *nb_list,
+         cell_list *c,
+         const coord_t *coord,
+         const double *radii)
+{
+    const int n = nb_list->n;
+    int *nn = nb_list->nn, *first = nb_list->first;
+
+    nb_fill_list(nb_list,NULL,c,0,c->n,coord,radii);
+
+    first[0] = 0;
+    for (int i = 0; i < n; ++i) {
+        first[i+1] = first[i] + nn[i];
+        nn[i] = 0;
+    }
+
+    // malloc(0) is allowed to return NULL
+    nb_list->pair = malloc(sizeof(nb_pair)*(first[n] > 0 ? first[n] : 1));
+    if (nb_list->pair == NULL) return mem_fail();
+
+    nb_fill_list(nb_list,NULL,c,0,c->n,coord,radii);
+
+    return FREESASA_SUCCESS;
+}
+
+//! Finds the contacts in the blocks [begin,end), see freesasa_thread_run()
+static void
+nb_find_task(int begin,
+             int end,
+             int thread,
+             void *arg)
+{
+    struct nb_threads *t = arg;
+    (void)thread;
+    for (int b = begin; b < end; ++b) {
+        struct nb_block *block = &t->block[b];
+        for (int i = 0; i < t->nb_list->n; ++i) block->nn[i] = 0;
+        block->fail = nb_fill_list(t->nb_list, block, t->c,
+                                   block->cell_begin, block->cell_end,
+                                   t->coord, t->radii);
+    }
+}
+
+/**
+    Writes the contacts of the blocks [begin,end) to the list, see
+    freesasa_thread_run(). The blocks write to disjoint parts of the
+    pair array, so no locking is needed.
+ */
+static void
+nb_write_task(int begin,
+              int end,
+              int thread,
+              void *arg)
+{
+    struct nb_threads *t = arg;
+    nb_pair *pair = t->nb_list->pair;
+    (void)thread;
+    for (int b = begin; b < end; ++b) {
+        struct nb_block *block = &t->block[b];
+        int *pos = block->nn;
+        for (int k = 0; k < block->n_contacts; ++k) {
+            const struct nb_contact *ct = &block->contact[k];
+            nb_write_pair(&pair[pos[ct->i]++], &pair[pos[ct->j]++],
+                          ct->i, ct->j, ct->dx, ct->dy);
+        }
+    }
+}
+
+/**
+    Builds the list using n_threads threads. The cells are divided
+    into one block of consecutive cells per thread, with roughly the
+    same number of atom pairs to compare in each. Each thread stores
+    the contacts it finds in its own buffer. Then the buffers are
+    written to the list in parallel, with the neighbors found in block
+    b placed after those found in blocks 0, ..., b-1. The order of
+    the neighbors is thus the same as in nb_build().
+
+    Returns FREESASA_FAIL if memory allocation fails.
+ */
+static int
+nb_build_threads(nb_list *nb_list,
+                 cell_list *c,
+                 const coord_t *coord,
+                 const double *radii,
+                 freesasa_thread_pool *pool,
+                 int n_threads)
+{
+    const int n = nb_list->n;
+    int *nn = nb_list->nn, *first = nb_list->first;
+    int n_blocks = n_threads, ret = FREESASA_SUCCESS;
+    double cost = 0, block_cost = 0;
+    struct nb_block *block = malloc(sizeof(struct nb_block)*n_blocks);
+    struct nb_threads t = {.nb_list = nb_list, .c = c, .coord = coord,
+                           .radii = radii, .block = block};
+
+    if (block == NULL) return mem_fail();
+
+    // the number of atom pairs to compare for each cell determines its cost
+    for (int ic = 0; ic < c->n; ++ic) {
+        const cell *ci = &c->cell[ic];
+        for (int jc = 0; jc < ci->n_nb; ++jc)
+            cost += (double)ci->n_atoms * ci->nb[jc]->n_atoms;
+    }
+    for (int b = 0, ic = 0; b < n_blocks; ++b) {
+        const double block_begin = block_cost, block_end = cost*(b+1)/n_blocks;
+        double cell_cost;
+        block[b] = (struct nb_block){.cell_begin = ic, .nn = NULL, .contact = NULL};
+        for (; ic < c->n && (block_cost < block_end || b == n_blocks - 1); ++ic) {
+            const cell *ci = &c->cell[ic];
+            cell_cost = 0;
+            for (int jc = 0; jc < ci->n_nb; ++jc)
+                cell_cost += (double)ci->n_atoms * ci->nb[jc]->n_atoms;
+            block_cost += cell_cost;
+        }
+        block[b].cell_end = ic;
+        // a rough guess that will be adjusted if necessary
+        block[b].capacity = (int)((block_cost - block_begin)/8) + 16;
+    }
+    for (int b = 0; b < n_blocks; ++b) {
+        block[b].nn = malloc(sizeof(int)*n);
+        block[b].contact = malloc(sizeof(struct nb_contact)*block[b].capacity);
+        if (block[b].nn == NULL || block[b].contact == NULL) {
+            ret = mem_fail();
+            goto cleanup;
+        }
+    }
+
+    freesasa_thread_run(pool, n_threads, n_blocks, 1, nb_find_task, &t);
+    for (int b = 0; b < n_blocks; ++b) {
+        if (block[b].fail) {
+            ret = fail_msg("");
+            goto cleanup;
+        }
+    }
+
+    first[0] = 0;
+    for (int i = 0; i < n; ++i) {
+        int pos = first[i];
+        for (int b = 0; b < n_blocks; ++b) {
+            const int nn_b = block[b].nn[i];
+            block[b].nn[i] = pos;
+            pos += nn_b;
+        }
+        nn[i] = pos - first[i];
+        first[i+1] = pos;
+    }
+
+    // malloc(0) is allowed to return NULL
+    nb_list->pair = malloc(sizeof(nb_pair)*(first[n] > 0 ? first[n] : 1));
+    if (nb_list->pair == NULL) {
+        ret = mem_fail();
+        goto cleanup;
+    }
+
+    freesasa_thread_run(pool, n_threads, n_blocks, 1, nb_write_task, &t);
+
+ cleanup:
+    for (int b = 0; b < n_blocks; ++b) {
+        free(block[b].nn);
+        free(block[b].contact);
+    }
+    free(block);
+    return ret;
+}
+
 nb_list*
 freesasa_nb_new(const coord_t *coord,
                 const double *radii)
+{
+    return freesasa_nb_new_threads(coord, radii, NULL, 1);
+}
+
+nb_list*
+freesasa_nb_new_threads(const coord_t *coord,
+                        const double *radii,
+                        freesasa_thread_pool *pool,
+                        int n_threads)
 {
     if (coord == NULL || radii == NULL) return NULL;
     double cell_size;
     cell_list *c;
-    int n = freesasa_coord_n(coord);
+    int n = freesasa_coord_n(coord), ret;
     nb_list *nb = freesasa_nb_alloc(n);
     
     if (!nb) {
@@ -463,8 +794,14 @@ freesasa_nb_new(const coord_t *coord,
     cell_size = 2*max_array(radii,n);
     assert(cell_size > 0);
     c = cell_list_new(cell_size,coord);
-    if (c == NULL ||
-        nb_fill_list(nb,c,coord,radii)) {
+    if (c == NULL) {
+        ret = FREESASA_FAIL;
+    } else if (n_threads > 1) {
+        ret = nb_build_threads(nb,c,coord,radii,pool,n_threads);
+    } else {
+        ret = nb_build(nb,c,coord,radii);
+    }
+    if (ret) {
         mem_fail(); 
         freesasa_nb_free(nb);
         nb = NULL;
@@ -476,6 +813,546 @@ freesasa_nb_new(const coord_t *coord,
     return nb;
 }
 
+//! Spreads the lowest 21 bits of x to every third bit
+static uint64_t
+morton_spread(uint64_t x)
+{
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+    x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2)  & 0x1249249249249249ULL;
+    return x;
+}
+
+struct morton_key {
+    uint64_t key;
+    int index;
+};
+
+//! For qsort(), ties are broken by index to keep the sort stable
+static int
+morton_key_cmp(const void *a,
+               const void *b)
+{
+    const struct morton_key *ka = a, *kb = b;
+    if (ka->key < kb->key) return -1;
+    if (ka->key > kb->key) return 1;
+    return ka->index - kb->index;
+}
+
+int
+freesasa_nb_spatial_order(const coord_t *coord,
+                          double cell_size,
+                          int *order)
+{
+    assert(coord);
+    assert(order);
+    assert(cell_size > 0);
+
+    const int n = freesasa_coord_n(coord);
+    cell_list c = empty_cell_list;
+    struct morton_key *key;
+
+    if (n == 0) return FREESASA_SUCCESS;
+
+    key = malloc(sizeof(struct morton_key)*n);
+    if (key == NULL) return mem_fail();
+
+    c.d = cell_size;
+    cell_list_bounds(&c,coord);
+
+    for (int i = 0; i < n; ++i) {
+        const double *v = freesasa_coord_i(coord,i);
+        uint64_t ix = (uint64_t)((v[0] - c.x_min)/c.d),
+            iy = (uint64_t)((v[1] - c.y_min)/c.d),
+            iz = (uint64_t)((v[2] - c.z_min)/c.d);
+        key[i].key = morton_spread(ix) | morton_spread(iy) << 1 | morton_spread(iz) << 2;
+        key[i].index = i;
+    }
+    qsort(key, n, sizeof(struct morton_key), morton_key_cmp);
+    for (int k = 0; k < n; ++k) order[k] = key[k].index;
+
+    free(key);
+    return FREESASA_SUCCESS;
+}
+
+/* Bits per axis in the keys of the cells of an nb_grid. Cell indices
+   are taken modulo 2^21, so that cells far apart can share a key. This
+   only adds candidates that are rejected by the distance check. */
+#define NB_GRID_BITS 21
+#define NB_GRID_MIN_SLOTS 64
+
+//! A cell of an ::nb_grid, a slot in its hash table
+struct nb_grid_cell {
+    uint64_t key;
+    int *atom; //! indices of the atoms in the cell
+    int n_atoms;
+    int capacity; //! 0 if slot is unused
+};
+
+struct nb_grid {
+    const coord_t *coord;
+    const double *radii;
+    double d; //! cell size
+    int n; //! number of atoms
+    struct nb_grid_cell *cell; //! hash table of cells
+    int bits; //! the table has 2^bits slots
+    int n_cells; //! number of used slots
+    uint64_t *key; //! key of the cell of each atom
+    int *pos; //! position of each atom in the atom array of its cell
+};
+
+//! Cell index along one axis, in NB_GRID_BITS bits
+static inline uint64_t
+nb_grid_index(const nb_grid *g,
+              double x)
+{
+    return (uint64_t)((int64_t)floor(x/g->d) + (1 << (NB_GRID_BITS-1)))
+        & ((1 << NB_GRID_BITS) - 1);
+}
+
+static inline uint64_t
+nb_grid_key(uint64_t ix,
+            uint64_t iy,
+            uint64_t iz)
+{
+    const uint64_t mask = (1 << NB_GRID_BITS) - 1;
+    return (ix & mask) | (iy & mask) << NB_GRID_BITS | (iz & mask) << 2*NB_GRID_BITS;
+}
+
+//! Returns the slot of the cell with the given key, or an unused slot
+static struct nb_grid_cell *
+nb_grid_find(const nb_grid *g,
+             uint64_t key)
+{
+    const unsigned mask = (1u << g->bits) - 1;
+    unsigned h = cell_hash(key, g->bits);
+    while (g->cell[h].capacity && g->cell[h].key != key) h = (h + 1) & mask;
+    return &g->cell[h];
+}
+
+//! Doubles the number of slots of the hash table
+static int
+nb_grid_grow(nb_grid *g)
+{
+    struct nb_grid_cell *old = g->cell;
+    const int n_old = 1 << g->bits;
+    struct nb_grid_cell *cell = calloc((size_t)2*n_old, sizeof(struct nb_grid_cell));
+
+    if (cell == NULL) return mem_fail();
+    g->cell = cell;
+    ++g->bits;
+    for (int s = 0; s < n_old; ++s) {
+        if (old[s].capacity) *nb_grid_find(g, old[s].key) = old[s];
+    }
+    free(old);
+    return FREESASA_SUCCESS;
+}
+
+//! Adds atom i to the cell with the given key
+static int
+nb_grid_insert(nb_grid *g,
+               int i,
+               uint64_t key)
+{
+    struct nb_grid_cell *cell = nb_grid_find(g, key);
+
+    if (cell->capacity == 0) {
+        // keep the table at most half full
+        if (2*(g->n_cells + 1) > (1 << g->bits)) {
+            if (nb_grid_grow(g)) return FREESASA_FAIL;
+            cell = nb_grid_find(g, key);
+        }
+        cell->atom = malloc(sizeof(int)*4);
+        if (cell->atom == NULL) return mem_fail();
+        cell->key = key;
+        cell->n_atoms = 0;
+        cell->capacity = 4;
+        ++g->n_cells;
+    } else if (cell->n_atoms == cell->capacity) {
+        int *atom = realloc(cell->atom, sizeof(int)*2*cell->capacity);
+        if (atom == NULL) return mem_fail();
+        cell->atom = atom;
+        cell->capacity *= 2;
+    }
+    g->key[i] = key;
+    g->pos[i] = cell->n_atoms;
+    cell->atom[cell->n_atoms++] = i;
+    return FREESASA_SUCCESS;
+}
+
+//! Key of the cell that atom i belongs to, given its current coordinates
+static inline uint64_t
+nb_grid_atom_key(const nb_grid *g,
+                 int i)
+{
+    const double *v = freesasa_coord_i(g->coord, i);
+    return nb_grid_key(nb_grid_index(g, v[0]),
+                       nb_grid_index(g, v[1]),
+                       nb_grid_index(g, v[2]));
+}
+
+nb_grid *
+freesasa_nb_grid_new(const coord_t *coord,
+                     const double *radii)
+{
+    assert(coord);
+    assert(radii);
+
+    const int n = freesasa_coord_n(coord);
+    nb_grid *g = malloc(sizeof(nb_grid));
+
+    if (g == NULL) {
+        mem_fail();
+        return NULL;
+    }
+
+    g->coord = coord;
+    g->radii = radii;
+    g->n = n;
+    g->d = 2*max_array(radii, n);
+    g->n_cells = 0;
+    g->bits = 0;
+    while ((1 << g->bits) < NB_GRID_MIN_SLOTS || (1 << g->bits) < n) ++g->bits;
+    g->cell = calloc((size_t)1 << g->bits, sizeof(struct nb_grid_cell));
+    g->key = malloc(sizeof(uint64_t)*n);
+    g->pos = malloc(sizeof(int)*n);
+
+    if (g->cell == NULL || g->key == NULL || g->pos == NULL) {
+        mem_fail();
+        goto fail;
+    }
+    if (g->d <= 0) {
+        fail_msg("radii have to be positive");
+        goto fail;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (nb_grid_insert(g, i, nb_grid_atom_key(g, i)))
+            goto fail;
+    }
+
+    return g;
+
+ fail:
+    freesasa_nb_grid_free(g);
+    return NULL;
+}
+
+void
+freesasa_nb_grid_free(nb_grid *g)
+{
+    if (g != NULL) {
+        if (g->cell) {
+            for (int s = 0; s < (1 << g->bits); ++s) free(g->cell[s].atom);
+        }
+        free(g->cell);
+        free(g->key);
+        free(g->pos);
+        free(g);
+    }
+}
+
+int
+freesasa_nb_grid_move(nb_grid *g,
+                      int i)
+{
+    assert(g);
+    assert(i >= 0 && i < g->n);
+
+    const uint64_t key = nb_grid_atom_key(g, i);
+    struct nb_grid_cell *cell;
+    int last;
+
+    if (key == g->key[i]) return FREESASA_SUCCESS;
+
+    // remove from old cell, by moving the last atom there in its place
+    cell = nb_grid_find(g, g->key[i]);
+    last = cell->atom[--cell->n_atoms];
+    cell->atom[g->pos[i]] = last;
+    g->pos[last] = g->pos[i];
+
+    return nb_grid_insert(g, i, key);
+}
+
+/**
+    Finds the neighbors of atom i in the grid. Returns their number,
+    and if pair is not NULL, writes them to the pair array starting at
+    pair.
+ */
+static int
+nb_grid_neighbors(const nb_grid *g,
+                  nb_pair *pair,
+                  int i)
+{
+    const double * restrict v = freesasa_coord_all(g->coord);
+    const double ri = g->radii[i], xi = v[3*i], yi = v[3*i+1], zi = v[3*i+2];
+    const uint64_t ix = nb_grid_index(g, xi), iy = nb_grid_index(g, yi),
+        iz = nb_grid_index(g, zi);
+    int nn = 0;
+
+    for (uint64_t dz = 0; dz < 3; ++dz) {
+        for (uint64_t dy = 0; dy < 3; ++dy) {
+            for (uint64_t dx = 0; dx < 3; ++dx) {
+                // unsigned wrap-around is masked away in the key
+                const struct nb_grid_cell *cell =
+                    nb_grid_find(g, nb_grid_key(ix+dx-1, iy+dy-1, iz+dz-1));
+                for (int k = 0; k < cell->n_atoms; ++k) {
+                    const int j = cell->atom[k];
+                    const double rj = g->radii[j],
+                        cut2 = (ri+rj)*(ri+rj),
+                        xd = v[3*j]-xi, yd = v[3*j+1]-yi, zd = v[3*j+2]-zi;
+                    if (j == i || xd*xd + yd*yd + zd*zd >= cut2) continue;
+                    if (pair) {
+                        pair[nn].j = j;
+                        pair[nn].xd = xd;
+                        pair[nn].yd = yd;
+                        pair[nn].xyd = sqrt(xd*xd + yd*yd);
+                    }
+                    ++nn;
+                }
+            }
+        }
+    }
+    return nn;
+}
+
+nb_list *
+freesasa_nb_new_subset(const nb_grid *g,
+                       const int *subset,
+                       int n_subset)
+{
+    assert(g);
+    assert(subset || n_subset == 0);
+
+    // sized to the subset, not the grid, so that the cost is local
+    nb_list *nb = freesasa_nb_alloc(n_subset > 0 ? n_subset : 1);
+    int n_pairs = 0;
+
+    if (nb == NULL) return NULL;
+    nb->n = n_subset;
+
+    for (int k = 0; k < n_subset; ++k) {
+        nb->nn[k] = nb_grid_neighbors(g, NULL, subset[k]);
+        nb->first[k] = n_pairs;
+        n_pairs += nb->nn[k];
+    }
+    nb->first[n_subset] = n_pairs;
+
+    nb->pair = malloc(sizeof(nb_pair)*(n_pairs > 0 ? n_pairs : 1));
+    if (nb->pair == NULL) {
+        mem_fail();
+        freesasa_nb_free(nb);
+        return NULL;
+    }
+    for (int k = 0; k < n_subset; ++k) {
+        nb_grid_neighbors(g, nb->pair + nb->first[k], subset[k]);
+    }
+
+    return nb;
+}
+
+/* Added to the skin when the candidates are found, so that rounding
+   errors can't make us miss a contact at the edge of the skin. */
+#define NB_VERLET_MARGIN 1e-6
+
+struct nb_verlet {
+    double skin;
+    int n; //! number of elements when the candidates were found
+    double *ref; //! coordinates when the candidates were found
+    double *radii; //! radii when the candidates were found
+    double *radii_skin; //! radii plus half the skin
+    nb_list *candidates; //! pairs within the cutoff plus the skin
+    nb_list *nb; //! the current contacts
+    int n_builds;
+};
+
+//! Arguments for nb_verlet_filter_task()
+struct nb_verlet_filter {
+    nb_verlet *v;
+    const double *xyz;
+    const double *radii;
+};
+
+nb_verlet *
+freesasa_nb_verlet_new(double skin)
+{
+    assert(skin >= 0);
+
+    nb_verlet *v = malloc(sizeof(nb_verlet));
+    if (v == NULL) {
+        mem_fail();
+        return NULL;
+    }
+    v->skin = skin;
+    v->n = 0;
+    v->ref = v->radii = v->radii_skin = NULL;
+    v->candidates = v->nb = NULL;
+    v->n_builds = 0;
+    return v;
+}
+
+//! Frees everything except the struct itself
+static void
+nb_verlet_clear(nb_verlet *v)
+{
+    free(v->ref);
+    free(v->radii);
+    free(v->radii_skin);
+    freesasa_nb_free(v->candidates);
+    freesasa_nb_free(v->nb);
+    v->ref = v->radii = v->radii_skin = NULL;
+    v->candidates = v->nb = NULL;
+    v->n = 0;
+}
+
+void
+freesasa_nb_verlet_free(nb_verlet *v)
+{
+    if (v) {
+        nb_verlet_clear(v);
+        free(v);
+    }
+}
+
+int
+freesasa_nb_verlet_n_builds(const nb_verlet *v)
+{
+    assert(v);
+    return v->n_builds;
+}
+
+/**
+    Checks if the candidates have to be found again, i.e. if the
+    number of elements or their radii have changed, or if any element
+    has moved more than half the skin.
+ */
+static int
+nb_verlet_outdated(const nb_verlet *v,
+                   const double *xyz,
+                   const double *radii,
+                   int n)
+{
+    const double max2 = 0.25*v->skin*v->skin;
+
+    if (v->candidates == NULL || v->n != n) return 1;
+    for (int i = 0; i < n; ++i) {
+        const double dx = xyz[3*i] - v->ref[3*i],
+            dy = xyz[3*i+1] - v->ref[3*i+1],
+            dz = xyz[3*i+2] - v->ref[3*i+2];
+        if (radii[i] != v->radii[i] || dx*dx + dy*dy + dz*dz > max2)
+            return 1;
+    }
+    return 0;
+}
+
+//! Finds the candidates for the coordinates, freeing the old ones
+static int
+nb_verlet_build(nb_verlet *v,
+                const coord_t *coord,
+                const double *radii,
+                freesasa_thread_pool *pool,
+                int n_threads)
+{
+    const int n = freesasa_coord_n(coord);
+
+    nb_verlet_clear(v);
+    v->ref = malloc(sizeof(double)*3*n);
+    v->radii = malloc(sizeof(double)*n);
+    v->radii_skin = malloc(sizeof(double)*n);
+    if (!v->ref || !v->radii || !v->radii_skin) goto fail;
+
+    memcpy(v->ref, freesasa_coord_all(coord), sizeof(double)*3*n);
+    for (int i = 0; i < n; ++i) {
+        v->radii[i] = radii[i];
+        v->radii_skin[i] = radii[i] + 0.5*v->skin + NB_VERLET_MARGIN;
+    }
+
+    v->candidates = freesasa_nb_new_threads(coord, v->radii_skin, pool, n_threads);
+    if (v->candidates == NULL) goto fail;
+
+    // the contacts are a subset of the candidates, same layout
+    v->nb = freesasa_nb_alloc(n);
+    if (v->nb == NULL) goto fail;
+    v->nb->pair = malloc(sizeof(nb_pair)*(v->candidates->first[n] > 0 ?
+                                          v->candidates->first[n] : 1));
+    if (v->nb->pair == NULL) goto fail;
+    for (int i = 0; i <= n; ++i) v->nb->first[i] = v->candidates->first[i];
+
+    v->n = n;
+    ++v->n_builds;
+    return FREESASA_SUCCESS;
+
+ fail:
+    nb_verlet_clear(v);
+    return mem_fail();
+}
+
+/**
+    Selects the candidates of the elements [begin,end) that are in
+    contact with the current coordinates, see freesasa_thread_run().
+    The pairs are computed in the same way as in the full list.
+ */
+static void
+nb_verlet_filter_task(int begin,
+                      int end,
+                      int thread,
+                      void *arg)
+{
+    const struct nb_verlet_filter *f = arg;
+    const nb_list *cand = f->v->candidates;
+    nb_list *nb = f->v->nb;
+    const double * restrict v = f->xyz;
+    (void)thread;
+
+    for (int i = begin; i < end; ++i) {
+        const nb_pair *ci = cand->pair + cand->first[i];
+        nb_pair *pi = nb->pair + nb->first[i];
+        const double ri = f->radii[i], xi = v[3*i], yi = v[3*i+1], zi = v[3*i+2];
+        int nn = 0;
+        for (int k = 0; k < cand->nn[i]; ++k) {
+            const int j = ci[k].j;
+            const double rj = f->radii[j], cut2 = (ri+rj)*(ri+rj),
+                dx = v[3*j]-xi, dy = v[3*j+1]-yi, dz = v[3*j+2]-zi;
+            if (dx*dx + dy*dy + dz*dz < cut2) {
+                pi[nn].j = j;
+                pi[nn].xd = dx;
+                pi[nn].yd = dy;
+                pi[nn].xyd = sqrt(dx*dx + dy*dy);
+                ++nn;
+            }
+        }
+        nb->nn[i] = nn;
+    }
+}
+
+const nb_list *
+freesasa_nb_verlet_update(nb_verlet *v,
+                          const coord_t *coord,
+                          const double *radii,
+                          freesasa_thread_pool *pool,
+                          int n_threads)
+{
+    assert(v);
+    assert(coord);
+    assert(radii);
+
+    const int n = freesasa_coord_n(coord);
+    struct nb_verlet_filter f = {v, freesasa_coord_all(coord), radii};
+
+    if (nb_verlet_outdated(v, f.xyz, radii, n) &&
+        nb_verlet_build(v, coord, radii, pool, n_threads)) {
+        fail_msg("");
+        return NULL;
+    }
+
+    freesasa_thread_run(pool, n_threads, n, FREESASA_DEF_THREAD_CHUNK,
+                        nb_verlet_filter_task, &f);
+    return v->nb;
+}
+
 int 
 freesasa_nb_contact(const nb_list *nb,
                     int i,
@@ -484,8 +1361,9 @@ freesasa_nb_contact(const nb_list *nb,
     assert(nb != NULL);
     assert(i < nb->n && i >= 0);
     assert(j < nb->n && j >= 0);
+    const nb_pair *pi = nb->pair + nb->first[i];
     for (int k = 0; k < nb->nn[i]; ++k) {
-        if (nb->nb[i][k] == j) return 1;
+        if (pi[k].j == j) return 1;
     }
     return 0;
 }
@@ -3,6 +3,7 @@
 
 #include <stdlib.h>
 #include "coord.h"
+#include "freesasa.h"
 /**
    @file
    @author Simon Mitternacht
@@ -13,15 +14,25 @@
    demonstrated in sasa_lr.c and sasa_sr.c).
  */
 
-//! Neighbor list
+//! A neighbor of an element, and their separation
+typedef struct {
+    double xyd; //!< distance between neighbors in xy-plane
+    double xd; //!< signed distance between neighbors along x-axis
+    double yd; //!< signed distance between neighbors along y-axis
+    int j; //!< index of the neighbor
+} nb_pair;
+
+/**
+    Neighbor list, stored in compressed sparse row format: the
+    neighbors of element i are pair[first[i]], ...,
+    pair[first[i]+nn[i]-1], the pairs of all elements are stored in
+    one contiguous array.
+ */
 typedef struct {
     int n; //!< number of elements
-    int **nb; //!< neighbors to each element
     int *nn; //!< number of neighbors to each element
-    double **xyd; //!< distance between neighbors in xy-plane
-    double **xd; //!< signed distance between neighbors along x-axis
-    double **yd; //!< signed distance between neighbors along y-axis
-    int *capacity; //!< keeps track of memory chunks (don't change this)
+    int *first; //!< index of first neighbor of each element in pair (n+1 elements)
+    nb_pair *pair; //!< the neighbors of all elements
 } nb_list;
 
 /**
@@ -43,6 +54,24 @@ nb_list *
 freesasa_nb_new(const coord_t *coord,
                 const double *radii);
 
+/**
+    Creates a neighbor list like freesasa_nb_new(), but using several
+    threads. Gives the same list.
+
+    @param coord a set of coordinates
+    @param radii radii for the coordinates
+    @param pool If not NULL, the threads are taken from this pool.
+    @param n_threads Number of threads (at most the size of the pool,
+      if one is given).
+    @return a neigbor list. NULL if either of coord or radii is NULL, or
+      if memory allocation fails.
+ */
+nb_list *
+freesasa_nb_new_threads(const coord_t *coord,
+                        const double *radii,
+                        freesasa_thread_pool *pool,
+                        int n_threads);
+
 /**
     Frees a neigbor list created by freesasa_nb_new().
 
@@ -51,6 +80,157 @@ freesasa_nb_new(const coord_t *coord,
 void
 freesasa_nb_free(nb_list *nb);
 
+/**
+    Orders the coordinates along a Morton (Z-order) curve through the
+    cells of the same kind of grid as freesasa_nb_new() uses, so that
+    coordinates that are close in space mostly end up close in the
+    order. The coordinates in each cell keep their relative order.
+
+    @param coord The coordinates.
+    @param cell_size Size of the cells (freesasa_nb_new() uses twice
+      the largest radius).
+    @param order Array with one element per coordinate, order[k] is set
+      to the index of the k-th coordinate along the curve.
+    @return ::FREESASA_SUCCESS, or ::FREESASA_FAIL if memory allocation
+      fails.
+ */
+int
+freesasa_nb_spatial_order(const coord_t *coord,
+                          double cell_size,
+                          int *order);
+
+/**
+    A grid of cells for coordinates that can move, which is used to
+    find the neighbors of a few elements at a time (instead of all
+    pairs at once, like freesasa_nb_new()). Only occupied cells are
+    stored, in a hash table.
+ */
+typedef struct nb_grid nb_grid;
+
+/**
+    Creates a grid for a set of coordinates with corresponding sphere
+    radii.
+
+    The grid keeps pointers to the coordinates and radii, which hence
+    have to be kept alive as long as the grid is used. When
+    coordinates are changed freesasa_nb_grid_move() has to be called
+    for each of them.
+
+    @param coord The coordinates.
+    @param radii Radii for the coordinates (all positive).
+    @return The grid, should be freed with freesasa_nb_grid_free(). NULL
+      if memory allocation fails.
+ */
+nb_grid *
+freesasa_nb_grid_new(const coord_t *coord,
+                     const double *radii);
+
+/**
+    Frees a grid.
+
+    @param grid The grid.
+ */
+void
+freesasa_nb_grid_free(nb_grid *grid);
+
+/**
+    Updates the cell of an element after its coordinates have been
+    changed.
+
+    @param grid The grid.
+    @param i Index of the element.
+    @return ::FREESASA_SUCCESS, or ::FREESASA_FAIL if memory allocation
+      fails (the grid is then no longer consistent).
+ */
+int
+freesasa_nb_grid_move(nb_grid *grid,
+                      int i);
+
+/**
+    Creates a neighbor list for the elements in a subset. The list
+    has one row per element of the subset, row k holds the neighbors
+    of element subset[k], with the same pairs as freesasa_nb_new()
+    would give, but maybe in a different order. The indices of the
+    neighbors (nb_pair::j) refer to the whole grid. The cost depends
+    on the size of the subset and its neighborhood, not on the number
+    of elements in the grid.
+
+    @param grid A grid.
+    @param subset Indices of the elements, without duplicates.
+    @param n_subset Number of elements in the subset.
+    @return The list, should be freed with freesasa_nb_free(). NULL if
+      memory allocation fails.
+ */
+nb_list *
+freesasa_nb_new_subset(const nb_grid *grid,
+                       const int *subset,
+                       int n_subset);
+
+/**
+    A Verlet list: neighbor lists for a sequence of similar
+    coordinates (the frames of a trajectory, for example), where the
+    candidate pairs are found with a cell list like in
+    freesasa_nb_new(), but with the cutoff extended by a skin
+    distance. As long as no element has moved more than half the skin
+    since the candidates were found, all contacts are among the
+    candidates, and the list of each new set of coordinates is
+    obtained by checking only the candidates.
+ */
+typedef struct nb_verlet nb_verlet;
+
+/**
+    Creates a Verlet list.
+
+    @param skin The skin distance, has to be >= 0 (0 means the
+      candidates are found for each new set of coordinates).
+    @return The list, should be freed with freesasa_nb_verlet_free(),
+      NULL if memory allocation fails.
+ */
+nb_verlet *
+freesasa_nb_verlet_new(double skin);
+
+/**
+    Frees a Verlet list.
+
+    @param verlet The list.
+ */
+void
+freesasa_nb_verlet_free(nb_verlet *verlet);
+
+/**
+    Updates the neighbor list for a new set of coordinates.
+
+    The candidates are found again if any coordinate has moved more
+    than half the skin, if the radii or number of coordinates have
+    changed, or on the first call. The resulting list has the same
+    pairs as the one from freesasa_nb_new(), but possibly in another
+    order.
+
+    @param verlet The list.
+    @param coord The coordinates.
+    @param radii Radii for the coordinates.
+    @param pool If not NULL, threads are taken from this pool.
+    @param n_threads Number of threads to use.
+    @return The neighbor list, owned by the Verlet list and valid
+      until the next call. NULL if memory allocation fails.
+ */
+const nb_list *
+freesasa_nb_verlet_update(nb_verlet *verlet,
+                          const coord_t *coord,
+                          const double *radii,
+                          freesasa_thread_pool *pool,
+                          int n_threads);
+
+/**
+    Number of times the candidates have been found since the Verlet
+    list was created.
+
+    @param verlet The list.
+    @return The number.
+ */
+int
+freesasa_nb_verlet_n_builds(const nb_verlet *verlet);
+
 /**
     Checks if two atoms are in contact. Only included for reference.
 
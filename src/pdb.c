@@ -1,7 +1,18 @@
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#if HAVE_MMAP
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+#if USE_ZLIB
+# include <zlib.h>
+#endif
 #include "freesasa_internal.h"
 #include "pdb.h"
 
@@ -40,108 +51,278 @@ pdb_get_double(const char *line, int width, double *val)
     return FREESASA_FAIL;
 }
 
-int
-freesasa_pdb_get_models(FILE* pdb,
-                        struct file_range** ranges)
+#if USE_ZLIB
+#define PDB_GZ_CHUNK 65536 //!< Size of the buffer for compressed data
+
+//! The decompression of gzip-compressed input
+struct pdb_gz {
+    z_stream z;
+    unsigned char in[PDB_GZ_CHUNK]; //!< Compressed data read from the file
+    int member_done; //!< A gzip member has been decompressed completely
+    int eof; //!< All input has been decompressed
+};
+
+static int
+pdb_gz_open(struct pdb_reader *r)
+{
+    struct pdb_gz *gz = malloc(sizeof(struct pdb_gz));
+
+    if (gz == NULL) return mem_fail();
+    gz->z.zalloc = Z_NULL;
+    gz->z.zfree = Z_NULL;
+    gz->z.opaque = Z_NULL;
+    gz->z.next_in = Z_NULL;
+    gz->z.avail_in = 0;
+    gz->member_done = 0;
+    gz->eof = 0;
+    if (inflateInit2(&gz->z, 16 + MAX_WBITS) != Z_OK) {
+        free(gz);
+        return mem_fail();
+    }
+    r->gz = gz;
+
+    r->line_size = PDB_GZ_CHUNK;
+    r->line = malloc(r->line_size);
+    if (r->line == NULL) {
+        freesasa_pdb_reader_close(r);
+        return mem_fail();
+    }
+    r->buf_begin = r->buf_end = 0;
+
+    return FREESASA_SUCCESS;
+}
+
+/**
+    Decompresses data to the end of the line buffer, until it's full
+    or the input ends. The input can consist of several concatenated
+    gzip members, anything after the last complete member is ignored.
+ */
+static int
+pdb_gz_inflate(struct pdb_reader *r)
 {
-    assert(pdb != NULL);
-    size_t len = PDB_LINE_STRL;
-    char *line = NULL;
-    int n = 0, n_end = 0, error = 0;
-    long last_pos = ftell(pdb);
-    struct file_range *it = NULL, *itb;
-
-    while (getline(&line, &len, pdb) != -1) {
-        if (strncmp("MODEL",line,5)==0) {
-            ++n;
-            itb = it;
-            it = realloc(it, sizeof(struct file_range)*n);
-            if (!it) {
-                free(itb);
-                error = mem_fail();
+    struct pdb_gz *gz = r->gz;
+    z_stream *z = &gz->z;
+    int ret;
+
+    z->next_out = (unsigned char*)r->line + r->buf_end;
+    z->avail_out = r->line_size - r->buf_end - 1; // room for a null character
+
+    while (z->avail_out > 0 && !gz->eof) {
+        if (z->avail_in == 0) {
+            z->next_in = gz->in;
+            z->avail_in = fread(gz->in, 1, PDB_GZ_CHUNK, r->file);
+            if (z->avail_in == 0) {
+                if (!gz->member_done)
+                    return freesasa_fail("in %s(): compressed input is truncated.",
+                                         __func__);
+                gz->eof = 1;
                 break;
             }
-            it[n-1].begin = last_pos;
         }
-        if (strncmp("ENDMDL",line,6)==0) {
-            ++n_end;
-            if (n != n_end) {
-                error = freesasa_fail("in %s(): Mismatch between MODEL and ENDMDL "
-                                      "in input\n",__func__);
-                break;
-            }
-            it[n-1].end = ftell(pdb);
+        ret = inflate(z, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            gz->member_done = 1;
+            if (inflateReset(z) != Z_OK) return mem_fail();
+        } else if (ret == Z_OK) {
+            gz->member_done = 0;
+        } else if (ret == Z_DATA_ERROR && gz->member_done) {
+            gz->eof = 1; // trailing garbage
+        } else if (ret == Z_MEM_ERROR) {
+            return mem_fail();
+        } else {
+            return freesasa_fail("in %s(): can't decompress input: %s.",
+                                 __func__, z->msg ? z->msg : "unknown error");
         }
-        last_pos = ftell(pdb);
     }
-    free(line);
-    if (n == 0) { // when there are no models, the whole file is the model
-        free(it);
-        it = NULL;
-    }
-    if (error == FREESASA_FAIL) {
-        free(it);
-        *ranges = NULL;
-        return FREESASA_FAIL;
+    r->buf_end = (char*)z->next_out - r->line;
+
+    return FREESASA_SUCCESS;
+}
+
+static const char *
+pdb_gz_next(struct pdb_reader *r,
+            size_t *len)
+{
+    struct pdb_gz *gz = r->gz;
+    const char *line, *nl;
+    char *buf;
+
+    for (;;) {
+        line = r->line + r->buf_begin;
+        nl = memchr(line, '\n', r->buf_end - r->buf_begin);
+        if (nl != NULL) {
+            *len = nl + 1 - line;
+            r->buf_begin += *len;
+            return line;
+        }
+        if (gz->eof) {
+            if (r->buf_begin == r->buf_end) return NULL;
+            // a last line without newline, there is room for the null character
+            *len = r->buf_end - r->buf_begin;
+            r->line[r->buf_end] = '\0';
+            r->buf_begin = r->buf_end;
+            return line;
+        }
+
+        // move the beginning of the line to the front of the buffer,
+        // and grow it if the line doesn't fit
+        memmove(r->line, line, r->buf_end - r->buf_begin);
+        r->buf_end -= r->buf_begin;
+        r->buf_begin = 0;
+        if (r->buf_end + 1 == r->line_size) {
+            buf = realloc(r->line, 2*r->line_size);
+            if (buf == NULL) {
+                r->error = mem_fail();
+                return NULL;
+            }
+            r->line = buf;
+            r->line_size *= 2;
+        }
+        if (pdb_gz_inflate(r)) {
+            r->error = FREESASA_FAIL;
+            return NULL;
+        }
     }
-    *ranges = it;
-    return n;
 }
+#endif /* USE_ZLIB */
 
 int
-freesasa_pdb_get_chains(FILE *pdb,
-                        struct file_range model,
-                        struct file_range **ranges,
-                        int options)
+freesasa_pdb_reader_open(struct pdb_reader *r,
+                         FILE *pdb)
 {
+    assert(r);
     assert(pdb);
-    assert(ranges);
-    // it is assumed that 'model' is valid for 'pdb'
-
-    int n_chains = 0;
-    size_t len = PDB_LINE_STRL;
-    char *line = NULL;
-    struct file_range *chains = NULL, *chb;
-    char last_chain = '\0';
-    long last_pos = model.begin;
-    *ranges = NULL;
-
-    // for each model, find file ranges for each chain, store them
-    // in the dynamically growing array chains
-    fseek(pdb,model.begin,SEEK_SET);
-    while (getline(&line, &len, pdb) != -1 &&
-           ftell(pdb) < model.end ) {
-        if (strncmp("ATOM",line,4)==0 || ( (options & FREESASA_INCLUDE_HETATM) &&
-                                           (strncmp("HETATM",line,6) == 0) ) ) {
-            char chain = freesasa_pdb_get_chain_label(line);
-            if (chain != last_chain) {
-                if (n_chains > 0) chains[n_chains-1].end = last_pos;
-                ++n_chains;
-                chb = chains;
-                chains = realloc(chains,sizeof(struct file_range)*n_chains);
-                if (!chains) {
-                    free(chb);
-                    free(line);
-                    return mem_fail();
-                }
-                chains[n_chains-1].begin = last_pos;
-                last_chain = chain;
-            }
+    int c;
+
+    r->file = pdb;
+    r->pos = r->end = NULL;
+    r->map = NULL;
+    r->map_size = 0;
+    r->line = NULL;
+    r->line_size = 0;
+    r->gz = NULL;
+    r->buf_begin = r->buf_end = 0;
+    r->error = 0;
+
+    // text files don't start with the first byte of the gzip header
+    c = getc(pdb);
+    if (c != EOF) ungetc(c, pdb);
+    if (c == 0x1f) {
+#if USE_ZLIB
+        return pdb_gz_open(r);
+#else
+        return freesasa_fail("in %s(): input seems to be compressed, "
+                             "FreeSASA has been built without zlib.", __func__);
+#endif
+    }
+
+    r->offset = ftell(pdb);
+
+#if HAVE_MMAP
+    struct stat st;
+    long size, begin;
+    const char *last;
+    void *map;
+
+    if (r->offset < 0 || fstat(fileno(pdb), &st) != 0 || !S_ISREG(st.st_mode))
+        return FREESASA_SUCCESS; // read line by line
+    size = st.st_size;
+    if (size <= r->offset) {
+        r->pos = r->end = "";
+        return FREESASA_SUCCESS;
+    }
+
+    // the offset of a mapping has to be a multiple of the page size
+    begin = r->offset - r->offset % sysconf(_SC_PAGESIZE);
+    map = mmap(NULL, size - begin, PROT_READ, MAP_PRIVATE, fileno(pdb), begin);
+    if (map == MAP_FAILED) return FREESASA_SUCCESS;
+#ifdef MADV_SEQUENTIAL
+    madvise(map, size - begin, MADV_SEQUENTIAL);
+#endif
+    r->map = map;
+    r->map_size = size - begin;
+    r->pos = (const char*)map + (r->offset - begin);
+    r->end = (const char*)map + r->map_size;
+    r->offset = begin;
+
+    // a last line without newline is copied, to terminate it
+    for (last = r->end; last > r->pos && last[-1] != '\n'; --last) ;
+    if (last < r->end) {
+        r->line_size = r->end - last;
+        r->line = malloc(r->line_size + 1);
+        if (r->line == NULL) {
+            freesasa_pdb_reader_close(r);
+            return mem_fail();
         }
-        last_pos = ftell(pdb);
+        memcpy(r->line, last, r->line_size);
+        r->line[r->line_size] = '\0';
     }
-    free(line);
+    r->end = last;
+#endif
 
-    if (n_chains > 0) {
-        chains[n_chains-1].end = last_pos;
-        chains[0].begin = model.begin; //preserve model info
-        *ranges = chains;
-    } else {
-        *ranges = NULL;
+    return FREESASA_SUCCESS;
+}
+
+const char *
+freesasa_pdb_reader_next(struct pdb_reader *r,
+                         size_t *len)
+{
+    assert(r);
+    assert(len);
+    const char *line;
+    ssize_t n;
+
+#if USE_ZLIB
+    if (r->gz) return pdb_gz_next(r, len);
+#endif
+
+    if (r->pos) {
+        if (r->pos < r->end) {
+            line = r->pos;
+            r->pos = (const char*)memchr(line, '\n', r->end - line) + 1;
+            *len = r->pos - line;
+            return line;
+        }
+        if (r->line_size > 0 && r->pos == r->end) {
+            // the copied last line
+            ++r->pos;
+            *len = r->line_size;
+            return r->line;
+        }
+        return NULL;
     }
-    return n_chains;
+
+    n = getline(&r->line, &r->line_size, r->file);
+    if (n == -1) return NULL;
+    *len = n;
+    return r->line;
 }
 
+void
+freesasa_pdb_reader_close(struct pdb_reader *r)
+{
+    assert(r);
+#if HAVE_MMAP
+    if (r->map) {
+        long pos = r->pos > r->end ? r->offset + (long)r->map_size :
+            r->offset + (r->pos - (const char*)r->map);
+        munmap(r->map, r->map_size);
+        fseek(r->file, pos, SEEK_SET);
+    }
+#endif
+#if USE_ZLIB
+    if (r->gz) {
+        inflateEnd(&((struct pdb_gz*)r->gz)->z);
+        free(r->gz);
+    }
+#endif
+    free(r->line);
+    r->pos = r->end = NULL;
+    r->map = NULL;
+    r->line = NULL;
+    r->line_size = 0;
+    r->gz = NULL;
+}
 
 int
 freesasa_pdb_get_atom_name(char *name,
@@ -265,3 +446,139 @@ freesasa_pdb_ishydrogen(const char* line)
     if (line[12] == 'D' || line[13] == 'D') return 1;
     return 0;
 }
+
+int
+freesasa_pdb_is_atom_line(const char *line,
+                          size_t len,
+                          int hetatm)
+{
+    assert(line);
+    return (len >= 4 && memcmp(line, "ATOM", 4) == 0) ||
+        (hetatm && len >= 6 && memcmp(line, "HETATM", 6) == 0);
+}
+
+//! Length of a line without the newline (and carriage return)
+static inline size_t
+pdb_content_len(const char *line,
+                size_t len)
+{
+    while (len > 0 && (line[len-1] == '\n' || line[len-1] == '\r' ||
+                       line[len-1] == '\0'))
+        --len;
+    return len;
+}
+
+/**
+    Parses a right-justified number with at most 8 characters, like
+    the coordinates in fixed columns. Other formats (exponents,
+    trailing spaces, etc) are left to the caller. The result is the
+    same as with strtod(), as long as the digits and the scale are
+    exact doubles the division is correctly rounded.
+ */
+static inline int
+pdb_parse_coord(const char *field,
+                double *val)
+{
+    static const double scale[] = {1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8};
+    int i = 0, neg = 0, n_digits = 0, n_dec = -1;
+    long m = 0;
+
+    while (i < 8 && field[i] == ' ') ++i;
+    if (i < 8 && (field[i] == '-' || field[i] == '+')) neg = field[i++] == '-';
+    for (; i < 8; ++i) {
+        const char c = field[i];
+        if (c >= '0' && c <= '9') {
+            m = 10*m + (c - '0');
+            ++n_digits;
+            if (n_dec >= 0) ++n_dec;
+        } else if (c == '.' && n_dec < 0) {
+            n_dec = 0;
+        } else {
+            return FREESASA_FAIL;
+        }
+    }
+    if (n_digits == 0) return FREESASA_FAIL;
+    *val = n_dec > 0 ? m / scale[n_dec] : m;
+    if (neg) *val = -*val;
+    return FREESASA_SUCCESS;
+}
+
+int
+freesasa_pdb_parse_atom(struct pdb_atom *atom,
+                        const char *line,
+                        size_t len)
+{
+    assert(atom);
+    assert(line);
+    const size_t clen = pdb_content_len(line, len);
+
+    if (!freesasa_pdb_is_atom_line(line, len, 1) || clen < 54)
+        return FREESASA_FAIL;
+
+    memcpy(atom->name, line+12, PDB_ATOM_NAME_STRL);
+    atom->name[PDB_ATOM_NAME_STRL] = '\0';
+    memcpy(atom->res_name, line+17, PDB_ATOM_RES_NAME_STRL);
+    atom->res_name[PDB_ATOM_RES_NAME_STRL] = '\0';
+    memcpy(atom->res_number, line+22, PDB_ATOM_RES_NUMBER_STRL);
+    atom->res_number[PDB_ATOM_RES_NUMBER_STRL] = '\0';
+    atom->alt_label = line[16];
+    atom->chain_label = line[21];
+    if (clen >= 76 + PDB_ATOM_SYMBOL_STRL) {
+        memcpy(atom->symbol, line+76, PDB_ATOM_SYMBOL_STRL);
+        atom->symbol[PDB_ATOM_SYMBOL_STRL] = '\0';
+    } else {
+        atom->symbol[0] = '\0';
+    }
+
+    // fall back on free format for coordinates that don't fit the columns
+    if (pdb_parse_coord(line+30, &atom->xyz[0]) ||
+        pdb_parse_coord(line+38, &atom->xyz[1]) ||
+        pdb_parse_coord(line+46, &atom->xyz[2])) {
+        char buf[clen-29];
+        memcpy(buf, line+30, clen-30);
+        buf[clen-30] = '\0';
+        if (sscanf(buf, "%lf%lf%lf", &atom->xyz[0], &atom->xyz[1], &atom->xyz[2]) != 3) {
+            return freesasa_fail("Could not read coordinates from line '%.*s'",
+                                 (int)clen, line);
+        }
+    }
+
+    return FREESASA_SUCCESS;
+}
+
+int
+freesasa_pdb_parse_model(int *model,
+                         const char *line,
+                         size_t len)
+{
+    assert(model);
+    assert(line);
+    const size_t clen = pdb_content_len(line, len);
+    char buf[16];
+
+    if (clen <= 10 || strncmp("MODEL", line, 5) != 0) return FREESASA_FAIL;
+    len = clen - 10 < sizeof(buf) - 1 ? clen - 10 : sizeof(buf) - 1;
+    memcpy(buf, line+10, len);
+    buf[len] = '\0';
+    if (sscanf(buf, "%d", model) != 1) return FREESASA_FAIL;
+    return FREESASA_SUCCESS;
+}
+
+int
+freesasa_pdb_parse_occupancy(double *occ,
+                             const char *line,
+                             size_t len)
+{
+    assert(occ);
+    assert(line);
+    const size_t clen = pdb_content_len(line, len);
+    char buf[7];
+
+    // allow truncated lines
+    if (!freesasa_pdb_is_atom_line(line, len, 1) || clen < 55)
+        return FREESASA_FAIL;
+    len = clen - 54 < 6 ? clen - 54 : 6;
+    memcpy(buf, line+54, len);
+    buf[len] = '\0';
+    return pdb_get_double(buf, len, occ);
+}
@@ -22,38 +22,144 @@
 #define PDB_LINE_STRL 80 //!< Length of a line in PDB file.
 
 /**
-    Finds the location of all MODEL entries in the file pdb, returns
-    the number of models found. 
+    Reads the lines of a PDB file without copying them.
 
-    The array *ranges will be dynamically allocated to contain a
-    file ranges for each model.
+    Regular files are mapped to memory, and the lines are returned as
+    pointers into the mapping. Other input, such as pipes, or files on
+    systems without mmap(), is read line by line into a buffer
+    instead. Gzip-compressed input is recognized automatically, and
+    decompressed as it is read (if FreeSASA is built with zlib).
 
-    @return Returns 0 if no MODEL lines were found (for example an
-      X-ray structure with only one model) and sets *ranges to
-      NULL. A return value of 0 doesn't have to mean the file is
-      empty. ::FREESASA_FAIL if malloc-failure.
+    The lines are not null-terminated, but they always end with a
+    newline, or with a null character at the end of the input, so
+    that functions like strncmp(), that stop at the first differing
+    character, can be used safely. strlen() and sscanf() can not.
+ */
+struct pdb_reader {
+    FILE *file; //!< The file being read
+    const char *pos; //!< Next line in the mapping
+    const char *end; //!< End of the mapped range
+    void *map; //!< The mapping, NULL if reading line by line
+    size_t map_size; //!< Size of the mapping
+    long offset; //!< File position of the beginning of the mapping
+    char *line; //!< Line buffer
+    size_t line_size; //!< Size of the line buffer
+    void *gz; //!< Decompression state, NULL if the input isn't compressed
+    size_t buf_begin; //!< Beginning of the next line in the buffer, for compressed input
+    size_t buf_end; //!< End of the decompressed data in the buffer
+    int error; //!< Set if the input couldn't be read
+};
+
+/**
+    Prepares to read lines from the current position of a file, to
+    the end of the file.
+
+    @param reader The reader to initialize.
+    @param pdb The file, has to stay open until the reader is closed.
+    @return ::FREESASA_SUCCESS. ::FREESASA_FAIL if malloc fails, or if
+      the input is compressed and FreeSASA is built without zlib.
+ */
+int
+freesasa_pdb_reader_open(struct pdb_reader *reader,
+                         FILE *pdb);
+
+/**
+    Get the next line.
+
+    @param reader The reader.
+    @param len The length of the line, including the newline, is
+      stored here.
+    @return The line, or NULL at the end of the input. Also returns
+      NULL if the input can't be read (i.e. corrupt compressed input),
+      then the error flag of the reader is set.
+ */
+const char *
+freesasa_pdb_reader_next(struct pdb_reader *reader,
+                         size_t *len);
+
+/**
+    Frees the resources of the reader, and positions the file after
+    the last line that was read. For compressed input the position is
+    undefined.
+
+    @param reader The reader.
+ */
+void
+freesasa_pdb_reader_close(struct pdb_reader *reader);
+
+/**
+    The fields of an `ATOM` or `HETATM` line, as strings with the same
+    padding as in the file.
+ */
+struct pdb_atom {
+    char name[PDB_ATOM_NAME_STRL+1]; //!< Atom name
+    char res_name[PDB_ATOM_RES_NAME_STRL+1]; //!< Residue name
+    char res_number[PDB_ATOM_RES_NUMBER_STRL+1]; //!< Residue number
+    char symbol[PDB_ATOM_SYMBOL_STRL+1]; //!< Element symbol, empty string if missing
+    char chain_label; //!< Chain label
+    char alt_label; //!< Alternate location label
+    double xyz[3]; //!< Coordinates
+};
+
+/**
+    Checks if a line from a ::pdb_reader starts with `ATOM` or, if
+    HETATM is non-zero, `HETATM`.
+
+    @param line The line.
+    @param len Length of the line.
+    @param hetatm Also accept `HETATM`.
+    @return 1 if it does, 0 else.
+ */
+int
+freesasa_pdb_is_atom_line(const char *line,
+                          size_t len,
+                          int hetatm);
+
+/**
+    Parses the fixed columns of an `ATOM` or `HETATM` line from a
+    ::pdb_reader in one pass.
+
+    @param atom The fields are stored here.
+    @param line The line.
+    @param len Length of the line.
+    @return ::FREESASA_SUCCESS if the line contains at least the
+      coordinates. ::FREESASA_FAIL if it is not an `ATOM` or `HETATM`
+      line, if it is too short or the coordinates can't be read.
+ */
+int
+freesasa_pdb_parse_atom(struct pdb_atom *atom,
+                        const char *line,
+                        size_t len);
+
+/**
+    Get the model number from a `MODEL` line from a ::pdb_reader.
+
+    @param model The model number is written here, unchanged if the
+      line doesn't contain one.
+    @param line The line.
+    @param len Length of the line.
+    @return ::FREESASA_SUCCESS if the line is a `MODEL` line with a
+      number, ::FREESASA_FAIL else.
  */
 int
-freesasa_pdb_get_models(FILE* pdb,
-                        struct file_range** ranges);
+freesasa_pdb_parse_model(int *model,
+                         const char *line,
+                         size_t len);
 
 /**
-    Finds the location of all chains within the file range 'model'.
+    Get occupancy from a line from a ::pdb_reader.
 
-    @param pdb The pdb-file
-    @param model The ::file_range to search for chains within.
-    @param ranges The address to a dynamically allocated array
-      containing the ::file_range of each chain will be stored here.
-    @param options Bitfield, can be used to set
-      ::FREESASA_INCLUDE_HETATM.
-    @return Number of chains found. Returns ::FREESASA_FAIL if memory
-      allocation fails.
+    @param occ The occupancy will be written to this location.
+    @param line The line.
+    @param len Length of the line.
+    @return ::FREESASA_SUCCESS if line is long enough and characters
+      55-60 contain a number.
  */
 int
-freesasa_pdb_get_chains(FILE *pdb,
-                        struct file_range model,
-                        struct file_range **ranges,
-                        int options);
+freesasa_pdb_parse_occupancy(double *occ,
+                             const char *line,
+                             size_t len);
+
 /**
     Get atom name from a PDB line.
     
@@ -13,6 +13,7 @@
 
 struct rsa_config {
     const freesasa_classifier *polar_classifier, *bb_classifier;
+    int *polar_class, *bb_class; // the class of each atom
     const freesasa_result *result;
     const freesasa_structure *structure;
     const freesasa_residue_sasa *sasa_ref;
@@ -84,10 +85,8 @@ const freesasa_rsa_reference freesasa_naccess_rsa = {
 };
 
 /**
-   Adds v to members of rs depending on how the atom specified by resn
-   and atom_name is classified. If the classifiers are null the
-   functions rsa_atom_is_backbone() and rs_atom_is_polar() are used
-   instead.
+   Adds the SASA of atom i_atom to members of rs depending on how the
+   atom is classified by the backbone and polar classifiers.
  */
 static inline void
 rsa_abs_add_atom(freesasa_residue_sasa *rs,
@@ -95,16 +94,14 @@ rsa_abs_add_atom(freesasa_residue_sasa *rs,
                  const struct rsa_config *cfg)
 {
     double v = cfg->result->sasa[i_atom];
-    const char *atom_name = freesasa_structure_atom_name(cfg->structure,i_atom);
-    assert(atom_name);
 
     rs->total += v;
 
-    if (cfg->bb_classifier->sasa_class(rs->name, atom_name, cfg->bb_classifier))
+    if (cfg->bb_class[i_atom])
         rs->main_chain += v;
     else rs->side_chain += v;
 
-    if (cfg->polar_classifier->sasa_class(rs->name, atom_name, cfg->polar_classifier))
+    if (cfg->polar_class[i_atom])
         rs->polar += v;
     else rs->apolar += v;
 }
@@ -261,6 +258,7 @@ freesasa_write_rsa(FILE *output,
     };
     const char *chain_labels = freesasa_structure_chain_labels(structure);
     int naa = freesasa_structure_n_residues(structure),
+        n_atoms = freesasa_structure_n(structure),
         n_chains = strlen(chain_labels);
     freesasa_residue_sasa abs, rel, chain_abs[n_chains], all_chains_abs = zero_rs;
 
@@ -272,14 +270,23 @@ freesasa_write_rsa(FILE *output,
         reference = &freesasa_default_rsa;
     }
 
+    // classify all atoms once, instead of once per residue
+    cfg.bb_class = malloc(sizeof(int)*(2*n_atoms + 1));
+    if (cfg.bb_class == NULL) return mem_fail();
+    cfg.polar_class = cfg.bb_class + n_atoms;
+    freesasa_structure_atom_classes(structure, cfg.bb_classifier, cfg.bb_class);
+    freesasa_structure_atom_classes(structure, cfg.polar_classifier, cfg.polar_class);
+
     for (int i = 0; i < n_chains; ++i) chain_abs[i] = zero_rs;
     
     rsa_print_header(output, reference->name, name);
 
     for (int i = 0; i < naa; ++i) {
         if ( rsa_calc_rs(&abs, &rel, i, &cfg) ||
-             rsa_print_residue(output, i, &abs, &rel, &cfg))
+             rsa_print_residue(output, i, &abs, &rel, &cfg)) {
+            free(cfg.bb_class);
             return fail_msg("Failed calculating residue SASAs, inconsistent input?");
+        }
 
         rsa_add_residue_sasa(&all_chains_abs, &abs);
         char chain = freesasa_structure_residue_chain(structure, i);
@@ -301,6 +308,7 @@ freesasa_write_rsa(FILE *output,
     fprintf(output,"TOTAL      %10.1f   %10.1f   %10.1f   %10.1f   %10.1f\n",
             all_chains_abs.total, all_chains_abs.side_chain,
             all_chains_abs.main_chain, all_chains_abs.apolar, all_chains_abs.polar);
+    free(cfg.bb_class);
     
     fflush(output);
     if (ferror(output)) {
@@ -7,101 +7,192 @@
 #if HAVE_CONFIG_H
 # include <config.h>
 #endif
-#if USE_THREADS
-# include <pthread.h>
-#endif
 
 #include "freesasa.h"
 #include "freesasa_internal.h"
 #include "nb.h"
+#include "thread.h"
 
 const double TWOPI = 2*M_PI;
 
+/* Margin (in Ångström) used when deciding which neighbors can
+   intersect a slice, to make sure the window of active neighbors
+   always contains all neighbors that pass the exact test. */
+#define LR_Z_MARGIN 1e-9
+
+/* The square roots and arc cosines of all neighbors intersecting a
+   slice are calculated together, LR_SIMD_WIDTH at a time, using the
+   widest instruction set the compiler has been allowed to use (see
+   sasa_sr.c). Vector square roots are correctly rounded, so the
+   results do not depend on which kernel is used. */
+#if defined(__AVX512F__)
+# include <immintrin.h>
+# define LR_SIMD_WIDTH 8
+#elif defined(__AVX__)
+# include <immintrin.h>
+# define LR_SIMD_WIDTH 4
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+# define LR_SIMD_WIDTH 2
+#else
+# define LR_SIMD_WIDTH 1
+#endif
+
+/* Coefficients of the polynomial p(x) in the approximation acos(x)
+   = sqrt(1-x)*p(x), for 0 <= x <= 1, with absolute error below 2e-8
+   (Abramowitz & Stegun, 4.4.46). */
+static const double lr_acos_coeff[] = {
+    1.5707963050, -0.2145988016, 0.0889789874, -0.0501743046,
+    0.0308918810, -0.0170881256, 0.0066700901, -0.0012624911
+};
+#define LR_ACOS_ORDER 7
+
 //calculation parameters and data (results stored in *sasa)
 typedef struct {
     int n_atoms;
-    double *radii; //including probe
+    const double *radii; //including probe
+    double *own_radii; // radii, if created by init_lr()
     const coord_t *xyz;
-    nb_list *adj;
+    const nb_list *adj;
+    nb_list *own_adj; // adj, if created by init_lr()
+    const int *subset; // the atoms to calculate, NULL means all
     int n_slices_per_atom;
+    int approx; // use approximate arc cosine
     double *sasa; // results
 } lr_data;
 
-typedef struct {
-    int first_atom;
-    int last_atom;
-    lr_data *lr;
-} lr_thread_interval;
-
-#if USE_THREADS
-static int lr_do_threads(int n_threads, lr_data*);
-static void *lr_thread(void *arg);
-#endif
-
-/** Returns the are of atom i */
+/** Returns the area of atom i, row is the row of the neighbor list
+    that holds its neighbors */
 static double
-atom_area(lr_data *lr,int i);
+atom_area(lr_data *lr,int i,int row);
+
+/** Replaces the n values in x by their square roots. The array has
+    to be padded to a multiple of LR_SIMD_WIDTH. */
+static void
+lr_sqrt(double *x,
+        int n);
+
+/** Replaces the n values in x (in [-1,1]) by their arc cosines. If
+    approx is non-zero, a polynomial approximation is used, otherwise
+    acos() from the standard library. The array has to be padded to a
+    multiple of LR_SIMD_WIDTH. */
+static void
+lr_acos(double *x,
+        int n,
+        int approx);
+
+/** Sorts the indices in order by the values in key (insertion sort,
+    the lists are short) */
+static void
+lr_sort_by_key(int * restrict order,
+               const double * restrict key,
+               int n);
 
 /** Sum of exposed arcs based on buried arc intervals arc, assumes no
     intervals cross zero */
 static double
 exposed_arc_length(double *restrict arc, int n);
 
+/** Calculates the SASA of the atoms in [begin,end), see freesasa_thread_run() */
+static void
+lr_task(int begin,
+        int end,
+        int thread,
+        void *arg)
+{
+    lr_data *lr = arg;
+    (void)thread;
+    for (int k = begin; k < end; ++k) {
+        const int i = lr->subset ? lr->subset[k] : k;
+        /* the different threads write to different parts of the
+           array, so locking shouldn't be necessary */
+        lr->sasa[i] = atom_area(lr, i, k);
+    }
+}
+
 /** Release contenst of lr_data pointer*/
 static void
 release_lr(lr_data *lr)
 {
-    free(lr->radii);
-    freesasa_nb_free(lr->adj);
-    lr->radii = NULL;
-    lr->adj = NULL;
+    free(lr->own_radii);
+    freesasa_nb_free(lr->own_adj);
+    lr->radii = lr->own_radii = NULL;
+    lr->adj = lr->own_adj = NULL;
 }
 
-/** Initialize object to be used for L&R calculation */
+/** Initialize object to be used for L&R calculation. If add_probe is
+    non-zero the probe radius is added to the radii, otherwise they
+    are assumed to include it already. */
 static int
 init_lr(lr_data *lr,
         double *sasa,
         const coord_t *xyz,
         const double *atom_radii,
+        int add_probe,
         double probe_radius,
-        int n_slices_per_atom)
+        int n_slices_per_atom,
+        int approx,
+        const nb_list *adj,
+        const int *subset,
+        freesasa_thread_pool *pool,
+        int n_threads)
 {
     const int n_atoms = freesasa_coord_n(xyz);
 
     lr->n_atoms = n_atoms;
     lr->xyz = xyz;
-    lr->adj = NULL;
+    lr->adj = lr->own_adj = NULL;
+    lr->subset = subset;
     lr->n_slices_per_atom = n_slices_per_atom;
+    lr->approx = approx;
     lr->sasa = sasa;
+    lr->radii = atom_radii;
+    lr->own_radii = NULL;
 
-    lr->radii = malloc(sizeof(double)*n_atoms);
-    if (lr->radii == NULL) {
-        return mem_fail();
+    if (add_probe) {
+        lr->radii = lr->own_radii = malloc(sizeof(double)*n_atoms);
+        if (lr->own_radii == NULL) {
+            return mem_fail();
+        }
+        for (int i = 0; i < n_atoms; ++i) {
+            lr->own_radii[i] = atom_radii[i] + probe_radius;
+        }
     }
-
-    //init some arrays
-    for (int i = 0; i < n_atoms; ++i) {
-        lr->radii[i] = atom_radii[i] + probe_radius;
-        sasa[i] = 0.;
+    if (subset == NULL) {
+        for (int i = 0; i < n_atoms; ++i) sasa[i] = 0.;
     }
 
     // determine which atoms are neighbours
-    lr->adj = freesasa_nb_new(xyz, lr->radii);
-
-    if (lr->adj == NULL) {
-        release_lr(lr);
-        return FREESASA_FAIL;
+    if (adj == NULL) {
+        lr->adj = lr->own_adj = freesasa_nb_new_threads(xyz, lr->radii, pool, n_threads);
+        if (lr->adj == NULL) {
+            release_lr(lr);
+            return FREESASA_FAIL;
+        }
+    } else {
+        lr->adj = adj;
     }
 
     return FREESASA_SUCCESS;
 
 }
 
-int
-freesasa_lee_richards(double *sasa,
-                      const coord_t *xyz,
-                      const double *atom_radii,
-                      const freesasa_parameters *param)
+/**
+    Does the calculation for freesasa_lee_richards() and
+    freesasa_lee_richards_subset(). If add_probe is non-zero the probe
+    radius is added to the radii. If adj is NULL a neighbor list is
+    created. If subset is not NULL, only the n_subset atoms it lists
+    are calculated.
+ */
+static int
+lr_calc(double *sasa,
+        const coord_t *xyz,
+        const double *atom_radii,
+        int add_probe,
+        const freesasa_parameters *param,
+        const nb_list *adj,
+        const int *subset,
+        int n_subset)
 {
     assert(sasa);
     assert(xyz);
@@ -109,10 +200,11 @@ freesasa_lee_richards(double *sasa,
 
     if (param == NULL) param = &freesasa_default_parameters;
 
-    int return_value = FREESASA_SUCCESS,
+    int return_value = FREESASA_SUCCESS, ret,
         n_atoms = freesasa_coord_n(xyz),
         n_threads = param->n_threads,
-        resolution = param->lee_richards_n_slices;
+        resolution = param->lee_richards_n_slices,
+        chunk_size = param->thread_chunk_size;
     double probe_radius = param->probe_radius;
     lr_data lr;
 
@@ -123,86 +215,64 @@ freesasa_lee_richards(double *sasa,
     if (n_atoms == 0) {
         return freesasa_warn("in %s(): Empty coordinates", __func__);
     }
-    if (n_threads > n_atoms) {
+    if (subset == NULL) n_subset = n_atoms;
+    else if (n_subset == 0) return FREESASA_SUCCESS;
+    if (subset == NULL && n_threads > n_atoms) {
         n_threads = n_atoms;
         freesasa_warn("No sense in having more threads than atoms, only using %d threads.",
                       n_threads);
     }
     
-    if(init_lr(&lr, sasa, xyz, atom_radii, probe_radius, resolution))
-        return FREESASA_FAIL;
-    
+    if (chunk_size < 1) chunk_size = FREESASA_DEF_THREAD_CHUNK;
+    if (param->thread_pool) n_threads = freesasa_thread_pool_size(param->thread_pool);
+
+#if !USE_THREADS
     if (n_threads > 1) {
-#if USE_THREADS
-        return_value = lr_do_threads(n_threads, &lr);
-#else
         return_value = freesasa_warn("in %s(): program compiled for single-threaded use, "
                                      "but multiple threads were requested. Will "
                                      "proceed in single-threaded mode.\n",
                                      __func__);
         n_threads = 1;
-#endif /* pthread */
-    }
-    if (n_threads == 1) {
-        for (int i = 0; i < lr.n_atoms; ++i) {
-            lr.sasa[i] = atom_area(&lr, i);
-        }        
     }
+#endif /* pthread */
+
+    if(init_lr(&lr, sasa, xyz, atom_radii, add_probe, probe_radius, resolution,
+               param->lee_richards_approx, adj, subset, param->thread_pool, n_threads))
+        return FREESASA_FAIL;
+
+    ret = freesasa_thread_run(param->thread_pool, n_threads, n_subset,
+                              chunk_size, lr_task, &lr);
+    if (ret != FREESASA_SUCCESS) return_value = ret;
     release_lr(&lr);
     return return_value;
 }
 
-#if USE_THREADS
-static int
-lr_do_threads(int n_threads,
-              lr_data *lr)
+int
+freesasa_lee_richards(double *sasa,
+                      const coord_t *xyz,
+                      const double *atom_radii,
+                      const freesasa_parameters *param)
 {
-    pthread_t thread[n_threads];
-    lr_thread_interval t_data[n_threads];
-    int n_perthread = lr->n_atoms/n_threads, res;
-    int threads_created = 0, return_value = FREESASA_SUCCESS;
- 
-    for (int t = 0; t < n_threads; ++t) {
-        t_data[t].first_atom = t*n_perthread;
-        if (t == n_threads-1) {
-            t_data[t].last_atom = lr->n_atoms - 1;
-        } else {
-            t_data[t].last_atom = (t+1)*n_perthread - 1;
-        }
-        t_data[t].lr = lr;
-        res = pthread_create(&thread[t], NULL, lr_thread,
-                             (void *) &t_data[t]);
-        if (res) {
-            return_value = fail_msg(freesasa_thread_error(res));
-            break;
-        }
-        ++threads_created;
-    }
-    for (int t = 0; t < threads_created; ++t) {
-        res = pthread_join(thread[t],NULL);
-        if (res) {
-            return_value = fail_msg(freesasa_thread_error(res));
-        }
-    }
-    return return_value;
+    return lr_calc(sasa, xyz, atom_radii, 1, param, NULL, NULL, 0);
 }
 
-static void*
-lr_thread(void *arg)
+int
+freesasa_lee_richards_subset(double *sasa,
+                             const coord_t *xyz,
+                             const double *atom_radii,
+                             const nb_list *adj,
+                             const int *subset,
+                             int n_subset,
+                             const freesasa_parameters *param)
 {
-    lr_thread_interval *ti = ((lr_thread_interval*) arg);
-    for (int i = ti->first_atom; i <= ti->last_atom; ++i) {
-        /* the different threads write to different parts of the
-           array, so locking shouldn't be necessary */
-        ti->lr->sasa[i] = atom_area(ti->lr, i);
-    }
-    pthread_exit(NULL);
+    return lr_calc(sasa, xyz, atom_radii, 0, param, adj, subset, n_subset);
 }
-#endif /* USE_THREADS */
+
 
 static double
 atom_area(lr_data *lr,
-          int i)
+          int i,
+          int row)
 {
     /* This function is large because a large number of pre-calculated
        arrays need to be accessed efficiently. Partially dereferenced
@@ -211,85 +281,220 @@ atom_area(lr_data *lr,
        Variables are named according to the documentation (see page
        "Geometry of Lee & Richards' algorithm") */
 
-    const int nni = lr->adj->nn[i];
+    const int nni = lr->adj->nn[row];
     const double * restrict const v = freesasa_coord_all(lr->xyz);
     const double * restrict const R = lr->radii;
-    const int * restrict const nbi = lr->adj->nb[i];
-    const double * restrict const xydi = lr->adj->xyd[i];
-    const double * restrict const xdi = lr->adj->xd[i];
-    const double * restrict const ydi = lr->adj->yd[i];
+    const nb_pair * restrict const nbi = lr->adj->pair + lr->adj->first[row];
     const double zi = v[3*i+2], Ri = R[i];
-    const int ns = lr->n_slices_per_atom;
-    double arc[nni*4], z_nb[nni], R_nb[nni];
+    const int ns = lr->n_slices_per_atom, approx = lr->approx;
+    const int n_pad = LR_SIMD_WIDTH*((nni + LR_SIMD_WIDTH - 1)/LR_SIMD_WIDTH);
+    double arc[nni*4], z_nb[nni], R_nb[nni], z_min[nni], beta[nni];
+    // per slice: the neighbors intersecting it, and their intersections with circle i
+    double Rj_prime2[n_pad], Rj_prime[n_pad], dij[n_pad], beta_s[n_pad],
+        alpha[n_pad], beta_c[n_pad];
+    int order[nni], active[nni];
+    int n_active = 0, next = 0;
     double z, delta, sasa = 0;
     
     for (int j = 0; j < nni; ++j) {
-        z_nb[j] = v[3*nbi[j]+2];
-        R_nb[j] = R[nbi[j]];
+        z_nb[j] = v[3*nbi[j].j+2];
+        R_nb[j] = R[nbi[j].j];
+        z_min[j] = z_nb[j] - R_nb[j] - LR_Z_MARGIN;
+        // position of mid-point of intersection along circle i, same in all slices
+        beta[j] = atan2(nbi[j].yd,nbi[j].xd) + M_PI;
+        order[j] = j;
     }
-    
+
+    /* The slices are swept in increasing z. Neighbor j intersects
+       the slices between z_nb[j] - R_nb[j] and z_nb[j] + R_nb[j], so
+       with the neighbors sorted by their lowest z, we can keep a
+       window of the neighbors that intersect the current slice, and
+       only visit those. */
+    lr_sort_by_key(order, z_min, nni);
+
     delta = 2*Ri/ns;
     z = zi-Ri-0.5*delta;
     for (int islice = 0; islice < ns; ++islice) {
         z += delta;
+        // add neighbors that reach the slice, remove those that end below it
+        while (next < nni && z_min[order[next]] < z) {
+            active[n_active++] = order[next++];
+        }
+        for (int k = 0, n = n_active; k < n; ++k) {
+            const int j = active[k];
+            if (z_nb[j] + R_nb[j] + LR_Z_MARGIN <= z) --n_active;
+            else active[k - (n - n_active)] = j;
+        }
         const double di = fabs(zi - z);
         const double Ri_prime2 = Ri*Ri-di*di;
         if (Ri_prime2 < 0 ) continue; // handle round-off errors
         const double Ri_prime = sqrt(Ri_prime2);
         if (Ri_prime <= 0) continue; // more round-off errors
-        int n_arcs = 0, is_buried = 0;
-        for (int j = 0; j < nni; ++j) {
-            const double zj = z_nb[j];
-            const double dj = fabs(zj - z);
+
+        // radii of the circles of the neighbors in the slice
+        int n_in = 0;
+        for (int k = 0; k < n_active; ++k) {
+            const int j = active[k];
+            const double dj = fabs(z_nb[j] - z);
             const double Rj = R_nb[j];
             if (dj < Rj) {
-                const double Rj_prime2 = Rj*Rj-dj*dj;
-                const double Rj_prime = sqrt(Rj_prime2);
-                const double dij = xydi[j];
-                double alpha, beta, inf, sup;
-                int narc2;
-                if (dij >= Ri_prime + Rj_prime) { // atoms aren't in contact
-                    continue;
-                }
-                if (dij + Ri_prime < Rj_prime) { // circle i is completely inside j
-                    is_buried = 1;
-                    break;
-                }
-                if (dij + Rj_prime < Ri_prime) { // circle j is completely inside i
-                    continue;
-                }
-                // arc of circle i intersected by circle j
-                alpha = acos ((Ri_prime2 + dij*dij - Rj_prime2)/(2.0*Ri_prime*dij));
-                // position of mid-point of intersection along circle i
-                beta = atan2 (ydi[j],xdi[j]) + M_PI;
-                inf = beta - alpha;
-                sup = beta + alpha;
-                if (inf < 0) inf += TWOPI;
-                if (sup > 2*M_PI) sup -= TWOPI;
-                narc2 = 2*n_arcs;
-                // store the arc, if arc passes 2*PI split into two
-                if (sup < inf) {
-                    //store arcs as contiguous pairs of angles
-                    arc[narc2]   = 0;
-                    arc[narc2+1] = sup;
-                    //second arc
-                    arc[narc2+2] = inf;
-                    arc[narc2+3] = TWOPI;
-                    n_arcs += 2;
-                } else { 
-                    arc[narc2]   = inf;
-                    arc[narc2+1] = sup;
-                    ++n_arcs;
-                }
+                Rj_prime2[n_in] = Rj_prime[n_in] = Rj*Rj-dj*dj;
+                dij[n_in] = nbi[j].xyd;
+                beta_s[n_in] = beta[j];
+                ++n_in;
+            }
+        }
+        for (int k = n_in; k < n_in + LR_SIMD_WIDTH - 1 && k < n_pad; ++k) {
+            Rj_prime[k] = 0;
+        }
+        lr_sqrt(Rj_prime, n_in);
+
+        // which circles intersect circle i, and where
+        int n_c = 0, is_buried = 0;
+        for (int k = 0; k < n_in; ++k) {
+            const double Rj_p = Rj_prime[k], d = dij[k];
+            if (d >= Ri_prime + Rj_p) { // atoms aren't in contact
+                continue;
             }
+            if (d + Ri_prime < Rj_p) { // circle i is completely inside j
+                is_buried = 1;
+                break;
+            }
+            if (d + Rj_p < Ri_prime) { // circle j is completely inside i
+                continue;
+            }
+            alpha[n_c] = (Ri_prime2 + d*d - Rj_prime2[k])/(2.0*Ri_prime*d);
+            beta_c[n_c] = beta_s[k];
+            ++n_c;
+        }
+        if (is_buried) continue;
+        for (int k = n_c; k < n_c + LR_SIMD_WIDTH - 1 && k < n_pad; ++k) {
+            alpha[k] = 0;
         }
-        if (is_buried == 0) {
-            sasa += delta*Ri*exposed_arc_length(arc,n_arcs);
+        // arc of circle i intersected by circle j
+        lr_acos(alpha, n_c, approx);
+
+        int n_arcs = 0;
+        for (int k = 0; k < n_c; ++k) {
+            double inf = beta_c[k] - alpha[k], sup = beta_c[k] + alpha[k];
+            const int narc2 = 2*n_arcs;
+            if (inf < 0) inf += TWOPI;
+            if (sup > 2*M_PI) sup -= TWOPI;
+            // store the arc, if arc passes 2*PI split into two
+            if (sup < inf) {
+                //store arcs as contiguous pairs of angles
+                arc[narc2]   = 0;
+                arc[narc2+1] = sup;
+                //second arc
+                arc[narc2+2] = inf;
+                arc[narc2+3] = TWOPI;
+                n_arcs += 2;
+            } else { 
+                arc[narc2]   = inf;
+                arc[narc2+1] = sup;
+                ++n_arcs;
+            }
         }
+        sasa += delta*Ri*exposed_arc_length(arc,n_arcs);
     }
     return sasa;
 }
 
+static void
+lr_sqrt(double *x,
+        int n)
+{
+#if defined(__AVX512F__)
+    for (int k = 0; k < n; k += LR_SIMD_WIDTH)
+        _mm512_storeu_pd(x+k, _mm512_sqrt_pd(_mm512_loadu_pd(x+k)));
+#elif defined(__AVX__)
+    for (int k = 0; k < n; k += LR_SIMD_WIDTH)
+        _mm256_storeu_pd(x+k, _mm256_sqrt_pd(_mm256_loadu_pd(x+k)));
+#elif defined(__SSE2__)
+    for (int k = 0; k < n; k += LR_SIMD_WIDTH)
+        _mm_storeu_pd(x+k, _mm_sqrt_pd(_mm_loadu_pd(x+k)));
+#else
+    for (int k = 0; k < n; ++k) x[k] = sqrt(x[k]);
+#endif
+}
+
+static void
+lr_acos(double *x,
+        int n,
+        int approx)
+{
+    const double *c = lr_acos_coeff;
+    if (!approx) {
+        for (int k = 0; k < n; ++k) x[k] = acos(x[k]);
+        return;
+    }
+    // acos(x) = pi - acos(-x) for x < 0
+#if defined(__AVX512F__)
+    const __m512d one = _mm512_set1_pd(1), pi = _mm512_set1_pd(M_PI);
+    for (int k = 0; k < n; k += LR_SIMD_WIDTH) {
+        __m512d xk = _mm512_loadu_pd(x+k);
+        __m512d a = _mm512_min_pd(_mm512_abs_pd(xk), one);
+        __m512d p = _mm512_set1_pd(c[LR_ACOS_ORDER]);
+        for (int m = LR_ACOS_ORDER - 1; m >= 0; --m)
+            p = _mm512_add_pd(_mm512_mul_pd(p, a), _mm512_set1_pd(c[m]));
+        p = _mm512_mul_pd(p, _mm512_sqrt_pd(_mm512_sub_pd(one, a)));
+        __mmask8 neg = _mm512_cmp_pd_mask(xk, _mm512_setzero_pd(), _CMP_LT_OQ);
+        _mm512_storeu_pd(x+k, _mm512_mask_sub_pd(p, neg, pi, p));
+    }
+#elif defined(__AVX__)
+    const __m256d one = _mm256_set1_pd(1), pi = _mm256_set1_pd(M_PI),
+        sign = _mm256_set1_pd(-0.0);
+    for (int k = 0; k < n; k += LR_SIMD_WIDTH) {
+        __m256d xk = _mm256_loadu_pd(x+k);
+        __m256d a = _mm256_min_pd(_mm256_andnot_pd(sign, xk), one);
+        __m256d p = _mm256_set1_pd(c[LR_ACOS_ORDER]);
+        for (int m = LR_ACOS_ORDER - 1; m >= 0; --m)
+            p = _mm256_add_pd(_mm256_mul_pd(p, a), _mm256_set1_pd(c[m]));
+        p = _mm256_mul_pd(p, _mm256_sqrt_pd(_mm256_sub_pd(one, a)));
+        __m256d neg = _mm256_cmp_pd(xk, _mm256_setzero_pd(), _CMP_LT_OQ);
+        _mm256_storeu_pd(x+k, _mm256_blendv_pd(p, _mm256_sub_pd(pi, p), neg));
+    }
+#elif defined(__SSE2__)
+    const __m128d one = _mm_set1_pd(1), pi = _mm_set1_pd(M_PI),
+        sign = _mm_set1_pd(-0.0);
+    for (int k = 0; k < n; k += LR_SIMD_WIDTH) {
+        __m128d xk = _mm_loadu_pd(x+k);
+        __m128d a = _mm_min_pd(_mm_andnot_pd(sign, xk), one);
+        __m128d p = _mm_set1_pd(c[LR_ACOS_ORDER]);
+        for (int m = LR_ACOS_ORDER - 1; m >= 0; --m)
+            p = _mm_add_pd(_mm_mul_pd(p, a), _mm_set1_pd(c[m]));
+        p = _mm_mul_pd(p, _mm_sqrt_pd(_mm_sub_pd(one, a)));
+        __m128d neg = _mm_cmplt_pd(xk, _mm_setzero_pd());
+        _mm_storeu_pd(x+k, _mm_or_pd(_mm_and_pd(neg, _mm_sub_pd(pi, p)),
+                                     _mm_andnot_pd(neg, p)));
+    }
+#else
+    for (int k = 0; k < n; ++k) {
+        double a = fabs(x[k]), p = c[LR_ACOS_ORDER];
+        if (a > 1) a = 1;
+        for (int m = LR_ACOS_ORDER - 1; m >= 0; --m) p = p*a + c[m];
+        p *= sqrt(1 - a);
+        x[k] = x[k] < 0 ? M_PI - p : p;
+    }
+#endif
+}
+
+static void
+lr_sort_by_key(int * restrict order,
+               const double * restrict key,
+               int n)
+{
+    for (int i = 1; i < n; ++i) {
+        const int tmp = order[i];
+        int j = i;
+        while (j > 0 && key[order[j-1]] > key[tmp]) {
+            order[j] = order[j-1];
+            --j;
+        }
+        order[j] = tmp;
+    }
+}
+
 //insertion sort (faster than qsort for these short lists)
 inline static void
 sort_arcs(double * restrict arc,
@@ -3,6 +3,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <stdint.h>
 #if HAVE_CONFIG_H
 # include <config.h>
 #endif
@@ -13,34 +14,119 @@
 #include "freesasa.h"
 #include "freesasa_internal.h"
 #include "nb.h"
+#include "thread.h"
 
 #ifdef __GNUC__
-#define __attrib_pure__ __attribute__((pure))
+#define sr_popcount(x) __builtin_popcountll(x)
 #else
-#define __attrib_pure__
+static inline int sr_popcount(uint64_t x) { int n = 0; for (; x; x &= x-1) ++n; return n; }
 #endif
 
+/* Test points are checked against neighbors in blocks of
+   SR_SIMD_WIDTH points at a time, using the widest instruction set
+   the compiler has been allowed to use (i.e. configure with
+   CFLAGS="-O2 -march=native" to get AVX/AVX-512 on a machine that
+   supports it). Calculations are done in double precision, so that
+   the results do not depend on which of the kernels is used. */
+#if defined(__AVX512F__)
+# include <immintrin.h>
+# define SR_SIMD_WIDTH 8
+#elif defined(__AVX__)
+# include <immintrin.h>
+# define SR_SIMD_WIDTH 4
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+# define SR_SIMD_WIDTH 4
+#else
+# define SR_SIMD_WIDTH 4
+#endif
+
+/* The test points are grouped in patches of SR_PATCH_SIZE points
+   that are close to each other on the sphere. Each patch has a
+   bounding sphere, so that a neighbor can be found to bury all, or
+   none, of the points in a patch with a single test. Has to be a
+   multiple of SR_SIMD_WIDTH, at most 16 (to fit the masks in an
+   unsigned) and divide 64, so that patches don't straddle words in
+   the bitmasks. */
+#define SR_PATCH_SIZE 16
+/* Margin (in Ångström) for the patch tests, makes sure rounding
+   errors never make them disagree with the tests of the individual
+   points. */
+#define SR_PATCH_EPS 1e-6
+
+/* In the lookup table variant, the bitmask of the points buried by
+   a neighbor is looked up from its direction and from the cosine of
+   the opening angle of the cap it buries (see
+   sr_lut_atom_area()). Directions are quantized using a cube map
+   with SR_LUT_GRID x SR_LUT_GRID bins on each face, and the cosine in
+   SR_LUT_LEVELS steps between -1 and 1. */
+#define SR_LUT_GRID 16
+#define SR_LUT_LEVELS 64
+#define SR_LUT_DIRECTIONS (6*SR_LUT_GRID*SR_LUT_GRID)
+// Table size grows linearly with number of points, this gives about 5 MB
+#define SR_LUT_MAX_POINTS 512
+
+struct sr_scratch;
+
+//! Lookup table for a number of test points, see sr_lut_get()
+struct sr_lut {
+    int n_points;
+    int n_refs; // the cache and the calculations using the table
+    uint64_t *mask;
+};
+
 // calculation parameters (results stored in *sasa)
-typedef struct {
-    int i1,i2; // for multithreading, range of atoms
+typedef struct sr_data {
     int n_atoms;
     int n_points;
+    int n_padded; // n_points rounded up to a multiple of SR_SIMD_WIDTH
+    int n_patches; // number of patches, the last one can be incomplete
+    int n_words; // length of the bitmask of buried points of an atom
     double probe_radius;
     const coord_t *xyz;
-    coord_t *srp; // test-points
-    double *r;
-    double *r2;
-    nb_list *nb;
+    double *srp; // test-points, as arrays of x, y and z of length n_padded
+    double *patch; // bounding spheres of the patches of the unit sphere (x,y,z,r)
+    const double *r; // radii including probe
+    double *own_r; // r, if created by bind_sr()
+    const nb_list *nb;
+    nb_list *own_nb; // nb, if created by bind_sr()
+    const int *subset; // the atoms to calculate, NULL means all
+    int max_nn; // the largest number of neighbors of any atom
+    struct sr_scratch **scratch; // work space for each thread
+    int n_scratch; // number of threads that have work space
+    int scratch_nn; // number of neighbors the work space has room for
     double *sasa;
+    uint64_t *buried; // bitmasks of buried points, NULL if not requested
+    struct sr_lut *lut_ref; // the lookup table, NULL if not used
+    const uint64_t *lut; // bitmasks of the lookup table
+    double (*atom_area)(int i, int row, const struct sr_data *sr,
+                        struct sr_scratch *scratch);
 } sr_data;
 
-#if USE_THREADS
-static int sr_do_threads(int n_threads, sr_data *sr);
-static void *sr_thread(void *arg);
-#endif
+//! Test points and work space kept between calculations
+struct freesasa_sr_workspace {
+    sr_data sr;
+};
+
+//! Work space for one thread, reused for all atoms it handles
+struct sr_scratch {
+    double *xyz; // test points of an atom, coordinates and radii of its neighbors
+    uint64_t *buried; // bitmask of buried points, if sr_data::buried is NULL
+};
+
+/* The SASA of atom i, where row is the row of the neighbor list
+   that holds its neighbors */
+static double
+sr_atom_area(int i, int row, const sr_data *sr, struct sr_scratch *scratch);
 
 static double
-sr_atom_area(int i, const sr_data *sr) __attrib_pure__;
+sr_lut_atom_area(int i, int row, const sr_data *sr, struct sr_scratch *scratch);
+
+static struct sr_lut *
+sr_lut_get(const sr_data *sr);
+
+static void
+sr_lut_release(struct sr_lut *lut);
 
 static coord_t *
 test_points(int N) 
@@ -78,54 +164,262 @@ test_points(int N)
     return NULL;
 }
 
+//! Used to sort test points by longitude
+struct sr_longitude {
+    double phi;
+    int index;
+};
+
+static int
+sr_longitude_cmp(const void *a,
+                 const void *b)
+{
+    double pa = ((const struct sr_longitude*)a)->phi,
+        pb = ((const struct sr_longitude*)b)->phi;
+    return (pa > pb) - (pa < pb);
+}
+
+/**
+    Converts the test points to structure-of-arrays form, i.e. all
+    x-coordinates followed by all y- and z-coordinates. Each array is
+    padded to length n_padded, padding is placed at the origin and
+    never counted.
+
+    Consecutive points in the spiral are far apart, so they are
+    reordered to form patches of SR_PATCH_SIZE neighboring points. The
+    spiral is ordered by z, and is cut into bands along the z-axis,
+    the points in each band are sorted by longitude and each band
+    divided into patches. The width of the bands is chosen to make
+    the patches roughly square at the equator. The order of the points
+    does not affect the results.
+
+    Returns NULL if malloc fails.
+ */
+static double *
+test_points_soa(const coord_t *srp,
+                int n_padded)
+{
+    const int n = freesasa_coord_n(srp);
+    const double *p = freesasa_coord_all(srp);
+    // patches are 2*band/n high in z and 2*pi/(patches per band) wide
+    int band = SR_PATCH_SIZE * lround(sqrt(M_PI*n/SR_PATCH_SIZE));
+    double *soa = malloc(sizeof(double)*3*n_padded);
+    struct sr_longitude *order = malloc(sizeof(struct sr_longitude)*n);
+
+    if (soa == NULL || order == NULL) {
+        free(soa);
+        free(order);
+        mem_fail();
+        return NULL;
+    }
+    if (band < SR_PATCH_SIZE) band = SR_PATCH_SIZE;
+
+    for (int j = 0; j < n; ++j) {
+        order[j].phi = atan2(p[3*j+1], p[3*j]);
+        order[j].index = j;
+    }
+    for (int j = 0; j < n; j += band) {
+        qsort(order + j, j + band <= n ? band : n - j,
+              sizeof(struct sr_longitude), sr_longitude_cmp);
+    }
+    for (int j = 0; j < n_padded; ++j) {
+        for (int k = 0; k < 3; ++k) {
+            soa[k*n_padded + j] = j < n ? p[3*order[j].index + k] : 0;
+        }
+    }
+    free(order);
+    return soa;
+}
+
+/**
+    Calculates the bounding spheres of the patches of the test points
+    on the unit sphere. The center is the centroid of the patch (which
+    is inside the unit sphere) and the radius the distance to the most
+    distant point. Padding is not included.
+
+    Returns NULL if malloc fails.
+ */
+static double *
+sr_patches_new(const double *srp,
+               int n_points,
+               int n_padded)
+{
+    const int n_patches = (n_padded + SR_PATCH_SIZE - 1) / SR_PATCH_SIZE;
+    double *patch = malloc(sizeof(double)*4*n_patches);
+
+    if (patch == NULL) {
+        mem_fail();
+        return NULL;
+    }
+
+    for (int p = 0; p < n_patches; ++p) {
+        const int j0 = p*SR_PATCH_SIZE,
+            j1 = j0 + SR_PATCH_SIZE < n_points ? j0 + SR_PATCH_SIZE : n_points;
+        double c[3] = {0, 0, 0}, r2 = 0;
+
+        for (int j = j0; j < j1; ++j) {
+            for (int k = 0; k < 3; ++k) c[k] += srp[k*n_padded + j];
+        }
+        for (int k = 0; k < 3; ++k) c[k] /= j1 - j0;
+        for (int j = j0; j < j1; ++j) {
+            double d2 = 0;
+            for (int k = 0; k < 3; ++k) {
+                double d = srp[k*n_padded + j] - c[k];
+                d2 += d*d;
+            }
+            if (d2 > r2) r2 = d2;
+        }
+        for (int k = 0; k < 3; ++k) patch[4*p + k] = c[k];
+        patch[4*p + 3] = sqrt(r2);
+    }
+    return patch;
+}
+
+static void
+sr_scratch_free(struct sr_scratch *scratch)
+{
+    if (scratch) {
+        free(scratch->xyz);
+        free(scratch->buried);
+        free(scratch);
+    }
+}
+
+/**
+    Allocates work space for one thread, large enough to hold the
+    test points of an atom, the coordinates and radii of max_nn
+    neighbors and a bitmask of buried points. It is reused for all
+    atoms handled by the thread, to avoid allocating memory for each
+    atom.
+
+    Returns NULL if malloc fails.
+ */
+static struct sr_scratch *
+sr_scratch_new(const sr_data *sr,
+               int max_nn)
+{
+    struct sr_scratch *scratch = malloc(sizeof(struct sr_scratch));
+    if (scratch == NULL) {
+        mem_fail();
+        return NULL;
+    }
+    scratch->xyz = malloc(sizeof(double)*(3*sr->n_padded + 5*max_nn));
+    scratch->buried = malloc(sizeof(uint64_t)*sr->n_words);
+    if (scratch->xyz == NULL || scratch->buried == NULL) {
+        sr_scratch_free(scratch);
+        mem_fail();
+        return NULL;
+    }
+    return scratch;
+}
+
+/**
+    Makes sure there is work space for n_threads threads, with room
+    for sr->max_nn neighbors. The work space only grows, so that
+    repeated calculations with a workspace don't reallocate it.
+ */
+static int
+sr_scratch_reserve(sr_data *sr,
+                   int n_threads)
+{
+    int max_nn = sr->scratch_nn;
+
+    if (n_threads <= sr->n_scratch && sr->max_nn <= sr->scratch_nn)
+        return FREESASA_SUCCESS;
+    if (n_threads < sr->n_scratch) n_threads = sr->n_scratch;
+    if (sr->max_nn > max_nn) max_nn = sr->max_nn > 2*max_nn ? sr->max_nn : 2*max_nn;
+
+    for (int t = 0; t < sr->n_scratch; ++t) sr_scratch_free(sr->scratch[t]);
+    free(sr->scratch);
+    sr->n_scratch = 0;
+    sr->scratch_nn = max_nn;
+
+    sr->scratch = malloc(sizeof(struct sr_scratch *)*n_threads);
+    if (sr->scratch == NULL) return mem_fail();
+    for (int t = 0; t < n_threads; ++t) {
+        sr->scratch[t] = sr_scratch_new(sr, max_nn);
+        if (sr->scratch[t] == NULL) return fail_msg("");
+        ++sr->n_scratch;
+    }
+    return FREESASA_SUCCESS;
+}
+
+// free the data of one calculation, see bind_sr()
+static void
+unbind_sr(sr_data *sr)
+{
+    freesasa_nb_free(sr->own_nb);
+    free(sr->own_r);
+    sr->r = sr->own_r = NULL;
+    sr->nb = sr->own_nb = NULL;
+}
+
 // free contents
-void
+static void
 release_sr(sr_data *sr)
 {
-    freesasa_coord_free(sr->srp);
-    freesasa_nb_free(sr->nb);
-    free(sr->r);
-    free(sr->r2);
+    unbind_sr(sr);
+    for (int t = 0; t < sr->n_scratch; ++t) sr_scratch_free(sr->scratch[t]);
+    free(sr->scratch);
+    free(sr->srp);
+    free(sr->patch);
+    if (sr->lut_ref) sr_lut_release(sr->lut_ref);
 }
 
-
-int
+/**
+    Initializes the parts of sr that only depend on the number of
+    test points: the test points themselves, their patches and the
+    lookup table, if use_lut is non-zero. These can be reused for
+    several calculations, see bind_sr().
+ */
+static int
 init_sr(sr_data *sr,
-        double *sasa,
-        const coord_t *xyz,
-        const double *r,
-        double probe_radius,
-        int n_points)
+        int n_points,
+        int use_lut)
 {
-    int n_atoms = freesasa_coord_n(xyz);
+    int n_padded = SR_SIMD_WIDTH*((n_points + SR_SIMD_WIDTH - 1)/SR_SIMD_WIDTH);
     coord_t *srp = test_points(n_points);
 
     if (srp == NULL) return fail_msg("Failed to initialize test points.");
     
     //store parameters and reference arrays
-    sr->n_atoms = n_atoms;
+    sr->n_atoms = 0;
     sr->n_points = n_points;
-    sr->probe_radius = probe_radius;
-    sr->xyz = xyz;
-    sr->srp = srp;
-    sr->sasa = sasa;
-    sr->nb = NULL;
+    sr->n_padded = n_padded;
+    sr->n_patches = (n_padded + SR_PATCH_SIZE - 1) / SR_PATCH_SIZE;
+    sr->n_words = FREESASA_SR_MASK_WORDS(n_points);
+    sr->probe_radius = 0;
+    sr->xyz = NULL;
+    sr->srp = test_points_soa(srp, n_padded);
+    sr->patch = NULL;
+    sr->sasa = NULL;
+    sr->buried = NULL;
+    sr->lut_ref = NULL;
+    sr->lut = NULL;
+    sr->atom_area = sr_atom_area;
+    sr->r = sr->own_r = NULL;
+    sr->nb = sr->own_nb = NULL;
+    sr->subset = NULL;
+    sr->max_nn = 0;
+    sr->scratch = NULL;
+    sr->n_scratch = sr->scratch_nn = 0;
 
-    sr->r =  malloc(sizeof(double)*n_atoms);
-    sr->r2 = malloc(sizeof(double)*n_atoms);
+    freesasa_coord_free(srp);
+    if (sr->srp == NULL) goto cleanup;
 
-    if (sr->r == NULL || sr->r2 == NULL) goto cleanup;
+    sr->patch = sr_patches_new(sr->srp, n_points, n_padded);
+    if (sr->patch == NULL) goto cleanup;
 
-    for (int i = 0; i < n_atoms; ++i) {
-        double ri = r[i] + probe_radius;
-        sr->r[i] = ri;
-        sr->r2[i] = ri * ri;
+    if (use_lut) {
+        sr->lut_ref = sr_lut_get(sr);
+        if (sr->lut_ref == NULL) {
+            release_sr(sr);
+            return fail_msg("");
+        }
+        sr->lut = sr->lut_ref->mask;
+        sr->atom_area = sr_lut_atom_area;
     }
 
-    //calculate distances
-    sr->nb = freesasa_nb_new(xyz, sr->r);
-    if (sr->nb == NULL) goto cleanup;
-
     return FREESASA_SUCCESS;
 
  cleanup:
@@ -133,11 +427,291 @@ init_sr(sr_data *sr,
     return mem_fail();
 }
 
-int
-freesasa_shrake_rupley(double *sasa,
-                       const coord_t *xyz,
-                       const double *r,
-		       const freesasa_parameters *param)
+/**
+    Sets up sr for a calculation of the given coordinates. If
+    add_probe is non-zero, the probe radius is added to the radii r,
+    otherwise they are assumed to include it already. If nb is NULL a
+    neighbor list is created. When a subset is given, row k of nb
+    holds the neighbors of atom subset[k], otherwise row i holds the
+    neighbors of atom i. Only the rows of nb are visited, so the cost
+    is proportional to the size of the list.
+ */
+static int
+bind_sr(sr_data *sr,
+        double *sasa,
+        uint64_t *buried,
+        const coord_t *xyz,
+        const double *r,
+        int add_probe,
+        double probe_radius,
+        const nb_list *nb,
+        const int *subset,
+        freesasa_thread_pool *pool,
+        int n_threads)
+{
+    const int n_atoms = freesasa_coord_n(xyz);
+
+    sr->n_atoms = n_atoms;
+    sr->probe_radius = probe_radius;
+    sr->xyz = xyz;
+    sr->sasa = sasa;
+    sr->buried = buried;
+    sr->subset = subset;
+    sr->max_nn = 0;
+    sr->r = r;
+
+    if (add_probe) {
+        sr->r = sr->own_r = malloc(sizeof(double)*n_atoms);
+        if (sr->own_r == NULL) return mem_fail();
+        for (int i = 0; i < n_atoms; ++i) {
+            sr->own_r[i] = r[i] + probe_radius;
+        }
+    }
+
+    //calculate distances
+    if (nb == NULL) {
+        sr->nb = sr->own_nb = freesasa_nb_new_threads(xyz, sr->r, pool, n_threads);
+        if (sr->nb == NULL) {
+            unbind_sr(sr);
+            return fail_msg("");
+        }
+    } else {
+        sr->nb = nb;
+    }
+
+    for (int k = 0; k < sr->nb->n; ++k) {
+        if (sr->nb->nn[k] > sr->max_nn) sr->max_nn = sr->nb->nn[k];
+    }
+
+    return FREESASA_SUCCESS;
+}
+
+/**
+    Returns the index of the bin of the cube map the direction
+    (x,y,z) falls in. The vector doesn't have to be normalized, but
+    can't be zero.
+ */
+static inline int
+sr_lut_direction(double x,
+                 double y,
+                 double z)
+{
+    // written without branches, the face is unpredictable
+    const double ax = fabs(x), ay = fabs(y), az = fabs(z);
+    const int xmax = (ax >= ay) & (ax >= az), ymax = !xmax & (ay >= az);
+    const double m = xmax ? ax : (ymax ? ay : az),
+        s = xmax ? y : x,
+        t = (xmax | ymax) ? z : y,
+        c = xmax ? x : (ymax ? y : z);
+    const int face = 2*(xmax ? 0 : (ymax ? 1 : 2)) + (c < 0);
+    int is = (s/m + 1) * 0.5 * SR_LUT_GRID,
+        it = (t/m + 1) * 0.5 * SR_LUT_GRID;
+
+    if (is >= SR_LUT_GRID) is = SR_LUT_GRID - 1;
+    if (it >= SR_LUT_GRID) it = SR_LUT_GRID - 1;
+
+    return (face*SR_LUT_GRID + is)*SR_LUT_GRID + it;
+}
+
+//! Sets the bits of the first n_points points in mask
+static void
+sr_mask_all(uint64_t *mask,
+            int n_points)
+{
+    int w;
+    for (w = 0; w < n_points/64; ++w) mask[w] = ~(uint64_t)0;
+    if (n_points % 64) mask[w] = ((uint64_t)1 << (n_points % 64)) - 1;
+}
+
+/**
+    Builds the lookup table for the test points in sr. For each
+    direction bin u and level k, the table stores which test points p
+    satisfy p·u >= c_k, where u is the direction of the center of the
+    bin and c_k = -1 + 2k/(SR_LUT_LEVELS-1). Each entry is a bitmask
+    of sr->n_words words.
+
+    Returns NULL if malloc fails.
+ */
+static uint64_t *
+sr_lut_new(const sr_data *sr)
+{
+    const int n_words = sr->n_words, n_padded = sr->n_padded;
+    const double *srp = sr->srp;
+    uint64_t *lut = calloc((size_t)SR_LUT_DIRECTIONS*SR_LUT_LEVELS*n_words,
+                           sizeof(uint64_t));
+    if (lut == NULL) {
+        mem_fail();
+        return NULL;
+    }
+
+    for (int d = 0; d < SR_LUT_DIRECTIONS; ++d) {
+        const int face = d / (SR_LUT_GRID*SR_LUT_GRID);
+        const double s = ((d / SR_LUT_GRID) % SR_LUT_GRID + 0.5) * 2.0 / SR_LUT_GRID - 1,
+            t = (d % SR_LUT_GRID + 0.5) * 2.0 / SR_LUT_GRID - 1,
+            sign = face % 2 ? -1 : 1,
+            norm = sqrt(1 + s*s + t*t);
+        double u[3];
+        uint64_t *entry = lut + (size_t)d*SR_LUT_LEVELS*n_words;
+
+        switch (face / 2) {
+        case 0: u[0] = sign; u[1] = s; u[2] = t; break;
+        case 1: u[0] = s; u[1] = sign; u[2] = t; break;
+        default: u[0] = s; u[1] = t; u[2] = sign; break;
+        }
+
+        // first store each point at the highest level that buries it
+        for (int j = 0; j < sr->n_points; ++j) {
+            double dot = (srp[j]*u[0] + srp[n_padded+j]*u[1]
+                          + srp[2*n_padded+j]*u[2]) / norm;
+            int k = (dot + 1) * 0.5 * (SR_LUT_LEVELS - 1);
+            if (k < 0) k = 0;
+            if (k >= SR_LUT_LEVELS) k = SR_LUT_LEVELS - 1;
+            entry[k*n_words + j/64] |= (uint64_t)1 << (j%64);
+        }
+        // then all lower levels also bury it
+        for (int k = SR_LUT_LEVELS - 2; k >= 0; --k) {
+            for (int w = 0; w < n_words; ++w) {
+                entry[k*n_words + w] |= entry[(k+1)*n_words + w];
+            }
+        }
+    }
+
+    return lut;
+}
+
+/* The lookup table only depends on the number of test points, and
+   is expensive to build compared to calculations for small
+   structures. The last table built is therefore kept for the next
+   calculation, and replaced when another number of points is used.
+   Tables are reference counted, and freed once neither the cache nor
+   any calculation uses them. */
+
+static struct sr_lut *sr_lut_cached = NULL;
+#if USE_THREADS
+static pthread_mutex_t sr_lut_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void
+sr_lut_lock_cache(void)
+{
+#if USE_THREADS
+    pthread_mutex_lock(&sr_lut_lock);
+#endif
+}
+
+static void
+sr_lut_unlock_cache(void)
+{
+#if USE_THREADS
+    pthread_mutex_unlock(&sr_lut_lock);
+#endif
+}
+
+//! Drops a reference to the table, the cache has to be locked
+static void
+sr_lut_unref(struct sr_lut *lut)
+{
+    if (lut != NULL && --lut->n_refs == 0) {
+        free(lut->mask);
+        free(lut);
+    }
+}
+
+/**
+    Returns the lookup table for the test points in sr, building it
+    if it isn't the cached one. The table is built without holding
+    the lock, so that calculations don't wait for each other. It
+    should be released with sr_lut_release(). Returns NULL if malloc
+    fails.
+ */
+static struct sr_lut *
+sr_lut_get(const sr_data *sr)
+{
+    struct sr_lut *lut;
+
+    sr_lut_lock_cache();
+    lut = sr_lut_cached;
+    if (lut != NULL && lut->n_points == sr->n_points) {
+        ++lut->n_refs;
+        sr_lut_unlock_cache();
+        return lut;
+    }
+    sr_lut_unlock_cache();
+
+    lut = malloc(sizeof(struct sr_lut));
+    if (lut == NULL) {
+        mem_fail();
+        return NULL;
+    }
+    if ((lut->mask = sr_lut_new(sr)) == NULL) {
+        free(lut);
+        return NULL;
+    }
+    lut->n_points = sr->n_points;
+    lut->n_refs = 2;
+
+    sr_lut_lock_cache();
+    sr_lut_unref(sr_lut_cached);
+    sr_lut_cached = lut;
+    sr_lut_unlock_cache();
+
+    return lut;
+}
+
+static void
+sr_lut_release(struct sr_lut *lut)
+{
+    sr_lut_lock_cache();
+    sr_lut_unref(lut);
+    sr_lut_unlock_cache();
+}
+
+void
+freesasa_shrake_rupley_lut_clear(void)
+{
+    sr_lut_lock_cache();
+    sr_lut_unref(sr_lut_cached);
+    sr_lut_cached = NULL;
+    sr_lut_unlock_cache();
+}
+
+//! Calculates the SASA of the atoms in [begin,end), see freesasa_thread_run()
+static void
+sr_task(int begin,
+        int end,
+        int thread,
+        void *arg)
+{
+    sr_data *sr = arg;
+    for (int k = begin; k < end; ++k) {
+        const int i = sr->subset ? sr->subset[k] : k;
+        // threads write to non-overlapping regions, no locking needed
+        sr->sasa[i] = sr->atom_area(i, k, sr, sr->scratch[thread]);
+    }
+}
+
+/**
+    Does the calculation for freesasa_shrake_rupley(),
+    freesasa_shrake_rupley_buried(), freesasa_shrake_rupley_lut() and
+    freesasa_shrake_rupley_subset(), use_lut specifies if the lookup
+    table should be used. If add_probe is non-zero the probe radius
+    is added to the radii r. If nb is NULL a neighbor list is
+    created. If subset is not NULL, only the n_subset atoms it lists
+    are calculated. If ws is not NULL, its test points and work space
+    are used, instead of setting them up for this call only.
+ */
+static int
+sr_calc(double *sasa,
+        uint64_t *buried,
+        const coord_t *xyz,
+        const double *r,
+        int add_probe,
+        const freesasa_parameters *param,
+        int use_lut,
+        const nb_list *nb,
+        const int *subset,
+        int n_subset,
+        freesasa_sr_workspace *ws)
 {
     assert(sasa);
     assert(xyz);
@@ -148,148 +722,360 @@ freesasa_shrake_rupley(double *sasa,
     int n_atoms = freesasa_coord_n(xyz),
         n_threads = param->n_threads,
         resolution = param->shrake_rupley_n_points,
+        chunk_size = param->thread_chunk_size,
         return_value = FREESASA_SUCCESS;
     double probe_radius = param->probe_radius;
-    sr_data sr;
+    sr_data own_sr, *sr = ws ? &ws->sr : &own_sr;
     
     if (resolution <= 0)
         return freesasa_fail("in %s(): n_slices_per_atom = %f is invalid, must be > 0\n",
                              __func__, resolution);
     if (n_atoms == 0) return freesasa_warn("%s(): empty coordinates", __func__);
-    if (n_threads > n_atoms) {
+    if (subset == NULL) n_subset = n_atoms;
+    else if (n_subset == 0) return FREESASA_SUCCESS;
+    if (subset == NULL && n_threads > n_atoms) {
         n_threads = n_atoms;
         freesasa_warn("No sense in having more threads than atoms, only using %d threads.",
                       n_threads);
     }
     
-    if (init_sr(&sr, sasa, xyz, r, probe_radius, resolution))
-        return FREESASA_FAIL;
-    
-    //calculate SASA
+    if (chunk_size < 1) chunk_size = FREESASA_DEF_THREAD_CHUNK;
+    if (param->thread_pool) n_threads = freesasa_thread_pool_size(param->thread_pool);
+
+    if (use_lut && resolution > SR_LUT_MAX_POINTS)
+        return freesasa_fail("in %s(): the lookup table variant of S&R supports "
+                             "at most %d test points, %d requested\n",
+                             __func__, SR_LUT_MAX_POINTS, resolution);
+
+#if !USE_THREADS
     if (n_threads > 1) {
-#if USE_THREADS
-        return_value = sr_do_threads(n_threads, &sr);
-#else
         return_value = freesasa_warn("%s: program compiled for single-threaded use, "
                                      "but multiple threads were requested. Will "
                                      "proceed in single-threaded mode.\n",
                                      __func__);
         n_threads = 1;
+    }
 #endif
+    // no use for more threads than there are chunks
+    if (n_threads < 1) n_threads = 1;
+    if (n_threads > (n_subset + chunk_size - 1) / chunk_size)
+        n_threads = (n_subset + chunk_size - 1) / chunk_size;
+
+    if (ws == NULL) {
+        if (init_sr(sr, resolution, use_lut)) return FREESASA_FAIL;
+    } else {
+        assert(sr->n_points == resolution);
+        assert((sr->lut != NULL) == (use_lut != 0));
     }
-    if (n_threads == 1) {
-        // don't want the overhead of generating threads if only one is used
-        for (int i = 0; i < n_atoms; ++i) {
-            sasa[i] = sr_atom_area(i, &sr);
-        }
+
+    if (bind_sr(sr, sasa, buried, xyz, r, add_probe, probe_radius,
+                nb, subset, param->thread_pool, n_threads) ||
+        sr_scratch_reserve(sr, n_threads)) {
+        return_value = fail_msg("");
+    } else {
+        //calculate SASA
+        int ret = freesasa_thread_run(param->thread_pool, n_threads, n_subset,
+                                      chunk_size, sr_task, sr);
+        if (ret != FREESASA_SUCCESS) return_value = ret;
     }
-    release_sr(&sr);
+
+    if (ws == NULL) release_sr(sr);
+    else unbind_sr(sr);
     return return_value;
 }
 
-#if USE_THREADS
-static int
-sr_do_threads(int n_threads,
-              sr_data *sr)
+int
+freesasa_shrake_rupley(double *sasa,
+                       const coord_t *xyz,
+                       const double *r,
+		       const freesasa_parameters *param)
 {
-    pthread_t thread[n_threads];
-    sr_data srt[n_threads];
-    int thread_block_size = sr->n_atoms/n_threads;
-    int res, return_value = FREESASA_SUCCESS;
-    int threads_created = 0;
+    return sr_calc(sasa, NULL, xyz, r, 1, param, 0, NULL, NULL, 0, NULL);
+}
 
-    // divide atoms evenly over threads
-    for (int t = 0; t < n_threads; ++t) {
-        srt[t] = *sr;
-        srt[t].i1 = t*thread_block_size;
-        if (t == n_threads-1) srt[t].i2 = sr->n_atoms;
-        else srt[t].i2 = (t+1)*thread_block_size;
-        res = pthread_create(&thread[t], NULL, sr_thread, (void *) &srt[t]);
-        if (res) {
-            return_value = fail_msg(freesasa_thread_error(res));
-            break;
-        }
-        ++threads_created;
+int
+freesasa_shrake_rupley_buried(double *sasa,
+                              uint64_t *buried,
+                              const coord_t *xyz,
+                              const double *r,
+                              const freesasa_parameters *param)
+{
+    return sr_calc(sasa, buried, xyz, r, 1, param, 0, NULL, NULL, 0, NULL);
+}
+
+int
+freesasa_shrake_rupley_lut(double *sasa,
+                           const coord_t *xyz,
+                           const double *r,
+                           const freesasa_parameters *param)
+{
+    return sr_calc(sasa, NULL, xyz, r, 1, param, 1, NULL, NULL, 0, NULL);
+}
+
+int
+freesasa_shrake_rupley_subset(double *sasa,
+                              const coord_t *xyz,
+                              const double *r,
+                              const nb_list *nb,
+                              const int *subset,
+                              int n_subset,
+                              const freesasa_parameters *param,
+                              freesasa_sr_workspace *ws)
+{
+    int use_lut = param != NULL && param->alg == FREESASA_SHRAKE_RUPLEY_LUT;
+    return sr_calc(sasa, NULL, xyz, r, 0, param, use_lut, nb, subset, n_subset, ws);
+}
+
+freesasa_sr_workspace *
+freesasa_sr_workspace_new(const freesasa_parameters *param)
+{
+    if (param == NULL) param = &freesasa_default_parameters;
+
+    const int n_points = param->shrake_rupley_n_points,
+        use_lut = param->alg == FREESASA_SHRAKE_RUPLEY_LUT;
+    freesasa_sr_workspace *ws;
+
+    if (n_points <= 0 || (use_lut && n_points > SR_LUT_MAX_POINTS)) {
+        freesasa_fail("in %s(): %d test points is invalid", __func__, n_points);
+        return NULL;
     }
-    for (int t = 0; t < threads_created; ++t) {
-        int res = pthread_join(thread[t], NULL);
-        if (res) {
-            return_value = fail_msg(freesasa_thread_error(res));
-        }
+    ws = malloc(sizeof(freesasa_sr_workspace));
+    if (ws == NULL) {
+        mem_fail();
+        return NULL;
     }
-    return return_value;
+    if (init_sr(&ws->sr, n_points, use_lut)) {
+        free(ws);
+        fail_msg("");
+        return NULL;
+    }
+    return ws;
 }
 
-static void *
-sr_thread(void *arg)
+void
+freesasa_sr_workspace_free(freesasa_sr_workspace *ws)
 {
-    sr_data *sr = ((sr_data*) arg);
-    for (int i = sr->i1; i < sr->i2; ++i) {
-        // mutex should not be necessary, writes to non-overlapping regions
-        sr->sasa[i] = sr_atom_area(i, sr);
+    if (ws) {
+        release_sr(&ws->sr);
+        free(ws);
     }
-    pthread_exit(NULL);
 }
+
+/**
+    Returns a bitmask of which of the SR_SIMD_WIDTH test points
+    starting at x, y and z are buried in the sphere centered at
+    (ax,ay,az) with square radius r2.
+ */
+static inline unsigned
+sr_block_buried(const double * restrict x,
+                const double * restrict y,
+                const double * restrict z,
+                double ax,
+                double ay,
+                double az,
+                double r2)
+{
+#if defined(__AVX512F__)
+    __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(x), _mm512_set1_pd(ax));
+    __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(y), _mm512_set1_pd(ay));
+    __m512d dz = _mm512_sub_pd(_mm512_loadu_pd(z), _mm512_set1_pd(az));
+    __m512d d2 = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(dx,dx),
+                                             _mm512_mul_pd(dy,dy)),
+                               _mm512_mul_pd(dz,dz));
+    return _mm512_cmp_pd_mask(d2, _mm512_set1_pd(r2), _CMP_LE_OQ);
+#elif defined(__AVX__)
+    __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x), _mm256_set1_pd(ax));
+    __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y), _mm256_set1_pd(ay));
+    __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(z), _mm256_set1_pd(az));
+    __m256d d2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx,dx),
+                                             _mm256_mul_pd(dy,dy)),
+                               _mm256_mul_pd(dz,dz));
+    return _mm256_movemask_pd(_mm256_cmp_pd(d2, _mm256_set1_pd(r2), _CMP_LE_OQ));
+#elif defined(__SSE2__)
+    // two registers of two points each
+    const __m128d ax2 = _mm_set1_pd(ax), ay2 = _mm_set1_pd(ay),
+        az2 = _mm_set1_pd(az), r22 = _mm_set1_pd(r2);
+    unsigned mask = 0;
+    for (int w = 0; w < SR_SIMD_WIDTH; w += 2) {
+        __m128d dx = _mm_sub_pd(_mm_loadu_pd(x+w), ax2);
+        __m128d dy = _mm_sub_pd(_mm_loadu_pd(y+w), ay2);
+        __m128d dz = _mm_sub_pd(_mm_loadu_pd(z+w), az2);
+        __m128d d2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx,dx),
+                                           _mm_mul_pd(dy,dy)),
+                                _mm_mul_pd(dz,dz));
+        mask |= _mm_movemask_pd(_mm_cmple_pd(d2, r22)) << w;
+    }
+    return mask;
+#else
+    unsigned mask = 0;
+    for (int w = 0; w < SR_SIMD_WIDTH; ++w) {
+        double dx = x[w] - ax, dy = y[w] - ay, dz = z[w] - az;
+        if (dx*dx + dy*dy + dz*dz <= r2) mask |= 1u << w;
+    }
+    return mask;
 #endif
+}
 
 static double
 sr_atom_area(int i,
-             const sr_data *sr)
+             int row,
+             const sr_data *sr,
+             struct sr_scratch *scratch)
 {
     const int n_points = sr->n_points;
-    /* this array keeps track of which testpoints belonging to
-       a certain atom do not overlap with any other atoms */
-    int spcount[n_points];
-    const int nni = sr->nb->nn[i];
-    const int * restrict nbi = sr->nb->nb[i];
+    const int n_padded = sr->n_padded;
+    const int nni = sr->nb->nn[row];
+    const nb_pair * restrict nbi = sr->nb->pair + sr->nb->first[row];
     const double ri = sr->r[i];
-    const double * restrict r2 = sr->r2;
+    const double * restrict r = sr->r;
     const double * restrict v = freesasa_coord_all(sr->xyz);
     const double * restrict vi = v+3*i;
-    const double * restrict tp;
-    int n_surface = 0, current_nb, a;
-    double dx, dy, dz;
-    /* testpoints for this atom */
-    coord_t * restrict tp_coord_ri = freesasa_coord_copy(sr->srp);
-
-    freesasa_coord_scale(tp_coord_ri, ri);
-    freesasa_coord_translate(tp_coord_ri, vi);
-    tp = freesasa_coord_all(tp_coord_ri);
-
-    // initialize with all surface points hidden
-    memset(spcount, 0, n_points*sizeof(int));
-
-    /* Using the trick from NSOL to check points one by one for all
-       atoms, start comparing with the first neighbor. If there is no
-       overlap for a given test-point, try with other neighbors
-       instead. Would probably work even better if test points were
-       organized in patches and not spirals. */
-    current_nb = 0;
-    for (int j = 0; j < n_points; ++j) {
-        //a is the index of the atom under consideration
-        a = nbi[current_nb];
-        dx = tp[j*3]   - v[a*3];
-        dy = tp[j*3+1] - v[a*3+1];
-        dz = tp[j*3+2] - v[a*3+2];
-        if (dx*dx + dy*dy + dz*dz > r2[a]) {
-            int k = 0;
-            for (; k < nni; ++k) {
-                a = nbi[k];
-                dx = tp[j*3]   - v[a*3];
-                dy = tp[j*3+1] - v[a*3+1];
-                dz = tp[j*3+2] - v[a*3+2];
-                if (dx*dx + dy*dy + dz*dz <= r2[a]) {
+    const double * restrict srp = sr->srp;
+    /* testpoints for this atom, and the coordinates of its neighbors,
+       stored as separate arrays for x, y and z in the thread's
+       scratch space */
+    double * restrict tx = scratch->xyz, * restrict ty = tx + n_padded,
+        * restrict tz = ty + n_padded;
+    double * restrict nx = tz + n_padded, * restrict ny = nx + sr->max_nn,
+        * restrict nz = ny + sr->max_nn, * restrict nr = nz + sr->max_nn,
+        * restrict nr2 = nr + sr->max_nn;
+    uint64_t * restrict buried = sr->buried ?
+        sr->buried + (size_t)i*sr->n_words : scratch->buried;
+    int n_buried = 0, current_nb = 0;
+
+    memset(buried, 0, sizeof(uint64_t)*sr->n_words);
+
+    for (int j = 0; j < n_padded; ++j) {
+        tx[j] = srp[j]*ri + vi[0];
+        ty[j] = srp[n_padded + j]*ri + vi[1];
+        tz[j] = srp[2*n_padded + j]*ri + vi[2];
+    }
+    for (int k = 0; k < nni; ++k) {
+        const int a = nbi[k].j;
+        nx[k] = v[a*3];
+        ny[k] = v[a*3+1];
+        nz[k] = v[a*3+2];
+        nr[k] = r[a];
+        nr2[k] = r[a]*r[a];
+    }
+
+    /* Using the trick from NSOL to check points for all atoms, start
+       comparing with the neighbor that last buried a point. If there
+       are points in the patch that are still exposed, try with the
+       other neighbors instead, until all points in the patch are
+       buried or we have gone through the whole list. Neighbors that
+       can be seen to bury all or none of the points from the
+       bounding sphere of the patch are handled without testing the
+       individual points. */
+    for (int p = 0; p < sr->n_patches; ++p) {
+        const int j0 = p*SR_PATCH_SIZE;
+        const double *patch = sr->patch + 4*p;
+        const double px = patch[0]*ri + vi[0], py = patch[1]*ri + vi[1],
+            pz = patch[2]*ri + vi[2], pr = patch[3]*ri + SR_PATCH_EPS;
+        // the points in this patch that are not padding
+        const unsigned points = n_points - j0 >= SR_PATCH_SIZE ?
+            (1u << SR_PATCH_SIZE) - 1 : (1u << (n_points - j0)) - 1;
+        unsigned exposed = points;
+
+        for (int kk = -1; exposed && kk < nni; ++kk) {
+            // kk == -1 is the neighbor that last buried a point
+            const int k = kk < 0 ? current_nb : kk;
+            double dx, dy, dz, d2;
+            if (kk < 0 && nni == 0) break;
+            dx = nx[k] - px; dy = ny[k] - py; dz = nz[k] - pz;
+            d2 = dx*dx + dy*dy + dz*dz;
+            // no point in patch reached
+            if (d2 > (nr[k] + pr)*(nr[k] + pr)) continue;
+            // all points in patch buried
+            if (nr[k] > pr && d2 < (nr[k] - pr)*(nr[k] - pr)) {
+                exposed = 0;
+                current_nb = k;
+                break;
+            }
+            for (int b = 0; b < SR_PATCH_SIZE && j0 + b < n_padded; b += SR_SIMD_WIDTH) {
+                const int j = j0 + b;
+                unsigned block_buried;
+                if (((exposed >> b) & ((1u << SR_SIMD_WIDTH) - 1)) == 0) continue;
+                block_buried = (exposed >> b) &
+                    sr_block_buried(tx+j, ty+j, tz+j, nx[k], ny[k], nz[k], nr2[k]);
+                if (block_buried) {
+                    exposed &= ~(block_buried << b);
                     current_nb = k;
-                    break;
                 }
             }
-            // we have gone through the whole list without overlap
-            if (k == nni) spcount[j] = 1;
+        }
+        // SR_PATCH_SIZE divides 64, patches don't straddle words
+        buried[j0/64] |= (uint64_t)(points & ~exposed) << (j0%64);
+    }
+    for (int w = 0; w < sr->n_words; ++w) {
+        n_buried += sr_popcount(buried[w]);
+    }
+    return (4.0*M_PI*ri*ri*(n_points - n_buried))/n_points;
+}
+
+/**
+    A neighbor at distance d in direction u buries the test points p
+    of atom i that satisfy |ri p - d u| <= rj, i.e. p·u >= c with
+
+        c = (ri^2 + d^2 - rj^2) / (2 ri d),
+
+    a spherical cap around u. Instead of testing each point, the
+    bitmask of the points in the cap is looked up in the table, with
+    u and c rounded to the nearest tabulated values, and the masks of
+    all neighbors are OR:ed together. The quantization means points
+    close to the edge of a cap can be misclassified, the error is
+    small compared to the discretization error of the test points
+    themselves for up to a few hundred points.
+ */
+static double
+sr_lut_atom_area(int i,
+                 int row,
+                 const sr_data *sr,
+                 struct sr_scratch *scratch)
+{
+    const int n_points = sr->n_points;
+    const int n_words = sr->n_words;
+    const int nni = sr->nb->nn[row];
+    const nb_pair * restrict nbi = sr->nb->pair + sr->nb->first[row];
+    const double ri = sr->r[i], ri2 = ri*ri;
+    const double * restrict r = sr->r;
+    const double * restrict v = freesasa_coord_all(sr->xyz);
+    const double * restrict vi = v+3*i;
+    const uint64_t * restrict lut = sr->lut;
+    uint64_t * restrict buried = sr->buried ?
+        sr->buried + (size_t)i*n_words : scratch->buried;
+    int n_buried = 0;
+
+    memset(buried, 0, sizeof(uint64_t)*n_words);
+
+    for (int k = 0; k < nni; ++k) {
+        const int a = nbi[k].j;
+        const double dx = v[3*a] - vi[0], dy = v[3*a+1] - vi[1],
+            dz = v[3*a+2] - vi[2], d2 = dx*dx + dy*dy + dz*dz;
+        const uint64_t *mask;
+        double c;
+        int level;
+
+        if (d2 == 0) {
+            // concentric spheres, all or nothing
+            if (ri2 > r[a]*r[a]) continue;
+            sr_mask_all(buried, n_points);
+            break;
+        }
+        c = (ri2 + d2 - r[a]*r[a]) / (2 * ri * sqrt(d2));
+        if (c > 1) continue;
+        if (c <= -1) {
+            sr_mask_all(buried, n_points);
+            break;
+        }
+        level = (c + 1) * 0.5 * (SR_LUT_LEVELS - 1) + 0.5;
+        mask = lut + ((size_t)sr_lut_direction(dx, dy, dz)*SR_LUT_LEVELS + level)*n_words;
+        for (int w = 0; w < n_words; ++w) {
+            buried[w] |= mask[w];
         }
     }
-    for (int k = 0; k < n_points; ++k) {
-        if (spcount[k]) ++n_surface;
+    for (int w = 0; w < n_words; ++w) {
+        n_buried += sr_popcount(buried[w]);
     }
-    freesasa_coord_free(tp_coord_ri);
-    return (4.0*M_PI*ri*ri*n_surface)/n_points;
+    return (4.0*M_PI*ri*ri*(n_points - n_buried))/n_points;
 }
@@ -5,21 +5,61 @@
 #include <errno.h>
 #include "freesasa_internal.h"
 #include "pdb.h"
+#include "cif.h"
 #include "classifier.h"
 #include "coord.h"
 
+/**
+    The strings of an atom. Names are interned in the string pool of
+    the structure, the descriptor and the line are allocated in its
+    arena. The descriptor is NULL until it has been asked for. Before
+    an atom is added to a structure, the strings are borrowed from the
+    caller (and the line isn't null-terminated).
+ */
 struct atom {
-    char *res_name;
-    char *res_number;
-    char *atom_name;
-    char *symbol;
+    const char *res_name;
+    const char *res_number;
+    const char *atom_name;
+    const char *symbol;
     char *descriptor;
     char *line;
     char chain_label;
+    int sasa_class; // class according to freesasa_structure::classifier
 };
 
 static const struct atom empty_atom =
-     {NULL, NULL, NULL, NULL, NULL, NULL, '\0'};
+     {NULL, NULL, NULL, NULL, NULL, NULL, '\0', 0};
+
+#define STRUCTURE_LINE_STRL 54 //!< The part of PDB lines that is stored
+#define ARENA_FIRST_BLOCK 4096 //!< Size of the first block of an arena
+#define ARENA_MAX_BLOCK (1 << 20) //!< Blocks don't grow beyond this size
+
+//! A block of memory in an arena
+struct arena_block {
+    struct arena_block *prev; //!< The previous, full, block
+    size_t size; //!< Size of data
+    size_t used; //!< Number of bytes used
+    double data[]; //!< The memory (double for alignment)
+};
+
+/**
+    Bump allocator for the atoms of a structure. Memory is allocated
+    from blocks that grow geometrically, and is only freed all at once.
+ */
+struct arena {
+    struct arena_block *block; //!< The current block
+};
+
+/**
+    Pool of interned strings, a hash table with linear probing. Atom
+    and residue names, residue numbers and symbols only have a limited
+    number of distinct values, each is stored only once.
+ */
+struct string_pool {
+    const char **string; //!< The table, NULL for empty entries
+    int size; //!< Size of the table, a power of two
+    int n; //!< Number of strings
+};
 
 struct freesasa_structure {
     struct atom **a;
@@ -33,103 +73,180 @@ struct freesasa_structure {
     int *res_first_atom; // first atom of each residue
     int *chain_first_atom; // first atom of each chain
     char **res_desc;
+    int atom_capacity; // allocated size of a and radius
+    int residue_capacity; // allocated size of res_first_atom and res_desc
+    const freesasa_classifier *classifier; // built-in classifier of the atom classes, or NULL
+    struct arena arena; // atoms and their strings
+    struct string_pool pool; // names
 };
 
 static const struct freesasa_structure empty_structure = 
-    {NULL,NULL,NULL,0,0,0,0,NULL,NULL,NULL,NULL};
+    {NULL,NULL,NULL,0,0,0,0,NULL,NULL,NULL,NULL,0,0,NULL,{NULL},{NULL,0,0}};
 
-static int
-guess_symbol(char *symbol,
-             const char *name);
+static void *
+arena_alloc(struct arena *arena,
+            size_t size)
+{
+    struct arena_block *b = arena->block, *nb;
+    size_t block_size;
+    void *p;
+
+    // keep all allocations aligned as doubles
+    size = (size + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+
+    if (b == NULL || b->size - b->used < size) {
+        block_size = b ? 2*b->size : ARENA_FIRST_BLOCK;
+        if (block_size > ARENA_MAX_BLOCK) block_size = ARENA_MAX_BLOCK;
+        if (block_size < size) block_size = size;
+        nb = malloc(sizeof(struct arena_block) + block_size);
+        if (nb == NULL) {
+            mem_fail();
+            return NULL;
+        }
+        nb->prev = b;
+        nb->size = block_size;
+        nb->used = 0;
+        arena->block = b = nb;
+    }
+    p = (char*)b->data + b->used;
+    b->used += size;
+    return p;
+}
 
 static void
-atom_free(struct atom *a)
+arena_free(struct arena *arena)
 {
-    if (a == NULL) return;
-    free(a->res_name);
-    free(a->res_number);
-    free(a->atom_name);
-    free(a->symbol);
-    free(a->descriptor);
-    free(a->line);
-    free(a);
+    struct arena_block *b = arena->block, *prev;
+    while (b) {
+        prev = b->prev;
+        free(b);
+        b = prev;
+    }
+    arena->block = NULL;
 }
 
-static struct atom *
-atom_new(const char *residue_name,
-         const char *residue_number,
-         const char *atom_name,
-         const char *symbol,
-         char chain_label)
+//! Stores a copy of the first len characters of str in the arena, null-terminated
+static char *
+arena_strndup(struct arena *arena,
+              const char *str,
+              size_t len)
 {
-    struct atom *a = malloc(sizeof(struct atom));
-    int dlen = 0;
-    if (a == NULL) { 
-        mem_fail(); 
-        return NULL; 
-    }
+    char *copy = arena_alloc(arena, len + 1);
+    if (copy == NULL) return NULL;
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+    return copy;
+}
 
-    *a = empty_atom;
+//! FNV-1a hash of a string
+static unsigned int
+string_hash(const char *str)
+{
+    unsigned int h = 2166136261u;
+    for (; *str; ++str) h = (h ^ (unsigned char)*str) * 16777619u;
+    return h;
+}
 
-    a->line = NULL;
-    a->chain_label = chain_label;
+//! Doubles the size of the pool (or creates it), and rehashes the strings
+static int
+string_pool_grow(struct string_pool *pool)
+{
+    int size = pool->size > 0 ? 2*pool->size : 64;
+    const char **string = malloc(sizeof(char*)*size);
+    unsigned int h;
+
+    if (string == NULL) return mem_fail();
+    for (int i = 0; i < size; ++i) string[i] = NULL;
+    for (int i = 0; i < pool->size; ++i) {
+        if (pool->string[i] == NULL) continue;
+        h = string_hash(pool->string[i]) & (size - 1);
+        while (string[h] != NULL) h = (h + 1) & (size - 1);
+        string[h] = pool->string[i];
+    }
+    free(pool->string);
+    pool->string = string;
+    pool->size = size;
+    return FREESASA_SUCCESS;
+}
 
-    a->res_name = strdup(residue_name);
-    a->res_number = strdup(residue_number);
-    a->atom_name = strdup(atom_name);
-    a->symbol = strdup(symbol);
+/**
+    Returns the interned copy of str, it is copied to the arena the
+    first time it is seen. Identical strings get the same pointer.
+    Returns NULL if memory allocation fails.
+ */
+static const char *
+string_pool_intern(struct string_pool *pool,
+                   struct arena *arena,
+                   const char *str)
+{
+    unsigned int h, mask;
+    char *copy;
 
-    dlen = strlen(residue_number) + strlen(residue_name)
-        + strlen(atom_name) + 4;
-    a->descriptor = malloc(dlen+1);
+    if (2*(pool->n + 1) > pool->size && string_pool_grow(pool)) return NULL;
 
-    if (!a->res_name || !a->res_number || !a->atom_name ||
-        !a->symbol || !a->descriptor) {
-        mem_fail();
-        atom_free(a);
-        return NULL;
+    mask = pool->size - 1;
+    for (h = string_hash(str) & mask; pool->string[h] != NULL; h = (h + 1) & mask) {
+        if (strcmp(pool->string[h], str) == 0) return pool->string[h];
     }
+    copy = arena_strndup(arena, str, strlen(str));
+    if (copy == NULL) return NULL;
+    pool->string[h] = copy;
+    ++pool->n;
+    return copy;
+}
 
-    sprintf(a->descriptor,"%c %s %s %s",
-            chain_label,residue_number,residue_name,atom_name);
+static int
+guess_symbol(char *symbol,
+             const char *name);
 
-    return a;
+static void
+atom_init(struct atom *a,
+          const char *residue_name,
+          const char *residue_number,
+          const char *atom_name,
+          const char *symbol,
+          char chain_label)
+{
+    *a = empty_atom;
+    a->res_name = residue_name;
+    a->res_number = residue_number;
+    a->atom_name = atom_name;
+    a->symbol = symbol;
+    a->chain_label = chain_label;
 }
 
+/**
+    Stores a copy of the atom in the structure's arena, with interned
+    names and a copy of the line of length len (unless line is
+    NULL). The descriptor is created when it is first asked for.
+    Returns NULL if memory allocation fails.
+ */
 static struct atom *
-atom_new_from_line(const char *line,
-                   char *alt_label) 
+structure_store_atom(freesasa_structure *s,
+                     const struct atom *borrowed,
+                     const char *line,
+                     size_t len)
 {
-    assert(line);
-    const int buflen = strlen(line);
-    int flag;
-    struct atom *a;
-    char aname[buflen], rname[buflen], rnumber[buflen], symbol[buflen];
-
-    if (alt_label) *alt_label = freesasa_pdb_get_alt_coord_label(line);
-
-    freesasa_pdb_get_atom_name(aname, line);
-    freesasa_pdb_get_res_name(rname, line);
-    freesasa_pdb_get_res_number(rnumber, line);
+    struct atom *a = arena_alloc(&s->arena, sizeof(struct atom));
 
-    flag = freesasa_pdb_get_symbol(symbol, line);
-    if (flag == FREESASA_FAIL) guess_symbol(symbol,aname);
-
-    a = atom_new(rname, rnumber, aname, symbol, freesasa_pdb_get_chain_label(line));
-    
     if (a == NULL) return NULL;
+    *a = *borrowed;
 
-    a->line = strdup(line);
-    
-    if (a->line == NULL) {
-        mem_fail();
-        atom_free(a);
+    if (!(a->res_name = string_pool_intern(&s->pool, &s->arena, borrowed->res_name)) ||
+        !(a->res_number = string_pool_intern(&s->pool, &s->arena, borrowed->res_number)) ||
+        !(a->atom_name = string_pool_intern(&s->pool, &s->arena, borrowed->atom_name)) ||
+        !(a->symbol = string_pool_intern(&s->pool, &s->arena, borrowed->symbol)))
+        return NULL;
+
+    // the columns after the coordinates are not needed for output
+    if (len > STRUCTURE_LINE_STRL) len = STRUCTURE_LINE_STRL;
+    if (line != NULL && (a->line = arena_strndup(&s->arena, line, len)) == NULL)
         return NULL;
-    }
 
     return a;
 }
 
+
 freesasa_structure*
 freesasa_structure_new(void)
 {
@@ -161,17 +278,12 @@ void
 freesasa_structure_free(freesasa_structure *s)
 {
     if (s == NULL) return;
-    if (s->a) {
-        for (int i = 0; i < s->number_atoms; ++i) 
-            if (s->a[i]) atom_free(s->a[i]);
-        free(s->a);
-    }
+    // the atoms and all strings are in the arena
+    free(s->a);
     if (s->xyz) freesasa_coord_free(s->xyz);
-    if (s->res_desc) {
-        for (int i = 0; i < s->number_residues; ++i)
-            if (s->res_desc[i]) free(s->res_desc[i]);
-       free(s->res_desc);
-    }
+    free(s->res_desc);
+    arena_free(&s->arena);
+    free(s->pool.string);
     free(s->radius);
     free(s->res_first_atom);
     free(s->chain_first_atom);
@@ -239,29 +351,72 @@ structure_add_chain(freesasa_structure *s,
     return FREESASA_SUCCESS;
 }
 
+/**
+    Makes room for at least n atoms in the arrays of atoms and radii.
+    The arrays are left as they were if memory allocation fails.
+ */
 static int
-structure_add_residue(freesasa_structure *s, const struct atom *a, int i)
+structure_reserve_atoms(freesasa_structure *s,
+                        int n)
 {
-    int n = s->number_residues+1;
-    int *rfa = s->res_first_atom;
-    char **rd = s->res_desc;
+    double *radius;
+    struct atom **a;
 
-    rfa = realloc(rfa, sizeof(int) * n);
-    if (!rfa) return mem_fail();
-    rfa[n-1] = i;
+    if (n <= s->atom_capacity) return FREESASA_SUCCESS;
+
+    if ((radius = realloc(s->radius, sizeof(double)*n)) == NULL) return mem_fail();
+    s->radius = radius;
+    if ((a = realloc(s->a, sizeof(struct atom*)*n)) == NULL) return mem_fail();
+    s->a = a;
+    s->atom_capacity = n;
+
+    return FREESASA_SUCCESS;
+}
+
+static int
+structure_reserve_residues(freesasa_structure *s,
+                           int n)
+{
+    int *rfa;
+    char **rd;
+
+    if (n <= s->residue_capacity) return FREESASA_SUCCESS;
+
+    if ((rfa = realloc(s->res_first_atom, sizeof(int)*n)) == NULL) return mem_fail();
     s->res_first_atom = rfa;
+    if ((rd = realloc(s->res_desc, sizeof(char*)*n)) == NULL) return mem_fail();
+    s->res_desc = rd;
+    s->residue_capacity = n;
 
-    rd = realloc(rd, sizeof(char*)*n);
-    if (!rd) return mem_fail();
+    return FREESASA_SUCCESS;
+}
+
+//! The capacity to grow to when an array of size n is full
+static int
+grow_capacity(int n)
+{
+    return n < 32 ? 64 : 2*n;
+}
+
+static int
+structure_add_residue(freesasa_structure *s, const struct atom *a, int i)
+{
+    int n = s->number_residues+1;
+    int *rfa;
+    char **rd;
 
-    rd[n-1] = malloc(strlen(a->res_number) + strlen(a->res_name)+4);
-    if (!rd[n-1]) {
-        free(rd);
+    if (n > s->residue_capacity &&
+        structure_reserve_residues(s, grow_capacity(s->residue_capacity)))
         return mem_fail();
-    }
+
+    rfa = s->res_first_atom;
+    rfa[n-1] = i;
+
+    rd = s->res_desc;
+    rd[n-1] = arena_alloc(&s->arena, strlen(a->res_number) + strlen(a->res_name)+4);
+    if (!rd[n-1]) return mem_fail();
     sprintf(rd[n-1], "%c %s %s", a->chain_label, a->res_number, a->res_name);
 
-    s->res_desc = rd;
     ++s->number_residues;
 
     return FREESASA_SUCCESS;
@@ -273,7 +428,7 @@ structure_add_residue(freesasa_structure *s, const struct atom *a, int i)
  */
 static int
 structure_check_atom_radius(double *radius,
-                            struct atom *a,
+                            const struct atom *a,
                             const freesasa_classifier* classifier,
                             int options)
 {
@@ -304,23 +459,37 @@ structure_check_atom_radius(double *radius,
     return FREESASA_SUCCESS;
 }
 
+//! Returns 1 if the classifier is one of the built-in ones, 0 else
+static int
+structure_builtin_classifier(const freesasa_classifier *classifier)
+{
+    return classifier == &freesasa_protor_classifier ||
+        classifier == &freesasa_naccess_classifier ||
+        classifier == &freesasa_oons_classifier ||
+        classifier == &freesasa_residue_classifier ||
+        classifier == &freesasa_backbone_classifier;
+}
+
 /**
    Adds an atom to the structure using the rules specified by
    'options'. If it includes FREESASA_RADIUS_FROM_* a dummy radius is
    assigned and the caller is expected to replace it with a correct
-   radius later.
+   radius later. The strings of the atom are copied to the structure
+   if it is kept, as is the line of length len (if not NULL).
  */
 static int
 structure_add_atom(freesasa_structure *s,
-                   struct atom *a,
+                   const struct atom *borrowed,
+                   const char *line,
+                   size_t len,
                    double *xyz,
                    const freesasa_classifier* classifier,
                    int options)
 {
-    assert(s); assert(a); assert(xyz);
+    assert(s); assert(borrowed); assert(xyz);
     int na, ret;
-    double r, *pr = s->radius;
-    struct atom **pa = s->a;
+    double r;
+    struct atom *a;
     
     if (classifier == NULL) {
         classifier = &freesasa_default_classifier;
@@ -330,26 +499,34 @@ structure_add_atom(freesasa_structure *s,
     if (options & FREESASA_RADIUS_FROM_OCCUPANCY) {
         r = 1; // fix it later
     } else {
-        ret = structure_check_atom_radius(&r, a, classifier, options);
+        ret = structure_check_atom_radius(&r, borrowed, classifier, options);
         if (ret == FREESASA_FAIL) return fail_msg("Halting at unknown atom.");
         if (ret == FREESASA_WARN) return FREESASA_WARN;
     }
     assert(r >= 0);
 
+    if ((a = structure_store_atom(s, borrowed, line, len)) == NULL) return mem_fail();
+
+    /* Classify the atom while the structure can still be modified,
+       but only for the built-in classifiers, which can be identified
+       by their address. Structures built with more than one
+       classifier store no classes. */
+    if (s->number_atoms == 0) {
+        s->classifier = structure_builtin_classifier(classifier) ? classifier : NULL;
+    } else if (classifier != s->classifier) {
+        s->classifier = NULL;
+    }
+    a->sasa_class = s->classifier ?
+        classifier->sasa_class(a->res_name, a->atom_name, classifier) : FREESASA_WARN;
+
     // if it's a keeper store the radius
     na = s->number_atoms+1;
-    if ((s->radius = realloc(s->radius,sizeof(double)*na)) == NULL) {
-        s->radius = pr;
+    if (na > s->atom_capacity &&
+        structure_reserve_atoms(s, grow_capacity(s->atom_capacity)))
         return mem_fail();
-    }
     s->radius[na-1] = r;
 
-    // allocate memory for atom, add chain
-    if ((s->a = realloc(s->a,sizeof(struct atom*)*na)) == NULL) {
-        s->a = pa;
-        return mem_fail();
-    }
-
+    // add coordinates and chain
     if (freesasa_coord_append(s->xyz, xyz, 1)) return mem_fail();
     if (structure_add_chain(s, a->chain_label, na - 1)) return mem_fail();
 
@@ -358,7 +535,7 @@ structure_add_atom(freesasa_structure *s,
        from the previous one */
     if ( s->number_residues == 0 ||
          (na > 1 && 
-          (strcmp(a->res_number, s->a[na-2]->res_number) ||
+          (a->res_number != s->a[na-2]->res_number || // interned
            a->chain_label != s->a[na-2]->chain_label) )) {
         if (structure_add_residue(s, a, na - 1)) return mem_fail();
     }
@@ -370,6 +547,113 @@ structure_add_atom(freesasa_structure *s,
     return FREESASA_SUCCESS;
 }
 
+/**
+    Keeps track of which alternate location is used (the first one
+    encountered). Returns 1 if an atom with the alternate location
+    label alt should be included, 0 else.
+ */
+static int
+keep_alt_location(char alt,
+                  char *the_alt)
+{
+    if ((alt != ' ' && *the_alt == ' ') || (alt == ' '))
+        *the_alt = alt;
+    else if (alt != ' ' && alt != *the_alt)
+        return 0;
+
+    return 1;
+}
+
+/**
+    Checks if an ATOM or HETATM line should be included according to
+    the options, and which alternate location is used. Returns 1 for
+    lines to include, 0 else.
+ */
+static int
+pdb_keep_atom_line(const char *line,
+                   size_t len,
+                   char *the_alt,
+                   int options)
+{
+    if (!freesasa_pdb_is_atom_line(line, len, options & FREESASA_INCLUDE_HETATM))
+        return 0;
+
+    // hydrogen or deuterium, lines that are too short are dropped too
+    if (!(options & FREESASA_INCLUDE_HYDROGEN) &&
+        (len < 14 || line[12] == 'H' || line[13] == 'H' ||
+         line[12] == 'D' || line[13] == 'D'))
+        return 0;
+
+    return keep_alt_location(len > 16 ? line[16] : ' ', the_alt);
+}
+
+/**
+    Adds the atom of an ATOM or HETATM line (that should be kept) to
+    the structure. Returns FREESASA_WARN if the atom was skipped,
+    FREESASA_FAIL if the line can't be read or malloc failure,
+    FREESASA_SUCCESS else.
+ */
+static int
+structure_add_pdb_line(freesasa_structure *s,
+                       const char *line,
+                       size_t len,
+                       const freesasa_classifier *classifier,
+                       int options)
+{
+    struct pdb_atom fields;
+    struct atom a;
+    double r;
+    int ret;
+
+    if (freesasa_pdb_parse_atom(&fields, line, len) == FREESASA_FAIL)
+        return FREESASA_FAIL;
+    if (fields.symbol[0] == '\0') guess_symbol(fields.symbol, fields.name);
+    atom_init(&a, fields.res_name, fields.res_number, fields.name,
+              fields.symbol, fields.chain_label);
+
+    ret = structure_add_atom(s, &a, line, len, fields.xyz, classifier, options);
+    if (ret != FREESASA_SUCCESS) return ret; // skipped or failed
+
+    if (options & FREESASA_RADIUS_FROM_OCCUPANCY) {
+        if (freesasa_pdb_parse_occupancy(&r, line, len) == FREESASA_FAIL)
+            return FREESASA_FAIL;
+        s->radius[s->number_atoms-1] = r;
+    }
+
+    return FREESASA_SUCCESS;
+}
+
+/**
+    Reads atoms from the reader into the structure, until the end of
+    the model (unless the models are joined) or the end of the
+    reader's input. Returns FREESASA_FAIL if problems reading input or
+    malloc failure, FREESASA_SUCCESS else.
+ */
+static int
+structure_read_pdb(freesasa_structure *s,
+                   struct pdb_reader *reader,
+                   const freesasa_classifier *classifier,
+                   int options)
+{
+    const char *line;
+    size_t len;
+    char the_alt = ' ';
+
+    while ((line = freesasa_pdb_reader_next(reader, &len)) != NULL) {
+
+        if (pdb_keep_atom_line(line, len, &the_alt, options) &&
+            structure_add_pdb_line(s, line, len, classifier, options) == FREESASA_FAIL)
+            return FREESASA_FAIL;
+
+        if (! (options & FREESASA_JOIN_MODELS)) {
+            freesasa_pdb_parse_model(&s->model, line, len);
+            if (strncmp("ENDMDL",line,6)==0) break;
+        }
+    }
+
+    return reader->error ? FREESASA_FAIL : FREESASA_SUCCESS;
+}
+
 /**
     Handles the reading of PDB-files, returns NULL if problems reading
     or input or malloc failure. Error-messages should explain what
@@ -377,67 +661,32 @@ structure_add_atom(freesasa_structure *s,
  */
 static freesasa_structure*
 from_pdb_impl(FILE *pdb_file,
-              struct file_range it,
               const freesasa_classifier *classifier,
               int options)
 {
     assert(pdb_file);
-    size_t len = PDB_LINE_STRL;
-    char *line = NULL;
-    char alt, the_alt = ' ';
-    double v[3], r;
-    struct atom *a = NULL;
     freesasa_structure *s = freesasa_structure_new();
- 
-    if (s == NULL) return NULL;
-    
-    fseek(pdb_file,it.begin,SEEK_SET);
-    
-    while (getline(&line, &len, pdb_file) != -1 && ftell(pdb_file) <= it.end) {
-        
-        if (strncmp("ATOM",line,4)==0 || ( (options & FREESASA_INCLUDE_HETATM) &&
-                                           (strncmp("HETATM", line, 6) == 0) )) {
-
-            if (freesasa_pdb_ishydrogen(line) &&
-                !(options & FREESASA_INCLUDE_HYDROGEN))
-                continue;
+    struct pdb_reader reader;
+    int ret;
 
-            if (!(a = atom_new_from_line(line, &alt))) goto cleanup;
-
-            if ((alt != ' ' && the_alt == ' ') || (alt == ' '))
-                the_alt = alt;
-            else if (alt != ' ' && alt != the_alt)
-                continue;
+    if (s == NULL) return NULL;
 
-            if (freesasa_pdb_get_coord(v, line) == FREESASA_FAIL ||
-                structure_add_atom(s, a, v, classifier, options) == FREESASA_FAIL) 
-                goto cleanup;
+    rewind(pdb_file);
 
-            if (options & FREESASA_RADIUS_FROM_OCCUPANCY) {
-                if (freesasa_pdb_get_occupancy(&r, line) == FREESASA_FAIL) 
-                    goto cleanup;
-                s->radius[s->number_atoms-1] = r;
-            }
-        }
+    if (freesasa_pdb_reader_open(&reader, pdb_file)) goto cleanup;
+    ret = structure_read_pdb(s, &reader, classifier, options);
+    freesasa_pdb_reader_close(&reader);
+    if (ret) goto cleanup;
 
-        if (! (options & FREESASA_JOIN_MODELS)) {
-            if (strncmp("MODEL",line,5)==0)  sscanf(line+10, "%d", &s->model);
-            if (strncmp("ENDMDL",line,6)==0) break;
-        }
-    }
-    
     if (s->number_atoms == 0) {
         freesasa_fail("Input had no valid ATOM or HETATM lines.");
         goto cleanup;
     }
 
-    free(line);
     return s;
 
  cleanup:
     fail_msg("");
-    free(line);
-    atom_free(a);
     freesasa_structure_free(s);
     return NULL;
 }
@@ -456,7 +705,7 @@ freesasa_structure_add_atom_wopt(freesasa_structure *structure,
     assert(structure);
     assert(atom_name); assert(residue_name); assert(residue_number);
 
-    struct atom *a;
+    struct atom a;
     char symbol[PDB_ATOM_SYMBOL_STRL+1];
     double v[3] = {x,y,z};
     int ret, warn = 0;
@@ -468,15 +717,11 @@ freesasa_structure_add_atom_wopt(freesasa_structure *structure,
         options & FREESASA_SKIP_UNKNOWN) 
         ++warn;
 
-    a = atom_new(residue_name, residue_number, atom_name, symbol, chain_label);
-    if (a == NULL) return mem_fail();
+    atom_init(&a, residue_name, residue_number, atom_name, symbol, chain_label);
 
-    ret = structure_add_atom(structure, a, v, classifier, options);
+    ret = structure_add_atom(structure, &a, NULL, 0, v, classifier, options);
 
-    if (ret == FREESASA_FAIL) {
-        atom_free(a);
-        return ret;
-    }
+    if (ret == FREESASA_FAIL) return ret;
 
     if (warn) return FREESASA_WARN;
 
@@ -495,14 +740,294 @@ freesasa_structure_add_atom(freesasa_structure *structure,
                                             chain_label, x, y, z, NULL, 0);
 }
 
+int
+freesasa_structure_reserve(freesasa_structure *structure,
+                           int n_atoms)
+{
+    assert(structure);
+    assert(n_atoms >= 0);
+
+    if (structure_reserve_atoms(structure, n_atoms) ||
+        freesasa_coord_reserve(structure->xyz, n_atoms))
+        return fail_msg("");
+
+    return FREESASA_SUCCESS;
+}
+
+int
+freesasa_structure_add_atoms(freesasa_structure *structure,
+                             int n,
+                             const char **atom_names,
+                             const char **residue_names,
+                             const char **residue_numbers,
+                             const char *chain_labels,
+                             const double *xyz,
+                             const freesasa_classifier *classifier,
+                             int options)
+{
+    assert(structure);
+    assert(atom_names); assert(residue_names); assert(residue_numbers);
+    assert(chain_labels); assert(xyz);
+    assert(n >= 0);
+
+    int ret, warn = 0;
+
+    if (freesasa_structure_reserve(structure, structure->number_atoms + n))
+        return fail_msg("");
+
+    for (int i = 0; i < n; ++i) {
+        ret = freesasa_structure_add_atom_wopt(structure, atom_names[i], residue_names[i],
+                                               residue_numbers[i], chain_labels[i],
+                                               xyz[3*i], xyz[3*i+1], xyz[3*i+2],
+                                               classifier, options);
+        if (ret == FREESASA_FAIL) return ret;
+        if (ret == FREESASA_WARN) ++warn;
+    }
+
+    if (warn) return FREESASA_WARN;
+
+    return FREESASA_SUCCESS;
+}
+
 freesasa_structure *
 freesasa_structure_from_pdb(FILE *pdb_file,
                             const freesasa_classifier* classifier,
                             int options)
 {
     assert(pdb_file);
-    return from_pdb_impl(pdb_file, freesasa_whole_file(pdb_file),
-                         classifier, options);
+    return from_pdb_impl(pdb_file, classifier, options);
+}
+
+struct freesasa_trajectory {
+    struct pdb_reader reader;
+    freesasa_structure *structure;
+    nb_verlet *verlet; // neighbor lists, created at first calculation
+    double skin;
+    int options;
+    int n_frames; // frames read so far
+};
+
+void
+freesasa_trajectory_free(freesasa_trajectory *t)
+{
+    if (t) {
+        freesasa_structure_free(t->structure);
+        freesasa_nb_verlet_free(t->verlet);
+        freesasa_pdb_reader_close(&t->reader);
+        free(t);
+    }
+}
+
+freesasa_trajectory *
+freesasa_trajectory_from_pdb(FILE *pdb,
+                             const freesasa_classifier *classifier,
+                             int options)
+{
+    assert(pdb);
+
+    freesasa_trajectory *t;
+
+    if (options & (FREESASA_JOIN_MODELS | FREESASA_SEPARATE_MODELS |
+                   FREESASA_SEPARATE_CHAINS)) {
+        freesasa_fail("in %s(): the options FREESASA_JOIN_MODELS, "
+                      "FREESASA_SEPARATE_MODELS and FREESASA_SEPARATE_CHAINS "
+                      "can't be used for trajectories", __func__);
+        return NULL;
+    }
+
+    t = malloc(sizeof(freesasa_trajectory));
+    if (t == NULL) {
+        mem_fail();
+        return NULL;
+    }
+    t->structure = NULL;
+    t->verlet = NULL;
+    t->skin = FREESASA_DEF_TRAJECTORY_SKIN;
+    t->options = options;
+    t->n_frames = 0;
+
+    // the first frame is read like any structure, but without seeking
+    if (freesasa_pdb_reader_open(&t->reader, pdb)) {
+        free(t);
+        fail_msg("");
+        return NULL;
+    }
+    t->structure = freesasa_structure_new();
+    if (t->structure == NULL ||
+        structure_read_pdb(t->structure, &t->reader, classifier, options))
+        goto cleanup;
+    if (t->structure->number_atoms == 0) {
+        freesasa_fail("Input had no valid ATOM or HETATM lines.");
+        goto cleanup;
+    }
+
+    return t;
+
+ cleanup:
+    fail_msg("");
+    freesasa_trajectory_free(t);
+    return NULL;
+}
+
+const freesasa_structure *
+freesasa_trajectory_structure(const freesasa_trajectory *t)
+{
+    assert(t);
+    return t->structure;
+}
+
+int
+freesasa_trajectory_set_skin(freesasa_trajectory *t,
+                             double skin)
+{
+    assert(t);
+    if (skin < 0)
+        return freesasa_fail("in %s(): skin %f is negative", __func__, skin);
+    t->skin = skin;
+    freesasa_nb_verlet_free(t->verlet);
+    t->verlet = NULL;
+    return FREESASA_SUCCESS;
+}
+
+freesasa_result *
+freesasa_trajectory_calc(freesasa_trajectory *t,
+                         const freesasa_parameters *parameters)
+{
+    assert(t);
+    freesasa_result *result;
+
+    if (t->verlet == NULL) {
+        t->verlet = freesasa_nb_verlet_new(t->skin);
+        if (t->verlet == NULL) {
+            fail_msg("");
+            return NULL;
+        }
+    }
+    result = freesasa_calc_verlet(t->structure->xyz, t->structure->radius,
+                                  t->verlet, parameters);
+    if (result == NULL) fail_msg("");
+    return result;
+}
+
+/**
+    Checks if the atom in the line is the atom a (same atom name,
+    residue, chain and insertion code), ignoring the alternate
+    location.
+ */
+static int
+pdb_line_is_atom(const char *line,
+                 const struct atom *a)
+{
+    return a->line != NULL &&
+        strncmp(line+12, a->line+12, 4) == 0 &&
+        strncmp(line+17, a->line+17, 10) == 0;
+}
+
+int
+freesasa_trajectory_next(freesasa_trajectory *t)
+{
+    assert(t);
+
+    freesasa_structure *s = t->structure;
+    const int n = s->number_atoms;
+    int k = 0, in_model = 0;
+    char the_alt = ' ';
+    const char *line;
+    size_t len;
+    struct pdb_atom fields;
+
+    // the structure already holds the first frame
+    if (t->n_frames == 0) {
+        ++t->n_frames;
+        return 1;
+    }
+
+    while ((line = freesasa_pdb_reader_next(&t->reader, &len)) != NULL) {
+        if (strncmp("MODEL",line,5)==0) {
+            freesasa_pdb_parse_model(&s->model, line, len);
+            in_model = 1;
+        }
+        if (strncmp("ENDMDL",line,6)==0) break;
+        if (len < 27 || !pdb_keep_atom_line(line, len, &the_alt, t->options))
+            continue;
+        in_model = 1;
+        /* atoms that don't match the next atom of the first frame were
+           skipped there (unknown atoms for example) */
+        if (k == n || !pdb_line_is_atom(line, s->a[k])) continue;
+        if (freesasa_pdb_parse_atom(&fields, line, len) == FREESASA_FAIL)
+            return fail_msg("");
+        freesasa_coord_set_i(s->xyz, k, fields.xyz);
+        ++k;
+    }
+
+    if (t->reader.error) return fail_msg("");
+    if (!in_model) return 0;
+    if (k < n) {
+        return freesasa_fail("in %s(): frame %d only has %d of the %d atoms "
+                             "of the first frame", __func__, t->n_frames + 1, k, n);
+    }
+    ++t->n_frames;
+    return 1;
+}
+
+//! The structures read by freesasa_structure_array()
+struct structure_array {
+    freesasa_structure **ss;
+    int n;
+    int capacity;
+};
+
+static void
+structure_array_clear(struct structure_array *sa)
+{
+    for (int i = 0; i < sa->n; ++i) freesasa_structure_free(sa->ss[i]);
+    sa->n = 0;
+}
+
+//! Appends a new structure, the array doubles in size when it's full
+static freesasa_structure *
+structure_array_append(struct structure_array *sa,
+                       int model)
+{
+    freesasa_structure *s, **ss;
+
+    if (sa->n == sa->capacity) {
+        const int capacity = sa->capacity > 0 ? 2*sa->capacity : 4;
+        ss = realloc(sa->ss, sizeof(freesasa_structure*)*capacity);
+        if (ss == NULL) {
+            mem_fail();
+            return NULL;
+        }
+        sa->ss = ss;
+        sa->capacity = capacity;
+    }
+    if ((s = freesasa_structure_new()) == NULL) return NULL;
+    s->model = model;
+    sa->ss[sa->n++] = s;
+    return s;
+}
+
+/**
+    Checks the structures of a model that has been read, the
+    structures starting at index first. A model without atoms is an
+    error, unless the chains are separated, then it's skipped. A
+    structure without atoms is always an error.
+ */
+static int
+structure_array_end_model(const struct structure_array *sa,
+                          int first,
+                          int model,
+                          int options)
+{
+    if (sa->n == first) {
+        if (options & FREESASA_SEPARATE_CHAINS)
+            return freesasa_warn("in freesasa_structure_array(): "
+                                 "No chains found (in model %d).", model);
+        return freesasa_fail("Input had no valid ATOM or HETATM lines.");
+    }
+    if (sa->ss[sa->n-1]->number_atoms == 0)
+        return freesasa_fail("Input had no valid ATOM or HETATM lines.");
+    return FREESASA_SUCCESS;
 }
 
 freesasa_structure **
@@ -514,11 +1039,15 @@ freesasa_structure_array(FILE *pdb,
     assert(pdb);
     assert(n);
 
-    struct file_range *models = NULL, *chains = NULL;
-    struct file_range whole_file;
-    int n_models = 0, n_chains = 0, j0, n_new_chains;
-    freesasa_structure **ss = NULL, **ssb, *s;
+    struct structure_array sa = {NULL, 0, 0};
+    struct pdb_reader reader;
+    freesasa_structure *s = NULL; // the structure atoms are added to
+    const char *line;
+    size_t len;
+    int n_models = 0, in_model = 0, model = 0, model_first = 0;
+    char chain = '\0', the_alt = ' ';
 
+    *n = 0;
     if( ! (options & FREESASA_SEPARATE_MODELS ||
            options & FREESASA_SEPARATE_CHAINS) ) {
         fail_msg("Options need to specify at least one of FREESASA_SEPARATE_CHAINS "
@@ -526,87 +1055,235 @@ freesasa_structure_array(FILE *pdb,
         return NULL;
     }
 
-    whole_file = freesasa_whole_file(pdb);
-    n_models = freesasa_pdb_get_models(pdb,&models);
-
-    if (n_models == FREESASA_FAIL) {
-        fail_msg("Problems reading PDB-file.");
+    /* All models and chains are read in one pass. A new structure is
+       started at each MODEL, or, if the chains are separated, at each
+       ATOM (or HETATM) line where the chain label changes. */
+    rewind(pdb);
+    if (freesasa_pdb_reader_open(&reader, pdb)) {
+        fail_msg("");
         return NULL;
     }
-    if (n_models == 0) {
-        models = &whole_file;
-        n_models = 1;
+
+    while ((line = freesasa_pdb_reader_next(&reader, &len)) != NULL) {
+        if (strncmp("MODEL",line,5)==0) {
+            if (in_model) goto mismatch;
+            // if there are models, atoms outside of them are ignored
+            if (n_models == 0) structure_array_clear(&sa);
+            ++n_models;
+            in_model = 1;
+            model = 0;
+            freesasa_pdb_parse_model(&model, line, len);
+            model_first = sa.n;
+            s = NULL;
+            continue;
+        }
+        if (strncmp("ENDMDL",line,6)==0) {
+            if (!in_model) goto mismatch;
+            if (structure_array_end_model(&sa, model_first, n_models, options)
+                == FREESASA_FAIL) goto cleanup;
+            in_model = 0;
+            s = NULL;
+            //only keep first model if option not provided
+            if (! (options & FREESASA_SEPARATE_MODELS) ) break;
+            continue;
+        }
+        if ((n_models > 0 && !in_model) ||
+            !freesasa_pdb_is_atom_line(line, len, options & FREESASA_INCLUDE_HETATM))
+            continue;
+
+        if (s == NULL || ((options & FREESASA_SEPARATE_CHAINS) &&
+                          (len > 21 ? line[21] : '\0') != chain)) {
+            if (s != NULL && s->number_atoms == 0) {
+                freesasa_fail("Input had no valid ATOM or HETATM lines.");
+                goto cleanup;
+            }
+            if ((s = structure_array_append(&sa, model)) == NULL) goto cleanup;
+            chain = len > 21 ? line[21] : '\0';
+            the_alt = ' ';
+        }
+
+        if (pdb_keep_atom_line(line, len, &the_alt, options) &&
+            structure_add_pdb_line(s, line, len, classifier, options) == FREESASA_FAIL)
+            goto cleanup;
     }
 
-    //only keep first model if option not provided
-    if (! (options & FREESASA_SEPARATE_MODELS) ) n_models = 1;
+    if (reader.error) goto cleanup;
 
-    //for each model read chains if requested
-    if (options & FREESASA_SEPARATE_CHAINS) {
-        for (int i = 0; i < n_models; ++i) {
-            chains = NULL;
-            n_new_chains = freesasa_pdb_get_chains(pdb, models[i], &chains, options);
+    // a file without models is one model, the last model may lack ENDMDL
+    if ((n_models == 0 || in_model) &&
+        structure_array_end_model(&sa, model_first, n_models > 0 ? n_models : 1,
+                                  options) == FREESASA_FAIL)
+        goto cleanup;
 
-            if (n_new_chains == FREESASA_FAIL) goto cleanup;
-            if (n_new_chains == 0) {
-                freesasa_warn("in %s(): No chains found (in model %d).", __func__, i+1);
-                continue;
-            }
+    if (sa.n == 0) goto empty;
 
-            ssb = ss;
-            ss = realloc(ss,sizeof(freesasa_structure*)*(n_chains + n_new_chains));
+    freesasa_pdb_reader_close(&reader);
+    *n = sa.n;
+    return sa.ss;
 
-            if (!ss) {
-                ss = ssb;
-                mem_fail();
-                goto cleanup;
-            }
+ mismatch:
+    freesasa_fail("in %s(): Mismatch between MODEL and ENDMDL in input", __func__);
+ cleanup:
+    fail_msg("Problems reading PDB-file.");
+ empty:
+    freesasa_pdb_reader_close(&reader);
+    structure_array_clear(&sa);
+    free(sa.ss);
+    return NULL;
+}
 
-            j0 = n_chains;
-            n_chains += n_new_chains;
+/**
+    Adds an atom from an mmCIF file to the structure. Returns
+    FREESASA_WARN if the atom was skipped, FREESASA_FAIL if there is
+    no occupancy to use as radius or malloc failure, FREESASA_SUCCESS
+    else.
+ */
+static int
+structure_add_cif_atom(freesasa_structure *s,
+                       struct cif_atom *fields,
+                       const freesasa_classifier *classifier,
+                       int options)
+{
+    struct atom a;
+    int ret;
 
-            for (int j = 0; j < n_new_chains; ++j) ss[j0+j] = NULL;
+    if (fields->symbol[0] == '\0') guess_symbol(fields->symbol, fields->name);
 
-            for (int j = 0; j < n_new_chains; ++j) {
-                s = from_pdb_impl(pdb, chains[j], classifier, options);
-                if (s == NULL) goto cleanup;
-                ss[j0+j] = s;
-                ss[j0+j]->model = ss[n_chains-n_new_chains]->model;
-            }
+    atom_init(&a, fields->res_name, fields->res_number, fields->name,
+              fields->symbol, fields->chain_label);
 
-            free(chains);
-        }
-        *n = n_chains;
-    } else {
-        ss = malloc(sizeof(freesasa_structure*)*n_models);
-        if (!ss) {
-            mem_fail();
-            goto cleanup;
+    ret = structure_add_atom(s, &a, NULL, 0, fields->xyz, classifier, options);
+    if (ret != FREESASA_SUCCESS) return ret; // skipped or failed
+
+    if (options & FREESASA_RADIUS_FROM_OCCUPANCY) {
+        if (!fields->has_occupancy)
+            return freesasa_fail("in %s(): atom '%s %s' has no occupancy.",
+                                 __func__, fields->res_name, fields->name);
+        s->radius[s->number_atoms-1] = fields->occupancy;
+    }
+
+    return FREESASA_SUCCESS;
+}
+
+/**
+    Reads the atoms of an mmCIF file into the array, in one pass. A
+    new structure is started at each model if the models are
+    separated, and at each chain if the chains are separated. Unless
+    the models are separated or joined, only the first model is
+    read. Returns FREESASA_FAIL if problems reading input or malloc
+    failure, FREESASA_SUCCESS else.
+ */
+static int
+structure_array_read_cif(struct structure_array *sa,
+                         FILE *cif,
+                         const freesasa_classifier *classifier,
+                         int options)
+{
+    struct cif_reader reader;
+    struct cif_atom atom;
+    freesasa_structure *s = NULL; // the structure atoms are added to
+    char chain[CIF_VALUE_STRL+1] = "", the_alt = ' ';
+    int model = 0, ret;
+
+    if (freesasa_cif_reader_open(&reader, cif)) return fail_msg("");
+
+    while ((ret = freesasa_cif_reader_next(&reader, &atom)) == 1) {
+        if (atom.hetatm && !(options & FREESASA_INCLUDE_HETATM)) continue;
+
+        if (s != NULL && atom.model != model &&
+            !(options & (FREESASA_SEPARATE_MODELS | FREESASA_JOIN_MODELS)))
+            break;
+
+        if (s == NULL ||
+            ((options & FREESASA_SEPARATE_MODELS) && atom.model != model) ||
+            ((options & FREESASA_SEPARATE_CHAINS) && strcmp(atom.chain, chain))) {
+            if (s != NULL && s->number_atoms == 0) {
+                ret = freesasa_fail("Input had no valid ATOM or HETATM lines.");
+                break;
+            }
+            if ((s = structure_array_append(sa, atom.model)) == NULL) {
+                ret = FREESASA_FAIL;
+                break;
+            }
+            strcpy(chain, atom.chain);
+            the_alt = ' ';
         }
+        model = atom.model;
 
-        for (int i = 0; i < n_models; ++i) ss[i] = NULL;
-        *n = n_models;
+        if ((atom.hydrogen && !(options & FREESASA_INCLUDE_HYDROGEN)) ||
+            !keep_alt_location(atom.alt_label, &the_alt))
+            continue;
 
-        for (int i = 0; i < n_models; ++i) {
-            s = from_pdb_impl(pdb, models[i], classifier, options);
-            if (s == NULL) goto cleanup;
-            ss[i] = s;
+        if (structure_add_cif_atom(s, &atom, classifier, options) == FREESASA_FAIL) {
+            ret = FREESASA_FAIL;
+            break;
         }
     }
 
-    if (*n == 0) goto cleanup;
+    freesasa_cif_reader_close(&reader);
 
-    if (models != &whole_file) free(models);
+    if (ret == FREESASA_FAIL) return fail_msg("Problems reading mmCIF-file.");
 
-    return ss;
+    if (sa->n == 0 || sa->ss[sa->n-1]->number_atoms == 0)
+        return freesasa_fail("Input had no valid ATOM or HETATM lines.");
+
+    return FREESASA_SUCCESS;
+}
+
+freesasa_structure *
+freesasa_structure_from_cif(FILE *cif,
+                            const freesasa_classifier *classifier,
+                            int options)
+{
+    assert(cif);
+
+    struct structure_array sa = {NULL, 0, 0};
+    freesasa_structure *s = NULL;
+
+    options &= ~(FREESASA_SEPARATE_MODELS | FREESASA_SEPARATE_CHAINS);
+
+    if (structure_array_read_cif(&sa, cif, classifier, options) == FREESASA_SUCCESS) {
+        assert(sa.n == 1);
+        s = sa.ss[0];
+    } else {
+        fail_msg("");
+        structure_array_clear(&sa);
+    }
+    free(sa.ss);
+
+    return s;
+}
+
+freesasa_structure **
+freesasa_structure_array_from_cif(FILE *cif,
+                                  int *n,
+                                  const freesasa_classifier *classifier,
+                                  int options)
+{
+    assert(cif);
+    assert(n);
+
+    struct structure_array sa = {NULL, 0, 0};
 
- cleanup:
-    if (ss) for (int i = 0; i < *n; ++i) freesasa_structure_free(ss[i]);
-    if (models != &whole_file) free(models);
-    free(chains);
     *n = 0;
-    free(ss);
-    return NULL;
+    if( ! (options & FREESASA_SEPARATE_MODELS ||
+           options & FREESASA_SEPARATE_CHAINS) ) {
+        fail_msg("Options need to specify at least one of FREESASA_SEPARATE_CHAINS "
+                 "and FREESASA_SEPARATE_MODELS.");
+        return NULL;
+    }
+    // as for PDB input, models can't be joined here
+    options &= ~FREESASA_JOIN_MODELS;
+
+    if (structure_array_read_cif(&sa, cif, classifier, options)) {
+        fail_msg("");
+        structure_array_clear(&sa);
+        free(sa.ss);
+        return NULL;
+    }
+
+    *n = sa.n;
+    return sa.ss;
 }
 
 freesasa_structure*
@@ -747,7 +1424,21 @@ freesasa_structure_atom_descriptor(const freesasa_structure *structure,
 {
     assert(structure);
     assert(i < structure->number_atoms && i >= 0);
-    return structure->a[i]->descriptor;
+    // creating the descriptor doesn't change the contents of the structure
+    freesasa_structure *s = (freesasa_structure*) structure;
+    struct atom *a = s->a[i];
+
+    if (a->descriptor == NULL) {
+        a->descriptor = arena_alloc(&s->arena, strlen(a->res_number) + strlen(a->res_name)
+                                    + strlen(a->atom_name) + 5);
+        if (a->descriptor == NULL) {
+            mem_fail();
+            return NULL;
+        }
+        sprintf(a->descriptor,"%c %s %s %s",
+                a->chain_label, a->res_number, a->res_name, a->atom_name);
+    }
+    return a->descriptor;
 }
 
 int
@@ -777,6 +1468,26 @@ freesasa_structure_residue_descriptor(const freesasa_structure *structure,
     return structure->res_desc[r_i];
 }
 
+void
+freesasa_structure_atom_classes(const freesasa_structure *s,
+                                const freesasa_classifier *classifier,
+                                int *atom_class)
+{
+    assert(s);
+    assert(classifier);
+    assert(atom_class || s->number_atoms == 0);
+
+    if (classifier == s->classifier) {
+        for (int i = 0; i < s->number_atoms; ++i)
+            atom_class[i] = s->a[i]->sasa_class;
+        return;
+    }
+    for (int i = 0; i < s->number_atoms; ++i) {
+        atom_class[i] = classifier->sasa_class(s->a[i]->res_name, s->a[i]->atom_name,
+                                               classifier);
+    }
+}
+
 const char*
 freesasa_structure_residue_name(const freesasa_structure *structure,
                                 int r_i)
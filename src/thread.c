@@ -0,0 +1,308 @@
+#include <assert.h>
+#include <stdlib.h>
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+#if USE_THREADS
+# include <pthread.h>
+#endif
+
+#include "freesasa_internal.h"
+#include "thread.h"
+
+#if USE_THREADS
+//! The queue shared by the threads working on one task
+struct thread_queue {
+    pthread_mutex_t lock;
+    int next; // first item not handed out yet
+    int n_items;
+    int chunk_size;
+    freesasa_thread_task task;
+    void *arg;
+};
+
+struct thread_arg {
+    struct thread_queue *queue;
+    int thread;
+};
+#endif /* USE_THREADS */
+
+struct freesasa_thread_pool {
+    int n_threads; // including the calling thread
+#if USE_THREADS
+    int n_created; // number of threads started by the pool
+    pthread_t *thread;
+    pthread_mutex_t run_lock; // held while a task is being run
+    pthread_mutex_t lock; // protects the fields below
+    pthread_cond_t start; // signals new task, or quit
+    pthread_cond_t done; // signals that a thread is done with the task
+    unsigned long generation; // incremented for each new task
+    int n_active; // threads that take part in the current task
+    int n_running; // pool threads still working on the current task
+    int quit;
+    struct thread_queue *queue; // the current task
+#endif
+};
+
+#if USE_THREADS
+//! Arguments to a thread in a pool
+struct pool_arg {
+    freesasa_thread_pool *pool;
+    int thread;
+};
+
+/**
+    Takes the next chunk from the queue, stores its range in begin
+    and end. Returns 0 if there are no items left.
+ */
+static int
+thread_next_chunk(struct thread_queue *queue,
+                  int *begin,
+                  int *end)
+{
+    pthread_mutex_lock(&queue->lock);
+    *begin = queue->next;
+    if (queue->n_items - queue->next > queue->chunk_size)
+        queue->next += queue->chunk_size;
+    else
+        queue->next = queue->n_items;
+    *end = queue->next;
+    pthread_mutex_unlock(&queue->lock);
+    return *begin < *end;
+}
+
+static void *
+thread_worker(void *arg)
+{
+    struct thread_arg *ta = arg;
+    struct thread_queue *queue = ta->queue;
+    int begin, end;
+
+    while (thread_next_chunk(queue, &begin, &end)) {
+        queue->task(begin, end, ta->thread, queue->arg);
+    }
+    return NULL;
+}
+
+static int
+thread_run_parallel(int n_threads,
+                    struct thread_queue *queue)
+{
+    pthread_t thread[n_threads];
+    struct thread_arg targ[n_threads];
+    int res, threads_created = 1, return_value = FREESASA_SUCCESS;
+
+    for (int t = 0; t < n_threads; ++t) {
+        targ[t].queue = queue;
+        targ[t].thread = t;
+    }
+    // thread 0 is the calling thread
+    for (int t = 1; t < n_threads; ++t) {
+        res = pthread_create(&thread[t], NULL, thread_worker, &targ[t]);
+        if (res) {
+            return_value = freesasa_warn("%s(): %s, only using %d threads",
+                                         __func__, freesasa_thread_error(res),
+                                         threads_created);
+            break;
+        }
+        ++threads_created;
+    }
+    thread_worker(&targ[0]);
+    for (int t = 1; t < threads_created; ++t) {
+        res = pthread_join(thread[t], NULL);
+        if (res) {
+            return_value = freesasa_warn("%s(): %s", __func__,
+                                         freesasa_thread_error(res));
+        }
+    }
+
+    return return_value;
+}
+
+//! Main loop of the threads in a pool, waits for tasks until told to quit
+static void *
+pool_worker(void *arg)
+{
+    freesasa_thread_pool *pool = ((struct pool_arg *) arg)->pool;
+    const int thread = ((struct pool_arg *) arg)->thread;
+    unsigned long seen = 0; // the pool starts at generation 0
+
+    free(arg);
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->generation == seen) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->quit) break;
+        seen = pool->generation;
+        if (thread < pool->n_active) {
+            struct thread_arg ta = {.queue = pool->queue, .thread = thread};
+            pthread_mutex_unlock(&pool->lock);
+            thread_worker(&ta);
+            pthread_mutex_lock(&pool->lock);
+            if (--pool->n_running == 0) pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static void
+thread_run_pool(freesasa_thread_pool *pool,
+                int n_threads,
+                struct thread_queue *queue)
+{
+    struct thread_arg ta = {.queue = queue, .thread = 0};
+
+    pthread_mutex_lock(&pool->run_lock);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->queue = queue;
+    pool->n_active = n_threads;
+    pool->n_running = n_threads - 1;
+    ++pool->generation;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    thread_worker(&ta);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->n_running > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pool->queue = NULL;
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&pool->run_lock);
+}
+#endif /* USE_THREADS */
+
+freesasa_thread_pool *
+freesasa_thread_pool_new(int n_threads)
+{
+    freesasa_thread_pool *pool;
+
+    if (n_threads < 1) {
+        freesasa_fail("in %s(): n_threads = %d is invalid, must be > 0",
+                      __func__, n_threads);
+        return NULL;
+    }
+
+    pool = malloc(sizeof(freesasa_thread_pool));
+    if (pool == NULL) {
+        mem_fail();
+        return NULL;
+    }
+
+#if USE_THREADS
+    pool->n_threads = n_threads;
+    pool->n_created = 0;
+    pool->generation = 0;
+    pool->n_active = pool->n_running = 0;
+    pool->quit = 0;
+    pool->queue = NULL;
+    pool->thread = malloc(sizeof(pthread_t)*n_threads);
+    if (pool->thread == NULL) {
+        free(pool);
+        mem_fail();
+        return NULL;
+    }
+    pthread_mutex_init(&pool->run_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    // thread 0 is the calling thread
+    for (int t = 1; t < n_threads; ++t) {
+        struct pool_arg *arg = malloc(sizeof(struct pool_arg));
+        int res;
+        if (arg == NULL) {
+            mem_fail();
+            freesasa_thread_pool_free(pool);
+            return NULL;
+        }
+        arg->pool = pool;
+        arg->thread = t;
+        res = pthread_create(&pool->thread[t], NULL, pool_worker, arg);
+        if (res) {
+            free(arg);
+            fail_msg(freesasa_thread_error(res));
+            freesasa_thread_pool_free(pool);
+            return NULL;
+        }
+        ++pool->n_created;
+    }
+#else
+    if (n_threads > 1) {
+        freesasa_warn("in %s(): program compiled for single-threaded use, "
+                      "but multiple threads were requested. Pool will only "
+                      "use the calling thread.", __func__);
+    }
+    pool->n_threads = 1;
+#endif
+
+    return pool;
+}
+
+void
+freesasa_thread_pool_free(freesasa_thread_pool *pool)
+{
+    if (pool == NULL) return;
+
+#if USE_THREADS
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (int t = 1; t <= pool->n_created; ++t) {
+        pthread_join(pool->thread[t], NULL);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->run_lock);
+    free(pool->thread);
+#endif
+    free(pool);
+}
+
+int
+freesasa_thread_pool_size(const freesasa_thread_pool *pool)
+{
+    assert(pool);
+    return pool->n_threads;
+}
+
+int
+freesasa_thread_run(freesasa_thread_pool *pool,
+                    int n_threads,
+                    int n_items,
+                    int chunk_size,
+                    freesasa_thread_task task,
+                    void *arg)
+{
+    assert(task);
+
+    if (chunk_size < 1) chunk_size = 1;
+
+#if USE_THREADS
+    // no need to involve other threads if there is only one chunk
+    if (n_threads > 1 && n_items > chunk_size) {
+        int return_value = FREESASA_SUCCESS;
+        struct thread_queue queue = {.next = 0, .n_items = n_items,
+                                     .chunk_size = chunk_size,
+                                     .task = task, .arg = arg};
+        pthread_mutex_init(&queue.lock, NULL);
+        if (pool) {
+            assert(n_threads <= pool->n_threads);
+            thread_run_pool(pool, n_threads, &queue);
+        } else {
+            return_value = thread_run_parallel(n_threads, &queue);
+        }
+        pthread_mutex_destroy(&queue.lock);
+        return return_value;
+    }
+#endif
+    if (n_items > 0) task(0, n_items, 0, arg);
+    return FREESASA_SUCCESS;
+}
@@ -0,0 +1,73 @@
+#ifndef FREESASA_THREAD_H
+#define FREESASA_THREAD_H
+
+/**
+    @file
+
+    Scheduler for the parallel parts of the calculations. The items
+    (typically atoms) are handed out to the threads in chunks from a
+    shared queue, a thread that finishes its chunk takes the next one
+    instead of waiting for the others. This balances the load also
+    when the cost per item varies a lot, as it does between buried and
+    exposed atoms.
+
+    The threads are either created for each task, or taken from a
+    ::freesasa_thread_pool (see freesasa.h).
+ */
+
+#include "freesasa.h"
+
+/**
+    Function that processes the items in the interval [begin,end).
+
+    @param begin First item.
+    @param end One past the last item.
+    @param thread Index of the thread calling the function, between 0
+      and n_threads-1. Can be used to access per-thread work space.
+    @param arg Pointer passed to freesasa_thread_run().
+ */
+typedef void (*freesasa_thread_task)(int begin, int end, int thread, void *arg);
+
+/**
+    Process n_items items using n_threads threads.
+
+    The items are handed out in chunks of chunk_size items at a time,
+    in order, until all are done. The calling thread takes part in
+    the calculation, and has index 0. If only one thread is used, or
+    the library is compiled without thread support, task is called
+    once for all items.
+
+    If some threads can't be created the remaining ones do all the
+    work.
+
+    @param pool If not NULL, the threads are taken from this pool,
+      else they are created for this task.
+    @param n_threads Number of threads, at most the size of the pool.
+    @param n_items Number of items.
+    @param chunk_size Number of items handed to a thread at a time,
+      values < 1 are interpreted as 1.
+    @param task The function that does the work.
+    @param arg Argument passed to task.
+    @return ::FREESASA_SUCCESS. ::FREESASA_WARN if not all threads
+      could be created (with error message), all items will still have
+      been processed.
+ */
+int
+freesasa_thread_run(freesasa_thread_pool *pool,
+                    int n_threads,
+                    int n_items,
+                    int chunk_size,
+                    freesasa_thread_task task,
+                    void *arg);
+
+/**
+    Number of threads a pool uses in each calculation, including the
+    calling thread.
+
+    @param pool The pool.
+    @return The number of threads.
+ */
+int
+freesasa_thread_pool_size(const freesasa_thread_pool *pool);
+
+#endif /* FREESASA_THREAD_H */
@@ -4,11 +4,13 @@
 #include <check.h>
 
 extern Suite* pdb_suite();
+extern Suite* cif_suite();
 extern Suite* classifier_suite();
 extern Suite* coord_suite();
 extern Suite* structure_suite();
 extern Suite* sasa_suite();
 extern Suite* nb_suite();
+extern Suite* thread_suite();
 extern Suite* selector_suite();
 
 int main(int argc, char **argv) {
@@ -16,11 +18,13 @@ int main(int argc, char **argv) {
 
     // Suites added in order of complexity
     SRunner *sr = srunner_create(pdb_suite());
+    srunner_add_suite(sr,cif_suite());
     srunner_add_suite(sr,classifier_suite());
     srunner_add_suite(sr,coord_suite());
     srunner_add_suite(sr,structure_suite());
     srunner_add_suite(sr,sasa_suite());
     srunner_add_suite(sr,nb_suite());
+    srunner_add_suite(sr,thread_suite());
     srunner_add_suite(sr,selector_suite());
 
     srunner_run_all(sr,CK_VERBOSE);
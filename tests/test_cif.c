@@ -0,0 +1,148 @@
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <cif.h>
+#include <check.h>
+#include "tools.h"
+
+START_TEST (test_cif_reader)
+{
+    FILE *cif = fopen(DATADIR "syntax.cif", "r");
+    struct cif_reader reader;
+    struct cif_atom a;
+    ck_assert_ptr_ne(cif, NULL);
+
+    ck_assert_int_eq(freesasa_cif_reader_open(&reader, cif), FREESASA_SUCCESS);
+
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 1);
+    ck_assert_str_eq(a.name, " N  ");
+    ck_assert_str_eq(a.res_name, "ALA");
+    ck_assert_str_eq(a.res_number, "   1");
+    ck_assert_str_eq(a.symbol, " N");
+    ck_assert_str_eq(a.chain, "A");
+    ck_assert_int_eq(a.chain_label, 'A');
+    ck_assert_int_eq(a.alt_label, ' ');
+    ck_assert_int_eq(a.hetatm, 0);
+    ck_assert_int_eq(a.hydrogen, 0);
+    ck_assert_int_eq(a.model, 1);
+    ck_assert_int_eq(a.has_occupancy, 1);
+    ck_assert(a.occupancy == 1.0);
+    ck_assert(a.xyz[0] == 1.0 && a.xyz[1] == 2.0 && a.xyz[2] == 3.0);
+
+    // row spanning two lines, with a comment
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 1);
+    ck_assert_str_eq(a.name, " CA ");
+    ck_assert(a.xyz[0] == 1.5 && a.xyz[1] == 2.5 && a.xyz[2] == 3.5);
+
+    // quoted value, exponent, uncertainty and alternate locations
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 1);
+    ck_assert_str_eq(a.name, " O5'");
+    ck_assert_int_eq(a.alt_label, 'A');
+    ck_assert(a.xyz[0] == -12.5 && a.xyz[1] == 0 && a.xyz[2] == 0.5);
+    ck_assert(a.occupancy == 0.5);
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 1);
+    ck_assert_int_eq(a.alt_label, 'B');
+
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 1);
+    ck_assert_int_eq(a.hydrogen, 1);
+
+    // two-letter element, missing values and a long chain id
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 1);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+    ck_assert_str_eq(a.name, "FE  ");
+    ck_assert_str_eq(a.symbol, "FE");
+    ck_assert_str_eq(a.res_number, "    ");
+    ck_assert_str_eq(a.chain, "BB");
+    ck_assert_int_eq(a.chain_label, 'B');
+    ck_assert_int_eq(a.hetatm, 1);
+    ck_assert_int_eq(a.has_occupancy, 0);
+
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 1);
+    ck_assert_int_eq(a.model, 2);
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 1);
+    ck_assert_str_eq(a.chain, "C");
+
+    // the end of the loop
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 0);
+    ck_assert_int_eq(freesasa_cif_reader_next(&reader, &a), 0);
+    freesasa_cif_reader_close(&reader);
+
+    // input without atoms
+    freopen(DATADIR "1ubq.pdb", "r", cif);
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    ck_assert_int_eq(freesasa_cif_reader_open(&reader, cif), FREESASA_FAIL);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+    fclose(cif);
+}
+END_TEST
+
+//! Reads all rows of the string, returns the number of atoms or FREESASA_FAIL
+static int
+read_cif_string(const char *str)
+{
+    FILE *tmp = tmpfile();
+    struct cif_reader reader;
+    struct cif_atom a;
+    int n = 0, ret;
+
+    fputs(str, tmp);
+    rewind(tmp);
+    if (freesasa_cif_reader_open(&reader, tmp) == FREESASA_SUCCESS) {
+        while ((ret = freesasa_cif_reader_next(&reader, &a)) == 1) ++n;
+        if (ret == FREESASA_FAIL) n = FREESASA_FAIL;
+        freesasa_cif_reader_close(&reader);
+    } else {
+        n = FREESASA_FAIL;
+    }
+    fclose(tmp);
+    return n;
+}
+
+START_TEST (test_cif_errors)
+{
+    const char *header =
+        "data_x\nloop_\n_atom_site.label_atom_id\n_atom_site.label_comp_id\n"
+        "_atom_site.Cartn_x\n_atom_site.Cartn_y\n_atom_site.Cartn_z\n";
+    char buf[1000];
+
+    sprintf(buf, "%sN ALA 1 2 3\nCA ALA 4 5 6\n", header);
+    ck_assert_int_eq(read_cif_string(buf), 2);
+    // the last line without newline
+    sprintf(buf, "%sN ALA 1 2 3\nCA ALA 4 5 6", header);
+    ck_assert_int_eq(read_cif_string(buf), 2);
+    sprintf(buf, "%sN ALA 1 2 3\nloop_\n_x.y\n1\n", header);
+    ck_assert_int_eq(read_cif_string(buf), 1);
+
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    // incomplete row
+    sprintf(buf, "%sN ALA 1 2 3\nCA ALA 4 5\n", header);
+    ck_assert_int_eq(read_cif_string(buf), FREESASA_FAIL);
+    sprintf(buf, "%sN ALA 1 2 3\nCA ALA 4 5\n_x.y 1\n", header);
+    ck_assert_int_eq(read_cif_string(buf), FREESASA_FAIL);
+    // coordinates that can't be read
+    sprintf(buf, "%sN ALA 1 2 a\n", header);
+    ck_assert_int_eq(read_cif_string(buf), FREESASA_FAIL);
+    sprintf(buf, "%sN ALA 1 2 ?\n", header);
+    ck_assert_int_eq(read_cif_string(buf), FREESASA_FAIL);
+    // missing atom name
+    sprintf(buf, "%s. ALA 1 2 3\n", header);
+    ck_assert_int_eq(read_cif_string(buf), FREESASA_FAIL);
+    // no coordinates in the loop
+    ck_assert_int_eq(read_cif_string("data_x\nloop_\n_atom_site.label_atom_id\n"
+                                     "_atom_site.label_comp_id\nN ALA\n"),
+                     FREESASA_FAIL);
+    ck_assert_int_eq(read_cif_string(""), FREESASA_FAIL);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+}
+END_TEST
+
+Suite *cif_suite() {
+    Suite *s = suite_create("mmCIF-parser");
+    TCase *tc_core = tcase_create("Core");
+    tcase_add_test(tc_core, test_cif_reader);
+    tcase_add_test(tc_core, test_cif_errors);
+    suite_add_tcase(s, tc_core);
+
+    return s;
+}
@@ -400,6 +400,69 @@ START_TEST (test_user)
 }
 END_TEST
 
+START_TEST (test_user_many_residues)
+{
+    FILE *f = tmpfile();
+    freesasa_classifier *c;
+    char res_name[10], atom_name[10];
+    const int n_res = 500, n_atoms = 10;
+
+    fputs("types:\nA 1.0 a\nB 2.0 b\nC 3.0 c\natoms:\n", f);
+    for (int i = 0; i < n_res; ++i) {
+        for (int j = 0; j < n_atoms; ++j)
+            fprintf(f, "L%d A%d %s\n", i, j, (i+j) % 2 ? "A" : "B");
+    }
+    fputs("ANY A0 C\nANY X C\n", f);
+    rewind(f);
+    c = freesasa_classifier_from_file(f);
+    fclose(f);
+    ck_assert_ptr_ne(c, NULL);
+
+    for (int i = 0; i < n_res; ++i) {
+        for (int j = 0; j < n_atoms; ++j) {
+            sprintf(res_name, "L%d", i);
+            sprintf(atom_name, " A%d ", j);
+            ck_assert(c->radius(res_name, atom_name, c) == ((i+j) % 2 ? 1.0 : 2.0));
+            ck_assert_str_eq(c->class2str(c->sasa_class(res_name, atom_name, c), c),
+                             (i+j) % 2 ? "a" : "b");
+        }
+    }
+    // atoms that are only found in ANY
+    ck_assert(c->radius("L1", "X", c) == 3.0);
+    ck_assert(c->radius("UNK", " X  ", c) == 3.0);
+    ck_assert(c->radius("UNK", "A0", c) == 3.0);
+    ck_assert_str_eq(c->class2str(c->sasa_class("UNK", "X", c), c), "c");
+    // names that are prefixes of names in the configuration
+    ck_assert(c->radius("L1", "A", c) < 0);
+    ck_assert(c->radius("L", "A1", c) < 0);
+    ck_assert(c->radius("L1", "", c) < 0);
+    ck_assert(c->sasa_class("L1", "A10", c) == FREESASA_WARN);
+    freesasa_classifier_free(c);
+}
+END_TEST
+
+// every atom in the built-in classifiers can be found through the generated tables
+START_TEST (test_static_tables)
+{
+    const freesasa_classifier *c[] = {&freesasa_protor_classifier,
+                                      &freesasa_naccess_classifier,
+                                      &freesasa_oons_classifier};
+    for (int i = 0; i < 3; ++i) {
+        const struct classifier_config *config = c[i]->config;
+        int n = 0;
+        ck_assert_int_ge(config->table_size, 16);
+        for (int j = 0; j < config->n_residues; ++j) {
+            const struct classifier_residue *res = config->residue[j];
+            for (int k = 0; k < res->n_atoms; ++k, ++n) {
+                ck_assert(c[i]->radius(res->name, res->atom_name[k], c[i]) == res->atom_radius[k]);
+                ck_assert_int_eq(c[i]->sasa_class(res->name, res->atom_name[k], c[i]), res->atom_class[k]);
+            }
+        }
+        ck_assert_int_le(2*n, config->table_size);
+    }
+}
+END_TEST
+
 Suite* classifier_suite()
 {
     Suite *s = suite_create("Classify");
@@ -408,6 +471,8 @@ Suite* classifier_suite()
     tcase_add_test(tc_core,test_class);
     tcase_add_test(tc_core,test_residue);
     tcase_add_test(tc_core,test_user);
+    tcase_add_test(tc_core,test_user_many_residues);
+    tcase_add_test(tc_core,test_static_tables);
 
     tcase_add_checked_fixture(tc_core,setup,teardown);
 
@@ -71,6 +71,19 @@ START_TEST (test_coord)
     ck_assert(c2 != NULL);
     ck_assert_int_eq(freesasa_coord_append(c2,xyz2,1),FREESASA_SUCCESS);
     ck_assert(fabs(freesasa_coord_dist2_12(coord,c2,0,0) - 2));
+
+    // reserving room doesn't change the contents
+    ck_assert_int_eq(freesasa_coord_reserve(c2,100),FREESASA_SUCCESS);
+    ck_assert_int_eq(freesasa_coord_n(c2),1);
+    ck_assert(freesasa_coord_i(c2,0)[0] == 1);
+    for (int i = 1; i < 1000; ++i) {
+        double v[3] = {i, 0, 0};
+        ck_assert_int_eq(freesasa_coord_append(c2,v,1),FREESASA_SUCCESS);
+    }
+    ck_assert_int_eq(freesasa_coord_n(c2),1000);
+    for (int i = 1; i < 1000; ++i) ck_assert(freesasa_coord_i(c2,i)[0] == i);
+    ck_assert_int_eq(freesasa_coord_reserve(c2,10),FREESASA_SUCCESS);
+    ck_assert_int_eq(freesasa_coord_n(c2),1000);
     freesasa_coord_free(c2);
 }
 END_TEST
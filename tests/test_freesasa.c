@@ -223,6 +223,243 @@ START_TEST (test_sasa_1ubq)
 }
 END_TEST
 
+START_TEST (test_sr_buried)
+{
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    const coord_t *xyz = freesasa_structure_xyz(st);
+    const double *r = freesasa_structure_radius(st);
+    const int n = freesasa_structure_n(st),
+        n_points = parameters.shrake_rupley_n_points,
+        n_words = FREESASA_SR_MASK_WORDS(n_points);
+    double *sasa = malloc(sizeof(double)*n), *sasa_ref = malloc(sizeof(double)*n);
+    uint64_t *buried = malloc(sizeof(uint64_t)*n*n_words);
+    fclose(pdb);
+
+    ck_assert(freesasa_shrake_rupley(sasa_ref,xyz,r,&parameters) == FREESASA_SUCCESS);
+    ck_assert(freesasa_shrake_rupley_buried(sasa,buried,xyz,r,&parameters) == FREESASA_SUCCESS);
+
+    // the areas should follow from the number of buried points
+    for (int i = 0; i < n; ++i) {
+        const uint64_t *bi = buried + i*n_words;
+        const double ri = r[i] + parameters.probe_radius;
+        int n_buried = 0;
+        for (int j = 0; j < n_points; ++j) {
+            if (bi[j/64] & ((uint64_t)1 << (j%64))) ++n_buried;
+        }
+        // unused bits in the last word are never set
+        if (n_points % 64) ck_assert((bi[n_words-1] >> (n_points%64)) == 0);
+        ck_assert(sasa[i] == sasa_ref[i]);
+        ck_assert(fabs(sasa[i] - 4*M_PI*ri*ri*(n_points-n_buried)/n_points) < 1e-10);
+    }
+
+    free(buried);
+    free(sasa);
+    free(sasa_ref);
+    freesasa_structure_free(st);
+}
+END_TEST
+
+START_TEST (test_sr_lut)
+{
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    freesasa_parameters p = parameters;
+    freesasa_result *res, *res2;
+    double coord[3] = {0,0,0}, r[1] = {1.0};
+    fclose(pdb);
+
+    // an approximation, should be close to the exact S&R result
+    p.alg = FREESASA_SHRAKE_RUPLEY_LUT;
+    ck_assert((res = freesasa_calc_structure(st,&p)) != NULL);
+    ck_assert(rel_err(res->total, total_ref) < 5e-3);
+
+    // the second time the table is taken from the cache
+    ck_assert((res2 = freesasa_calc_structure(st,&p)) != NULL);
+    for (int i = 0; i < res->n_atoms; ++i) ck_assert(res2->sasa[i] == res->sasa[i]);
+    freesasa_result_free(res2);
+    p.shrake_rupley_n_points = 200;
+    ck_assert((res2 = freesasa_calc_structure(st,&p)) != NULL);
+    ck_assert(res2->total != res->total);
+    ck_assert(rel_err(res2->total, total_ref) < 5e-3);
+    p.shrake_rupley_n_points = parameters.shrake_rupley_n_points;
+    freesasa_result_free(res2);
+
+    // that replaced the cached table, the first one is built again
+    ck_assert((res2 = freesasa_calc_structure(st,&p)) != NULL);
+    for (int i = 0; i < res->n_atoms; ++i) ck_assert(res2->sasa[i] == res->sasa[i]);
+    freesasa_result_free(res2);
+    freesasa_result_free(res);
+
+    // isolated atoms should be exact
+    ck_assert((res = freesasa_calc_coord(coord,r,1,&p)) != NULL);
+    ck_assert(fabs(res->total - 4*M_PI*pow(1+p.probe_radius,2)) < 1e-10);
+    freesasa_result_free(res);
+
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    p.shrake_rupley_n_points = 1000;
+    ck_assert(freesasa_calc_structure(st,&p) == NULL);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+
+    freesasa_structure_free(st);
+}
+END_TEST
+
+START_TEST (test_lr_approx)
+{
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    freesasa_parameters p = parameters;
+    freesasa_result *res;
+    double coord[3] = {0,0,0}, r[1] = {1.0};
+    fclose(pdb);
+
+    // an approximation, should be very close to the exact L&R result
+    p.lee_richards_approx = 1;
+    ck_assert((res = freesasa_calc_structure(st,&p)) != NULL);
+    ck_assert(fabs(res->total - total_ref) < 1e-3);
+    ck_assert(rel_err(res->total, total_ref) < 1e-7);
+    freesasa_result_free(res);
+
+    // isolated atoms have no arcs, and should be exact
+    ck_assert((res = freesasa_calc_coord(coord,r,1,&p)) != NULL);
+    ck_assert(fabs(res->total - 4*M_PI*pow(1+p.probe_radius,2)) < 1e-10);
+    freesasa_result_free(res);
+
+    freesasa_structure_free(st);
+}
+END_TEST
+
+START_TEST (test_reorder_atoms)
+{
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    freesasa_parameters p = freesasa_default_parameters;
+    freesasa_result *res, *res_ord;
+    fclose(pdb);
+
+    // the order of the atoms in memory shouldn't change anything
+    for (int alg = 0; alg < 3; ++alg) {
+        p.alg = (freesasa_algorithm[]){FREESASA_LEE_RICHARDS,
+                                       FREESASA_SHRAKE_RUPLEY,
+                                       FREESASA_SHRAKE_RUPLEY_LUT}[alg];
+        p.reorder_atoms = 0;
+        ck_assert((res = freesasa_calc_structure(st,&p)) != NULL);
+        p.reorder_atoms = 1;
+        ck_assert((res_ord = freesasa_calc_structure(st,&p)) != NULL);
+        ck_assert_int_eq(res_ord->n_atoms, res->n_atoms);
+        for (int i = 0; i < res->n_atoms; ++i)
+            ck_assert(res_ord->sasa[i] == res->sasa[i]);
+        ck_assert(res_ord->total == res->total);
+        freesasa_result_free(res);
+        freesasa_result_free(res_ord);
+    }
+    freesasa_structure_free(st);
+}
+END_TEST
+
+START_TEST (test_calculation_move)
+{
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    const int n = freesasa_structure_n(st);
+    const double *radii = freesasa_structure_radius(st);
+    double *xyz = malloc(sizeof(double)*3*n), moved[9];
+    int atoms[3];
+    freesasa_parameters p = freesasa_default_parameters;
+    freesasa_calculation *calc;
+    const freesasa_result *res;
+    freesasa_result *ref;
+    fclose(pdb);
+
+    for (int alg = 0; alg < 3; ++alg) {
+        p.alg = (freesasa_algorithm[]){FREESASA_LEE_RICHARDS,
+                                       FREESASA_SHRAKE_RUPLEY,
+                                       FREESASA_SHRAKE_RUPLEY_LUT}[alg];
+        memcpy(xyz, freesasa_structure_coord_array(st), sizeof(double)*3*n);
+        ck_assert((calc = freesasa_calculation_new(xyz, radii, n, &p)) != NULL);
+
+        // move a few atoms at a time, some by a lot, one twice
+        for (int step = 0; step < 20; ++step) {
+            for (int k = 0; k < 3; ++k) {
+                atoms[k] = k < 2 ? (step*97 + k*31) % n : atoms[0];
+                for (int c = 0; c < 3; ++c)
+                    moved[3*k+c] = xyz[3*atoms[k]+c] + (step % 5 == 0 ? 15 : 0.7)*(c-k+0.5);
+            }
+            for (int k = 0; k < 3; ++k)
+                memcpy(xyz + 3*atoms[k], moved + 3*k, sizeof(double)*3);
+            ck_assert(freesasa_calculation_move(calc, atoms, moved, 3) == FREESASA_SUCCESS);
+
+            // identical to a new calculation, the total up to rounding
+            ck_assert((ref = freesasa_calc_coord(xyz, radii, n, &p)) != NULL);
+            res = freesasa_calculation_result(calc);
+            ck_assert_int_eq(res->n_atoms, n);
+            for (int i = 0; i < n; ++i)
+                ck_assert(res->sasa[i] == ref->sasa[i]);
+            ck_assert(fabs(res->total - ref->total) < 1e-12*ref->total);
+            freesasa_result_free(ref);
+        }
+
+        // bad index, nothing changes
+        atoms[0] = n;
+        freesasa_set_verbosity(FREESASA_V_SILENT);
+        ck_assert(freesasa_calculation_move(calc, atoms, moved, 1) == FREESASA_FAIL);
+        freesasa_set_verbosity(FREESASA_V_NORMAL);
+        ck_assert(freesasa_calculation_move(calc, atoms, moved, 0) == FREESASA_SUCCESS);
+        freesasa_calculation_free(calc);
+    }
+    free(xyz);
+    freesasa_structure_free(st);
+}
+END_TEST
+
+START_TEST (test_calculation_move_local)
+{
+    // atoms on a lattice, 10 Å apart, only moves that bring two
+    // atoms into contact recalculate more than the moved atom
+    const int n_small = 1000, n_large = 64000;
+    const double pos[3][3] = {{0.5, 0, 0}, {7, 0, 0}, {0, 0, 0}};
+    const int n_recalc[3] = {1, 2, 2};
+    double *xyz = malloc(sizeof(double)*3*n_large),
+        *radii = malloc(sizeof(double)*n_large);
+    int atom = 0;
+    freesasa_parameters p = freesasa_default_parameters;
+    freesasa_calculation *calc;
+
+    ck_assert(xyz != NULL && radii != NULL);
+    for (int i = 0; i < n_large; ++i) {
+        xyz[3*i] = 10*(i % 40);
+        xyz[3*i+1] = 10*((i / 40) % 40);
+        xyz[3*i+2] = 10*(i / 1600);
+        radii[i] = 2;
+    }
+
+    // the same atoms are recalculated, whatever the size
+    for (int alg = 0; alg < 2; ++alg) {
+        p.alg = alg ? FREESASA_LEE_RICHARDS : FREESASA_SHRAKE_RUPLEY;
+        for (int s = 0; s < 2; ++s) {
+            const int n = s ? n_large : n_small;
+            ck_assert((calc = freesasa_calculation_new(xyz, radii, n, &p)) != NULL);
+            ck_assert_int_eq(freesasa_calculation_n_recalculated(calc), 0);
+            for (int m = 0; m < 3; ++m) {
+                ck_assert(freesasa_calculation_move(calc, &atom, pos[m], 1) == FREESASA_SUCCESS);
+                ck_assert_int_eq(freesasa_calculation_n_recalculated(calc), n_recalc[m]);
+            }
+            ck_assert(fabs(freesasa_calculation_result(calc)->total - n*4*M_PI*3.4*3.4)
+                      < 1e-9*n);
+            freesasa_calculation_free(calc);
+        }
+    }
+    free(xyz);
+    free(radii);
+}
+END_TEST
+
 START_TEST (test_write_1ubq) {
     FILE *tf = fopen("tmp/dummy_bfactors.pdb","w+"),
         *ref = fopen(DATADIR "reference_bfactors.pdb","r"),
@@ -380,9 +617,24 @@ START_TEST (test_multi_calc)
     p.lee_richards_n_slices = 20;
     ck_assert((res = freesasa_calc_structure(st,&p)) != NULL);
     ck_assert(fabs(res->total - 4804.055641) < 1e-5);
-    
-    freesasa_structure_free(st);
     freesasa_result_free(res);
+
+    // same thing with a thread pool, several calculations
+    p.thread_pool = freesasa_thread_pool_new(3);
+    ck_assert(p.thread_pool != NULL);
+    for (int i = 0; i < 3; ++i) {
+        p.alg = FREESASA_SHRAKE_RUPLEY;
+        ck_assert((res = freesasa_calc_structure(st,&p)) != NULL);
+        ck_assert(fabs(res->total - 4834.716265) < 1e-5);
+        freesasa_result_free(res);
+        p.alg = FREESASA_LEE_RICHARDS;
+        ck_assert((res = freesasa_calc_structure(st,&p)) != NULL);
+        ck_assert(fabs(res->total - 4804.055641) < 1e-5);
+        freesasa_result_free(res);
+    }
+    freesasa_thread_pool_free(p.thread_pool);
+
+    freesasa_structure_free(st);
 #endif /* USE_THREADS */
 }
 END_TEST
@@ -440,6 +692,9 @@ Suite *sasa_suite()
     tcase_add_test(tc_basic, test_calc_errors);
     tcase_add_test(tc_basic, test_user_classes);
     tcase_add_test(tc_basic, test_write_1ubq);
+    tcase_add_test(tc_basic, test_reorder_atoms);
+    tcase_add_test(tc_basic, test_calculation_move);
+    tcase_add_test(tc_basic, test_calculation_move_local);
     
     TCase *tc_lr_basic = tcase_create("Basic L&R");
     tcase_add_checked_fixture(tc_lr_basic,setup_lr_precision,teardown_lr_precision);
@@ -452,10 +707,13 @@ Suite *sasa_suite()
     TCase *tc_lr = tcase_create("1UBQ-L&R");
     tcase_add_checked_fixture(tc_lr,setup_lr,teardown_lr);
     tcase_add_test(tc_lr, test_sasa_1ubq);
+    tcase_add_test(tc_lr, test_lr_approx);
 
     TCase *tc_sr = tcase_create("1UBQ-S&R");
     tcase_add_checked_fixture(tc_sr,setup_sr,teardown_sr);
     tcase_add_test(tc_sr, test_sasa_1ubq);
+    tcase_add_test(tc_sr, test_sr_buried);
+    tcase_add_test(tc_sr, test_sr_lut);
 
     TCase *tc_trimmed = tcase_create("Trimmed PDB file");
     tcase_add_test(tc_trimmed, test_trimmed_pdb);
@@ -42,7 +42,6 @@ set_fail_freq(int freq) {
 #define strdup(s) broken_strdup(s)
 
 
-#define FREESASA_NB_CHUNK 1 // to force som reallocs to take place
 #include "whole_lib_one_file.c"
 
 int int_array[6] = {0,1,2,3,4,5};
@@ -63,7 +62,6 @@ struct freesasa_structure structure = {
     .res_first_atom = int_array,
     .res_desc = (char**)str_array
 };
-struct file_range range = {.begin = 0, .end = 1};
 struct cell a_cell = {.nb = {NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,
                              NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL},
                       .atom = int_array, .n_nb=0, .n_atoms = 0};
@@ -83,6 +81,8 @@ START_TEST (test_coord)
     ck_assert_ptr_eq(freesasa_coord_new_linked(v,1),NULL);
     ck_assert_int_eq(freesasa_coord_append(coord_dyn,v,1),FREESASA_FAIL);
     ck_assert_int_eq(freesasa_coord_append_xyz(coord_dyn,v,v+1,v+2,1),FREESASA_FAIL);
+    ck_assert_int_eq(freesasa_coord_reserve(coord_dyn,10),FREESASA_FAIL);
+    ck_assert_int_eq(freesasa_coord_n(coord_dyn),0);
     freesasa_set_verbosity(FREESASA_V_NORMAL);
     freesasa_coord_free(coord_dyn);
 }
@@ -95,8 +95,14 @@ START_TEST (test_structure)
     freesasa_set_verbosity(FREESASA_V_SILENT);
     ck_assert_ptr_ne(file, NULL);
     ck_assert_ptr_eq(freesasa_structure_new(), NULL);
-    ck_assert_ptr_eq(from_pdb_impl(file,range, NULL, 0), NULL);
-    for (int i = 1; i < 100; ++i) {
+    ck_assert_ptr_eq(from_pdb_impl(file, NULL, 0), NULL);
+    set_fail_freq(100000);
+    rewind(file);
+    freesasa_structure *s = freesasa_structure_from_pdb(file, NULL, 0);
+    int n_alloc = n_fails;
+    ck_assert_ptr_ne(s, NULL);
+    freesasa_structure_free(s);
+    for (int i = 1; i <= n_alloc; ++i) {
         set_fail_freq(i);
         rewind(file);
         ck_assert_ptr_eq(freesasa_structure_from_pdb(file, NULL, 0), NULL);
@@ -114,6 +120,30 @@ START_TEST (test_structure)
     }
     set_fail_freq(1);
     fclose(file);
+
+    // adding atoms in bulk
+    const char *names[2] = {" C  ", " CA "}, *res_names[2] = {"ALA", "ALA"},
+        *res_numbers[2] = {"   1", "   1"};
+    const double xyz[6] = {0, 0, 0, 1, 1, 1};
+    for (int i = 1; i < 4; ++i) {
+        set_fail_freq(100000);
+        s = freesasa_structure_new();
+        set_fail_freq(i);
+        ck_assert_int_eq(freesasa_structure_reserve(s, 1000), FREESASA_FAIL);
+        set_fail_freq(100000);
+        freesasa_structure_free(s);
+    }
+    for (int i = 1; i < 8; ++i) {
+        set_fail_freq(100000);
+        s = freesasa_structure_new();
+        set_fail_freq(i);
+        ck_assert_int_eq(freesasa_structure_add_atoms(s, 2, names, res_names, res_numbers,
+                                                      "AA", xyz, NULL, 0),
+                         FREESASA_FAIL);
+        set_fail_freq(100000);
+        freesasa_structure_free(s);
+    }
+    set_fail_freq(1);
     freesasa_set_verbosity(FREESASA_V_NORMAL);
 }
 END_TEST
@@ -124,12 +154,32 @@ START_TEST (test_nb)
     ck_assert_ptr_eq(cell_list_new(1,&coord),NULL);
     ck_assert_int_eq(fill_cells(&a_cell_list,&coord),FREESASA_FAIL);
     ck_assert_ptr_eq(freesasa_nb_alloc(10),NULL);
-    for (int i = 1; i < 50; ++i) {
+    for (int i = 1; i < 3; ++i) {
         set_fail_freq(i);
         ck_assert_ptr_eq(freesasa_nb_alloc(2*i),NULL);
+    }
+    set_fail_freq(10000);
+    freesasa_nb_free(freesasa_nb_new(&coord,r));
+    for (int i = 1, n = n_fails; i <= n; ++i) {
         set_fail_freq(i);
         ck_assert_ptr_eq(freesasa_nb_new(&coord,r),NULL);
     }
+
+    // two atoms far apart give a sparse cell list
+    double v_far[6] = {0,0,0, 1000,1000,1000};
+    struct coord_t far = {.xyz = v_far, .n = 2, .is_linked = 0};
+    set_fail_freq(10000);
+    freesasa_nb_free(freesasa_nb_new(&far,r));
+    for (int i = 1, n = n_fails; i <= n; ++i) {
+        set_fail_freq(i);
+        ck_assert_ptr_eq(freesasa_nb_new(&far,r),NULL);
+    }
+    set_fail_freq(10000);
+    freesasa_nb_free(freesasa_nb_new_threads(&coord,r,NULL,2));
+    for (int i = 1, n = n_fails; i <= n; ++i) {
+        set_fail_freq(i);
+        ck_assert_ptr_eq(freesasa_nb_new_threads(&coord,r,NULL,2),NULL);
+    }
     set_fail_freq(1);
     freesasa_set_verbosity(FREESASA_V_NORMAL);
 }
@@ -142,10 +192,20 @@ START_TEST (test_alg)
     ck_assert_int_eq(freesasa_lee_richards(dummy, &coord, r, NULL), FREESASA_SUCCESS);
     ck_assert_int_eq(freesasa_shrake_rupley(dummy, &coord, r, NULL), FREESASA_SUCCESS);
     
+    // let each allocation fail once
+    set_fail_freq(10000);
+    freesasa_lee_richards(dummy, &coord, r, NULL);
+    const int n_lr = n_fails;
+    set_fail_freq(10000);
+    freesasa_shrake_rupley(dummy, &coord, r, NULL);
+    const int n_sr = n_fails;
+
     freesasa_set_verbosity(FREESASA_V_SILENT);
-    for (int i = 1; i < 50; ++i) {
+    for (int i = 1; i <= n_lr; ++i) {
         set_fail_freq(i);
         ck_assert_int_eq(freesasa_lee_richards(dummy,&coord,r,NULL),FREESASA_FAIL);
+    }
+    for (int i = 1; i <= n_sr; ++i) {
         set_fail_freq(i);
         ck_assert_int_eq(freesasa_shrake_rupley(dummy,&coord,r,NULL),FREESASA_FAIL);
     }
@@ -230,13 +290,32 @@ START_TEST (test_api)
     p.shrake_rupley_n_points = 20; // so the loop below will be fast
 
     freesasa_set_verbosity(FREESASA_V_SILENT);
-    for (int i = 1; i < 50; ++i) {
-        p.alg = FREESASA_SHRAKE_RUPLEY;
-        set_fail_freq(i);
-        ck_assert_ptr_eq(freesasa_calc(&coord, r, &p), NULL);
-        p.alg = FREESASA_LEE_RICHARDS; 
+    for (int alg = 0; alg < 4; ++alg) {
+        freesasa_result *res;
+        int n_alloc;
+        p.alg = (freesasa_algorithm[]){FREESASA_SHRAKE_RUPLEY,
+                                       FREESASA_LEE_RICHARDS,
+                                       FREESASA_SHRAKE_RUPLEY_LUT,
+                                       FREESASA_LEE_RICHARDS}[alg];
+        p.reorder_atoms = (alg == 3);
+        // let each allocation fail once
+        freesasa_shrake_rupley_lut_clear();
+        set_fail_freq(10000);
+        res = freesasa_calc(&coord, r, &p);
+        ck_assert_ptr_ne(res, NULL);
+        n_alloc = n_fails;
+        freesasa_result_free(res);
+        for (int i = 1; i <= n_alloc; ++i) {
+            // the lookup table is cached, build it each time
+            freesasa_shrake_rupley_lut_clear();
+            set_fail_freq(i);
+            ck_assert_ptr_eq(freesasa_calc(&coord, r, &p), NULL);
+        }
+    }
+
+    for (int i = 1; i < 4; ++i) {
         set_fail_freq(i);
-        ck_assert_ptr_eq(freesasa_calc(&coord, r, &p), NULL);
+        ck_assert_ptr_eq(freesasa_thread_pool_new(3), NULL);
     }
 
     FILE *file = fopen(DATADIR "1ubq.pdb","r");
@@ -246,12 +325,99 @@ START_TEST (test_api)
     for (int i = 1; i < 256; i *= 2) { //try to spread it out without doing too many calculations
         set_fail_freq(i);
         ck_assert_ptr_eq(freesasa_calc_structure(s, NULL), NULL);
+    }
+    set_fail_freq(100000);
+    freesasa_structure *chain = freesasa_structure_get_chains(s, "A");
+    int n_alloc = n_fails;
+    ck_assert_ptr_ne(chain, NULL);
+    freesasa_structure_free(chain);
+    for (int i = 1; i <= n_alloc; ++i) {
         set_fail_freq(i);
         ck_assert_ptr_eq(freesasa_structure_get_chains(s, "A"), NULL);
     }
     set_fail_freq(1);
     freesasa_structure_free(s);
     fclose(file);
+
+    // reading mmCIF
+    file = fopen(DATADIR "1ubq.cif","r");
+    set_fail_freq(100000);
+    s = freesasa_structure_from_cif(file, NULL, 0);
+    n_alloc = n_fails;
+    ck_assert_ptr_ne(s, NULL);
+    freesasa_structure_free(s);
+    for (int i = 1; i <= n_alloc; i *= 2) {
+        rewind(file);
+        set_fail_freq(i);
+        ck_assert_ptr_eq(freesasa_structure_from_cif(file, NULL, 0), NULL);
+    }
+    fclose(file);
+
+    // reading the first frame of a trajectory
+    file = fopen(DATADIR "1d3z.pdb","r");
+    set_fail_freq(100000);
+    freesasa_trajectory *t = freesasa_trajectory_from_pdb(file, NULL, 0);
+    n_alloc = n_fails;
+    ck_assert_ptr_ne(t, NULL);
+    freesasa_trajectory_free(t);
+    for (int i = 1; i <= n_alloc; i *= 2) {
+        rewind(file);
+        set_fail_freq(i);
+        ck_assert_ptr_eq(freesasa_trajectory_from_pdb(file, NULL, 0), NULL);
+    }
+    rewind(file);
+    set_fail_freq(100000);
+    t = freesasa_trajectory_from_pdb(file, NULL, 0);
+    ck_assert_ptr_ne(t, NULL);
+    for (int i = 1; i < 64; i *= 2) {
+        set_fail_freq(i);
+        ck_assert_ptr_eq(freesasa_trajectory_calc(t, NULL), NULL);
+    }
+    freesasa_trajectory_free(t);
+    set_fail_freq(1);
+    fclose(file);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+}
+END_TEST
+
+START_TEST (test_calculation)
+{
+    freesasa_parameters p = freesasa_default_parameters;
+    const int atoms[2] = {5, 1};
+    const double moved[6] = {20,20,20, 1,1.5,1};
+    p.shrake_rupley_n_points = 20;
+
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    for (int alg = 0; alg < 2; ++alg) {
+        freesasa_calculation *calc;
+        int n_alloc;
+        p.alg = alg == 0 ? FREESASA_SHRAKE_RUPLEY : FREESASA_LEE_RICHARDS;
+
+        set_fail_freq(10000);
+        calc = freesasa_calculation_new(v, r, 6, &p);
+        ck_assert_ptr_ne(calc, NULL);
+        n_alloc = n_fails;
+        freesasa_calculation_free(calc);
+        for (int i = 1; i <= n_alloc; ++i) {
+            set_fail_freq(i);
+            ck_assert_ptr_eq(freesasa_calculation_new(v, r, 6, &p), NULL);
+        }
+
+        set_fail_freq(10000);
+        calc = freesasa_calculation_new(v, r, 6, &p);
+        set_fail_freq(10000);
+        ck_assert_int_eq(freesasa_calculation_move(calc, atoms, moved, 2), FREESASA_SUCCESS);
+        n_alloc = n_fails;
+        freesasa_calculation_free(calc);
+        for (int i = 1; i <= n_alloc; ++i) {
+            set_fail_freq(10000);
+            calc = freesasa_calculation_new(v, r, 6, &p);
+            set_fail_freq(i);
+            ck_assert_int_eq(freesasa_calculation_move(calc, atoms, moved, 2), FREESASA_FAIL);
+            freesasa_calculation_free(calc);
+        }
+    }
+    set_fail_freq(1);
     freesasa_set_verbosity(FREESASA_V_NORMAL);
 }
 END_TEST
@@ -267,6 +433,7 @@ int main(int argc, char **argv) {
     tcase_add_test(tc,test_classifier);
     tcase_add_test(tc,test_selector);
     tcase_add_test(tc,test_api);
+    tcase_add_test(tc,test_calculation);
     
     suite_add_tcase(s, tc);
     SRunner *sr = srunner_create(s);
@@ -1,5 +1,7 @@
+#include <stdio.h>
 #include <nb.h>
 #include <check.h>
+#include <freesasa_internal.h>
 
 const double v[18] = {0,0,0, 1,1,1, -1,1,-1, 2,0,-2, 2,2,0, -5,5,5};
 const double r[6]  = {4,2,2,2,2,2};
@@ -22,11 +24,209 @@ START_TEST (test_nb) {
 }
 END_TEST
 
+START_TEST (test_nb_threads) {
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    const coord_t *coord = freesasa_structure_xyz(st);
+    const int n = freesasa_structure_n(st);
+    double radii[n];
+    nb_list *nb, *nb_t;
+    fclose(pdb);
+
+    for (int i = 0; i < n; ++i) radii[i] = 3;
+    nb = freesasa_nb_new(coord,radii);
+    ck_assert(nb != NULL);
+
+    // should give the same list, in the same order, regardless of threads
+    for (int n_threads = 2; n_threads < 6; ++n_threads) {
+        nb_t = freesasa_nb_new_threads(coord,radii,NULL,n_threads);
+        ck_assert(nb_t != NULL);
+        for (int i = 0; i < n; ++i) {
+            ck_assert_int_eq(nb_t->nn[i], nb->nn[i]);
+            ck_assert_int_eq(nb_t->first[i], nb->first[i]);
+            for (int k = 0; k < nb->nn[i]; ++k) {
+                const nb_pair *p = &nb->pair[nb->first[i]+k],
+                    *p_t = &nb_t->pair[nb_t->first[i]+k];
+                ck_assert_int_eq(p_t->j, p->j);
+                ck_assert(p_t->xyd == p->xyd);
+                ck_assert(p_t->xd == p->xd);
+                ck_assert(p_t->yd == p->yd);
+            }
+        }
+        freesasa_nb_free(nb_t);
+    }
+    freesasa_nb_free(nb);
+    freesasa_structure_free(st);
+}
+END_TEST
+
+START_TEST (test_nb_sparse) {
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    const coord_t *coord = freesasa_structure_xyz(st);
+    const int n = freesasa_structure_n(st);
+    coord_t *two = freesasa_coord_new();
+    double radii[2*n];
+    nb_list *nb;
+    fclose(pdb);
+
+    /* two copies of the protein far apart, mostly empty space in
+       between, compare with a brute force search */
+    freesasa_coord_append(two,freesasa_coord_all(coord),n);
+    freesasa_coord_append(two,freesasa_coord_all(coord),n);
+    for (int i = n; i < 2*n; ++i) {
+        const double *v = freesasa_coord_i(two,i);
+        freesasa_coord_set_i_xyz(two,i,v[0]+1000,v[1]+500,v[2]-1000);
+    }
+    for (int i = 0; i < 2*n; ++i) radii[i] = 3;
+    nb = freesasa_nb_new(two,radii);
+    ck_assert(nb != NULL);
+    for (int i = 0; i < 2*n; ++i) {
+        const double *vi = freesasa_coord_i(two,i);
+        for (int j = 0; j < 2*n; ++j) {
+            const double *vj = freesasa_coord_i(two,j);
+            const double dx = vj[0]-vi[0], dy = vj[1]-vi[1], dz = vj[2]-vi[2];
+            ck_assert_int_eq(freesasa_nb_contact(nb,i,j),
+                             i != j && dx*dx + dy*dy + dz*dz < 36);
+        }
+    }
+    freesasa_nb_free(nb);
+    freesasa_coord_free(two);
+    freesasa_structure_free(st);
+}
+END_TEST
+
+START_TEST (test_nb_grid) {
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    const int n = freesasa_structure_n(st);
+    coord_t *coord = freesasa_coord_copy(freesasa_structure_xyz(st));
+    double radii[n];
+    int all[n];
+    nb_grid *grid;
+    nb_list *nb, *ref;
+    fclose(pdb);
+
+    for (int i = 0; i < n; ++i) {
+        radii[i] = 3;
+        all[i] = i;
+    }
+    ck_assert((grid = freesasa_nb_grid_new(coord,radii)) != NULL);
+
+    for (int step = 0; step < 3; ++step) {
+        // move every tenth atom, first a little, then far away
+        for (int i = 0; i < n && step > 0; i += 10) {
+            const double *v = freesasa_coord_i(coord,i);
+            const double d = step == 1 ? 2.5 : -1000;
+            freesasa_coord_set_i_xyz(coord,i,v[0]+d,v[1]-d,v[2]+d);
+            ck_assert(freesasa_nb_grid_move(grid,i) == FREESASA_SUCCESS);
+        }
+        ck_assert((ref = freesasa_nb_new(coord,radii)) != NULL);
+        ck_assert((nb = freesasa_nb_new_subset(grid,all,n)) != NULL);
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < nb->nn[i]; ++k) {
+                const nb_pair *p = &nb->pair[nb->first[i]+k];
+                const double *vi = freesasa_coord_i(coord,i),
+                    *vj = freesasa_coord_i(coord,p->j);
+                ck_assert(freesasa_nb_contact(ref,i,p->j));
+                ck_assert(p->xd == vj[0]-vi[0] && p->yd == vj[1]-vi[1]);
+            }
+            for (int k = 0; k < ref->nn[i]; ++k) {
+                ck_assert(freesasa_nb_contact(nb,i,ref->pair[ref->first[i]+k].j));
+            }
+        }
+        freesasa_nb_free(nb);
+        freesasa_nb_free(ref);
+    }
+
+    // the list has one row per element of the subset
+    ck_assert((ref = freesasa_nb_new(coord,radii)) != NULL);
+    ck_assert((nb = freesasa_nb_new_subset(grid,all+5,2)) != NULL);
+    ck_assert_int_eq(nb->n, 2);
+    for (int k = 0; k < 2; ++k) {
+        const nb_pair *pk = nb->pair + nb->first[k];
+        ck_assert_int_gt(nb->nn[k], 0);
+        for (int l = 0; l < nb->nn[k]; ++l) {
+            ck_assert(freesasa_nb_contact(ref,5+k,pk[l].j));
+        }
+        for (int l = 0; l < ref->nn[5+k]; ++l) {
+            const int j = ref->pair[ref->first[5+k]+l].j;
+            int found = 0;
+            for (int m = 0; m < nb->nn[k]; ++m) found |= pk[m].j == j;
+            ck_assert(found);
+        }
+    }
+    freesasa_nb_free(nb);
+    freesasa_nb_free(ref);
+
+    freesasa_nb_grid_free(grid);
+    freesasa_coord_free(coord);
+    freesasa_structure_free(st);
+}
+END_TEST
+
+START_TEST (test_nb_verlet) {
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    ck_assert(pdb != NULL);
+    freesasa_structure *st = freesasa_structure_from_pdb(pdb,NULL,0);
+    const int n = freesasa_structure_n(st);
+    coord_t *coord = freesasa_coord_copy(freesasa_structure_xyz(st));
+    double radii[n];
+    nb_verlet *verlet;
+    const nb_list *nb;
+    nb_list *ref;
+    // the second step moves atoms less than half the skin in total
+    const double d[4] = {0, 0.2, 0.2, 0}, skin = 1;
+    const int n_builds[4] = {1, 1, 2, 3};
+    fclose(pdb);
+
+    for (int i = 0; i < n; ++i) radii[i] = 3;
+    ck_assert((verlet = freesasa_nb_verlet_new(skin)) != NULL);
+    ck_assert_int_eq(freesasa_nb_verlet_n_builds(verlet), 0);
+
+    for (int step = 0; step < 4; ++step) {
+        for (int i = 0; i < n; i += 10) {
+            const double *v = freesasa_coord_i(coord,i);
+            freesasa_coord_set_i_xyz(coord,i,v[0]+d[step],v[1]-d[step],v[2]+d[step]);
+        }
+        // changing the radii forces a new search
+        if (step == 3) radii[0] = 3.5;
+        ck_assert((nb = freesasa_nb_verlet_update(verlet,coord,radii,NULL,1)) != NULL);
+        ck_assert_int_eq(freesasa_nb_verlet_n_builds(verlet), n_builds[step]);
+        ck_assert((ref = freesasa_nb_new(coord,radii)) != NULL);
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < nb->nn[i]; ++k) {
+                const nb_pair *p = &nb->pair[nb->first[i]+k];
+                const double *vi = freesasa_coord_i(coord,i),
+                    *vj = freesasa_coord_i(coord,p->j);
+                ck_assert(freesasa_nb_contact(ref,i,p->j));
+                ck_assert(p->xd == vj[0]-vi[0] && p->yd == vj[1]-vi[1]);
+            }
+            for (int k = 0; k < ref->nn[i]; ++k) {
+                ck_assert(freesasa_nb_contact(nb,i,ref->pair[ref->first[i]+k].j));
+            }
+        }
+        freesasa_nb_free(ref);
+    }
+
+    freesasa_nb_verlet_free(verlet);
+    freesasa_coord_free(coord);
+    freesasa_structure_free(st);
+}
+END_TEST
+
 Suite* nb_suite() {
     Suite *s = suite_create("Neighbor lists");
 
     TCase *tc_nb = tcase_create("Basic");
     tcase_add_test(tc_nb,test_nb);
+    tcase_add_test(tc_nb,test_nb_threads);
+    tcase_add_test(tc_nb,test_nb_sparse);
+    tcase_add_test(tc_nb,test_nb_grid);
+    tcase_add_test(tc_nb,test_nb_verlet);
     
     suite_add_tcase(s, tc_nb);
     
@@ -1,3 +1,6 @@
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
@@ -97,87 +100,202 @@ START_TEST (test_pdb_lines)
 }
 END_TEST
 
-START_TEST (test_get_models) {
-    // FILE without models
-    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
-    struct file_range* it;
-    int n = freesasa_pdb_get_models(pdb,&it);
-    ck_assert_int_eq(n,0);
-    ck_assert(it == NULL);
-    fclose(pdb);
+START_TEST (test_pdb_parse_atom)
+{
+    struct pdb_atom a;
+    double x[3];
+    int model = 0;
+    const char *lines[] = {
+        "ATOM    585  C   ARG A  74      41.765  34.829  30.944  0.45 36.22           C\n",
+        "ATOM    573  NH1AARG A  72     -34.110 -28.437  -7.768  1.00 35.02\n",
+        "HETATM  610  O   HOH A  83    1027.707-215.908   4.653  1.00 20.30           O  \n",
+        "ATOM    573  NH1AARG A  72      34.110  28.437\n",
+        "REMARK  573  NH1AARG A  72      34.110  28.437  27.768  1.00 35.02           N  \n",
+        "MODEL       12\n",
+        "MODEL\n"};
 
-    // this file has models
-    pdb = fopen(DATADIR "2jo4.pdb","r");
-    n = freesasa_pdb_get_models(pdb,&it);
-    ck_assert_int_eq(n,10);
-    for (int i = 0; i < n; ++i) {
-        char *line = NULL;
-        size_t len;
-        ck_assert_int_gt(it[i].end,it[i].begin);
-        fseek(pdb,it[i].begin,0);
-        ck_assert(getline(&line,&len,pdb) > 0);
-        // each segment should begin with MODEL
-        ck_assert(strncmp(line,"MODEL",5) == 0);
-        while(1) {
-            ck_assert(getline(&line,&len,pdb) > 0);
-            // there should be only one MODEL per model
-            ck_assert(strncmp(line,"MODEL",5) != 0);
-            if (ftell(pdb) >= it[i].end) break;
-        }
-        // the last line of the segment should be ENDMDL
-        ck_assert(strncmp(line,"ENDMDL",6) == 0);
-        free(line);
-    }
-    free(it);
-    fclose(pdb);
+    ck_assert_int_eq(freesasa_pdb_parse_atom(&a, lines[0], strlen(lines[0])), FREESASA_SUCCESS);
+    ck_assert_str_eq(a.name, " C  ");
+    ck_assert_str_eq(a.res_name, "ARG");
+    ck_assert_str_eq(a.res_number, "  74");
+    ck_assert_str_eq(a.symbol, " C");
+    ck_assert_int_eq(a.chain_label, 'A');
+    ck_assert_int_eq(a.alt_label, ' ');
+    // should be exactly the same as parsing the numbers the old way
+    freesasa_pdb_get_coord(x, lines[0]);
+    ck_assert(a.xyz[0] == x[0] && a.xyz[1] == x[1] && a.xyz[2] == x[2]);
+
+    // without symbol
+    ck_assert_int_eq(freesasa_pdb_parse_atom(&a, lines[1], strlen(lines[1])), FREESASA_SUCCESS);
+    ck_assert_str_eq(a.name, " NH1");
+    ck_assert_str_eq(a.symbol, "");
+    ck_assert_int_eq(a.alt_label, 'A');
+    freesasa_pdb_get_coord(x, lines[1]);
+    ck_assert(a.xyz[0] == x[0] && a.xyz[1] == x[1] && a.xyz[2] == x[2]);
+
+    // coordinates that don't fit the columns
+    ck_assert_int_eq(freesasa_pdb_parse_atom(&a, lines[2], strlen(lines[2])), FREESASA_SUCCESS);
+    ck_assert(a.xyz[0] == 1027.707 && a.xyz[1] == -215.908 && a.xyz[2] == 4.653);
+
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    ck_assert_int_eq(freesasa_pdb_parse_atom(&a, lines[3], strlen(lines[3])), FREESASA_FAIL);
+    ck_assert_int_eq(freesasa_pdb_parse_atom(&a, lines[4], strlen(lines[4])), FREESASA_FAIL);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+
+    ck_assert(freesasa_pdb_is_atom_line(lines[0], strlen(lines[0]), 0));
+    ck_assert(!freesasa_pdb_is_atom_line(lines[2], strlen(lines[2]), 0));
+    ck_assert(freesasa_pdb_is_atom_line(lines[2], strlen(lines[2]), 1));
+    ck_assert(!freesasa_pdb_is_atom_line(lines[0], 3, 1));
+
+    ck_assert_int_eq(freesasa_pdb_parse_model(&model, lines[5], strlen(lines[5])), FREESASA_SUCCESS);
+    ck_assert_int_eq(model, 12);
+    ck_assert_int_eq(freesasa_pdb_parse_model(&model, lines[6], strlen(lines[6])), FREESASA_FAIL);
+    ck_assert_int_eq(freesasa_pdb_parse_model(&model, lines[0], strlen(lines[0])), FREESASA_FAIL);
+    ck_assert_int_eq(model, 12);
 }
 END_TEST
 
-START_TEST (test_get_chains)
+/**
+    Reads the file from its current position with the reader and with
+    getline(), and checks that the lines are the same. Returns the
+    number of lines.
+ */
+static int
+check_reader(FILE *pdb, FILE *ref)
 {
-    // Test a non PDB file
-    FILE *pdb = fopen(DATADIR "err.config", "r");
-    struct file_range whole_file = freesasa_whole_file(pdb), *it = NULL;
-    int nc = freesasa_pdb_get_chains(pdb, whole_file, &it, 0);
-    fclose(pdb);
-    ck_assert_int_eq(nc,0);
-    ck_assert_ptr_eq(it,NULL);
+    struct pdb_reader reader;
+    const char *line;
+    char *ref_line = NULL;
+    size_t len, ref_size = 0;
+    int n = 0;
+
+    ck_assert_int_eq(freesasa_pdb_reader_open(&reader, pdb), FREESASA_SUCCESS);
+    while ((line = freesasa_pdb_reader_next(&reader, &len)) != NULL) {
+        ck_assert_int_eq(getline(&ref_line, &ref_size, ref), len);
+        ck_assert(memcmp(line, ref_line, len) == 0);
+        ck_assert(line[len-1] == '\n' || line[len] == '\0');
+        ++n;
+    }
+    freesasa_pdb_reader_close(&reader);
+    ck_assert_int_eq(reader.error, 0);
+    ck_assert_int_eq(getline(&ref_line, &ref_size, ref), -1);
+    free(ref_line);
+    return n;
+}
 
-    // This file only has one chain
-    pdb = fopen(DATADIR "1ubq.pdb", "r");
-    whole_file = freesasa_whole_file(pdb);
-    nc = freesasa_pdb_get_chains(pdb,whole_file,&it,0);
+START_TEST (test_pdb_reader)
+{
+    FILE *pdb = fopen(DATADIR "1ubq.pdb", "r"), *ref = fopen(DATADIR "1ubq.pdb", "r"),
+        *tmp = tmpfile(), *pipe;
+    ck_assert_ptr_ne(pdb, NULL);
+    ck_assert_ptr_ne(ref, NULL);
+    ck_assert_ptr_ne(tmp, NULL);
+
+    // whole file, from the middle and after the end
+    ck_assert_int_gt(check_reader(pdb, ref), 600);
+    ck_assert_int_eq(ftell(pdb), ftell(ref));
+    fseek(pdb, 1000, SEEK_SET);
+    fseek(ref, 1000, SEEK_SET);
+    ck_assert_int_gt(check_reader(pdb, ref), 600);
+    ck_assert_int_eq(check_reader(pdb, ref), 0);
+    fclose(ref);
     fclose(pdb);
-    ck_assert_int_eq(nc,1);
-    ck_assert_ptr_ne(it,NULL);
-    free(it);
-
-    // This file has 4 chains
-    pdb = fopen(DATADIR "2jo4.pdb","r");
-    int nm = freesasa_pdb_get_models(pdb,&it);
-    ck_assert_int_eq(nm,10);
-    ck_assert_ptr_ne(it,NULL);
-    for (int i = 0; i < nm; ++i) {
-        struct file_range *jt = NULL;
-        nc = freesasa_pdb_get_chains(pdb,it[i],&jt,0);
-        ck_assert_int_eq(nc,4);
-        ck_assert_ptr_ne(jt,NULL);
-        for (int j = 1; j < nc; ++j) {
-            ck_assert_int_ge(jt[j].begin, jt[j-1].end);
-        }
-        free(jt);
+
+    // a last line without newline
+    const char *lines[] = {"REMARK first line\n", "\n", "END"};
+    struct pdb_reader reader;
+    const char *line;
+    size_t len;
+    for (int i = 0; i < 3; ++i) fputs(lines[i], tmp);
+    rewind(tmp);
+    ck_assert_int_eq(freesasa_pdb_reader_open(&reader, tmp), FREESASA_SUCCESS);
+    for (int i = 0; i < 3; ++i) {
+        ck_assert_ptr_ne(line = freesasa_pdb_reader_next(&reader, &len), NULL);
+        ck_assert_int_eq(len, strlen(lines[i]));
+        ck_assert(strncmp(line, lines[i], len) == 0);
     }
-    free(it);
+    ck_assert_int_eq(line[len], '\0');
+    ck_assert_ptr_eq(freesasa_pdb_reader_next(&reader, &len), NULL);
+    freesasa_pdb_reader_close(&reader);
+    ck_assert_int_eq(ftell(tmp), 22);
+    fclose(tmp);
+
+    // input that can't be mapped
+    pipe = popen("cat " DATADIR "1ubq.pdb", "r");
+    ref = fopen(DATADIR "1ubq.pdb", "r");
+    ck_assert_ptr_ne(pipe, NULL);
+    ck_assert_int_gt(check_reader(pipe, ref), 600);
+    pclose(pipe);
+    fclose(ref);
+}
+END_TEST
+
+#if USE_ZLIB
+//! Copies at most max bytes of the output of the command to a temporary file
+static FILE *
+output_to_tmpfile(const char *command, long max)
+{
+    FILE *pipe = popen(command, "r"), *tmp = tmpfile();
+    int c;
+    ck_assert_ptr_ne(pipe, NULL);
+    ck_assert_ptr_ne(tmp, NULL);
+    for (long i = 0; (max < 0 || i < max) && (c = getc(pipe)) != EOF; ++i) putc(c, tmp);
+    pclose(pipe);
+    rewind(tmp);
+    return tmp;
+}
+
+START_TEST (test_pdb_reader_gz)
+{
+    FILE *gz, *ref;
+    struct pdb_reader reader;
+    size_t len;
+
+    // compressed pipe
+    gz = popen("gzip -c " DATADIR "1ubq.pdb", "r");
+    ref = fopen(DATADIR "1ubq.pdb", "r");
+    ck_assert_int_gt(check_reader(gz, ref), 600);
+    pclose(gz);
+    fclose(ref);
+
+    // concatenated members, followed by garbage
+    gz = output_to_tmpfile("gzip -c " DATADIR "1ubq.pdb; gzip -c " DATADIR "1d3z.pdb; "
+                           "echo garbage", -1);
+    ref = popen("cat " DATADIR "1ubq.pdb " DATADIR "1d3z.pdb", "r");
+    ck_assert_int_gt(check_reader(gz, ref), 600 + 10*1231);
+    pclose(ref);
+    fclose(gz);
+
+    // truncated and corrupt input
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    gz = output_to_tmpfile("gzip -c " DATADIR "1ubq.pdb", 10000);
+    ck_assert_int_eq(freesasa_pdb_reader_open(&reader, gz), FREESASA_SUCCESS);
+    while (freesasa_pdb_reader_next(&reader, &len)) ;
+    ck_assert_int_eq(reader.error, FREESASA_FAIL);
+    freesasa_pdb_reader_close(&reader);
+    fclose(gz);
+
+    gz = output_to_tmpfile("printf '\\037\\213 not compressed'", -1);
+    ck_assert_int_eq(freesasa_pdb_reader_open(&reader, gz), FREESASA_SUCCESS);
+    ck_assert_ptr_eq(freesasa_pdb_reader_next(&reader, &len), NULL);
+    ck_assert_int_eq(reader.error, FREESASA_FAIL);
+    freesasa_pdb_reader_close(&reader);
+    fclose(gz);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
 }
 END_TEST
+#endif /* USE_ZLIB */
 
 Suite *pdb_suite() {
     Suite *s = suite_create("PDB-parser");
     TCase *tc_core = tcase_create("Core");
     tcase_add_test(tc_core, test_pdb_empty_lines);
     tcase_add_test(tc_core, test_pdb_lines);
-    tcase_add_test(tc_core, test_get_models);
-    tcase_add_test(tc_core, test_get_chains);
+    tcase_add_test(tc_core, test_pdb_parse_atom);
+    tcase_add_test(tc_core, test_pdb_reader);
+#if USE_ZLIB
+    tcase_add_test(tc_core, test_pdb_reader_gz);
+#endif
     suite_add_tcase(s, tc_core);
 
     return s;
@@ -90,6 +90,34 @@ START_TEST (test_cell) {
         na += ci.n_atoms;
     }
     ck_assert_int_eq(na,n_atoms);
+
+    // the sparse grid should have the occupied cells of the dense one
+    cell_list *cs = malloc(sizeof(cell_list));
+    *cs = empty_cell_list;
+    cs->d = r_max;
+    cell_list_bounds(cs,coord);
+    ck_assert_int_eq(fill_cells_sparse(cs,coord), FREESASA_SUCCESS);
+    int ks = 0, index[c->n];
+    for (int i = 0; i < c->n; ++i) {
+        index[i] = c->cell[i].n_atoms > 0 ? ks++ : -1;
+    }
+    ck_assert_int_eq(cs->n, ks);
+    for (int i = 0; i < c->n; ++i) {
+        const cell *ci = &c->cell[i];
+        if (ci->n_atoms == 0) continue;
+        const cell *csi = &cs->cell[index[i]];
+        int n_nb = 0;
+        ck_assert_int_eq(csi->n_atoms, ci->n_atoms);
+        for (int k = 0; k < ci->n_atoms; ++k)
+            ck_assert_int_eq(csi->atom[k], ci->atom[k]);
+        for (int k = 0; k < ci->n_nb; ++k) {
+            if (ci->nb[k]->n_atoms == 0) continue;
+            ck_assert_ptr_eq(csi->nb[n_nb++], &cs->cell[index[ci->nb[k] - c->cell]]);
+        }
+        ck_assert_int_eq(csi->n_nb, n_nb);
+    }
+    cell_list_free(cs);
+
     cell_list_free(c);
     freesasa_coord_free(coord);
 }
@@ -258,6 +286,16 @@ START_TEST (test_classifier)
     ck_assert_str_eq(config->residue[0]->atom_name[1],"CB");
     ck_assert(fabs(config->residue[0]->atom_radius[0]-1.0) < 1e-5);
     ck_assert(fabs(config->residue[0]->atom_radius[1]-2.0) < 1e-5);
+
+    int res, atom;
+    ck_assert_int_eq(config_build_table(config),FREESASA_SUCCESS);
+    ck_assert_int_eq(config->table_size,16);
+    ck_assert_int_eq(find_atom(config,"ARG"," CB ",&res,&atom),FREESASA_SUCCESS);
+    ck_assert_int_eq(res,1);
+    ck_assert_int_eq(atom,1);
+    ck_assert_int_eq(find_atom(config,"ARG","C",&res,&atom),FREESASA_WARN);
+    ck_assert_int_eq(find_atom(config,"AR","CB",&res,&atom),FREESASA_WARN);
+    ck_assert_int_eq(find_atom(config,"","",&res,&atom),FREESASA_WARN);
     
     classifier_config_free(config);
     classifier_types_free(types);
@@ -355,13 +393,18 @@ START_TEST (test_rsa)
     freesasa_structure_add_atom(structure," O  ","ALA","   1",'B',11,11,11);
     freesasa_structure_add_atom(structure," CB ","ALA","   1",'B',12,12,12);
     freesasa_result *result = freesasa_calc_structure(structure, NULL);
+    int polar_class[6], bb_class[6];
     struct rsa_config cfg = {
         .polar_classifier = freesasa_default_rsa.polar_classifier,
         .bb_classifier = freesasa_default_rsa.bb_classifier,
+        .polar_class = polar_class,
+        .bb_class = bb_class,
         .result = result,
         .structure = structure,
         .sasa_ref = rsa_default_ref
     };
+    freesasa_structure_atom_classes(structure, cfg.polar_classifier, polar_class);
+    freesasa_structure_atom_classes(structure, cfg.bb_classifier, bb_class);
 
     for (int i = 0; i < 6; ++i) {
         rs = zero_rs;
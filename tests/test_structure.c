@@ -1,3 +1,6 @@
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -38,6 +41,11 @@ START_TEST (test_structure_api)
         sprintf(buf,"%c %s %s %s",cl[i],rnu[i],rna[i],an[i]);
         ck_assert_str_eq(freesasa_structure_atom_descriptor(s,i),buf);
     }
+    // names are stored once per structure
+    ck_assert(freesasa_structure_atom_res_name(s,0) == freesasa_structure_atom_res_name(s,4));
+    ck_assert(freesasa_structure_atom_res_number(s,0) == freesasa_structure_atom_res_number(s,5));
+    ck_assert(freesasa_structure_atom_symbol(s,0) == freesasa_structure_atom_symbol(s,3));
+    ck_assert(freesasa_structure_atom_res_name(s,0) != freesasa_structure_atom_res_name(s,5));
     freesasa_structure_atom_set_radius(s, 0, 10.0);
     ck_assert(float_eq(freesasa_structure_atom_radius(s, 0), 10.0, 1e-10));
 
@@ -109,6 +117,118 @@ START_TEST (test_add_atom)
 }
 END_TEST
 
+START_TEST (test_add_atoms)
+{
+    FILE *pdb = fopen(DATADIR "1ubq.pdb","r");
+    freesasa_structure *ref = freesasa_structure_from_pdb(pdb, NULL, 0);
+    int n = freesasa_structure_n(ref);
+    const char **names = malloc(sizeof(char*)*n), **res_names = malloc(sizeof(char*)*n),
+        **res_numbers = malloc(sizeof(char*)*n);
+    char *chains = malloc(n);
+    const double *xyz = freesasa_structure_coord_array(ref);
+    freesasa_structure *s = freesasa_structure_new();
+
+    fclose(pdb);
+    for (int i = 0; i < n; ++i) {
+        names[i] = freesasa_structure_atom_name(ref, i);
+        res_names[i] = freesasa_structure_atom_res_name(ref, i);
+        res_numbers[i] = freesasa_structure_atom_res_number(ref, i);
+        chains[i] = freesasa_structure_atom_chain(ref, i);
+    }
+
+    // add the first atom separately, to check that a reserve after it works
+    ck_assert_int_eq(freesasa_structure_add_atoms(s, 1, names, res_names, res_numbers,
+                                                  chains, xyz, NULL, 0),
+                     FREESASA_SUCCESS);
+    ck_assert_int_eq(freesasa_structure_reserve(s, n), FREESASA_SUCCESS);
+    ck_assert_int_eq(freesasa_structure_add_atoms(s, n-1, names+1, res_names+1, res_numbers+1,
+                                                  chains+1, xyz+3, NULL, 0),
+                     FREESASA_SUCCESS);
+    ck_assert_int_eq(freesasa_structure_add_atoms(s, 0, names, res_names, res_numbers,
+                                                  chains, xyz, NULL, 0),
+                     FREESASA_SUCCESS);
+
+    ck_assert_int_eq(freesasa_structure_n(s), n);
+    ck_assert_int_eq(freesasa_structure_n_residues(s), freesasa_structure_n_residues(ref));
+    ck_assert_int_eq(freesasa_structure_n_chains(s), freesasa_structure_n_chains(ref));
+    for (int i = 0; i < n; ++i) {
+        ck_assert_str_eq(freesasa_structure_atom_name(s, i), names[i]);
+        ck_assert_str_eq(freesasa_structure_atom_res_number(s, i), res_numbers[i]);
+        ck_assert(freesasa_structure_atom_radius(s, i) == freesasa_structure_atom_radius(ref, i));
+    }
+    for (int i = 0; i < 3*n; ++i)
+        ck_assert(freesasa_structure_coord_array(s)[i] == xyz[i]);
+    for (int i = 0; i < freesasa_structure_n_residues(s); ++i)
+        ck_assert_str_eq(freesasa_structure_residue_number(s, i),
+                         freesasa_structure_residue_number(ref, i));
+    freesasa_structure_free(s);
+
+    // unknown atoms
+    const char *unknown_names[3] = {" C  ", "CL  ", " C  "}, *unknown_res[3] = {"ALA", "ABC", "ALA"};
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    s = freesasa_structure_new();
+    ck_assert_int_eq(freesasa_structure_add_atoms(s, 3, unknown_names, unknown_res, res_numbers,
+                                                  chains, xyz, NULL, FREESASA_SKIP_UNKNOWN),
+                     FREESASA_WARN);
+    ck_assert_int_eq(freesasa_structure_n(s), 2);
+    ck_assert_int_eq(freesasa_structure_add_atoms(s, 3, unknown_names, unknown_res, res_numbers,
+                                                  chains, xyz, NULL, FREESASA_HALT_AT_UNKNOWN),
+                     FREESASA_FAIL);
+    ck_assert_int_eq(freesasa_structure_n(s), 3);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+
+    freesasa_structure_free(s);
+    freesasa_structure_free(ref);
+    free(names);
+    free(res_names);
+    free(res_numbers);
+    free(chains);
+}
+END_TEST
+
+START_TEST (test_atom_classes)
+{
+    freesasa_structure *s = freesasa_structure_new();
+    const freesasa_classifier *c = &freesasa_protor_classifier,
+        *rc = &freesasa_residue_classifier;
+    FILE *f = fopen(DATADIR "test.config", "r");
+    freesasa_classifier *fc = freesasa_classifier_from_file(f);
+    int classes[4];
+
+    ck_assert_ptr_ne(fc, NULL);
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    ck_assert_int_eq(freesasa_structure_add_atom(s," CA ","ALA","   1",'A',0,0,0), FREESASA_SUCCESS);
+    ck_assert_int_eq(freesasa_structure_add_atom(s," O  ","ALA","   1",'A',0,0,0), FREESASA_SUCCESS);
+    ck_assert_int_eq(freesasa_structure_add_atom(s,"CL  ","ABC","   2",'A',0,0,0), FREESASA_SUCCESS);
+
+    // stored when the atoms were added
+    freesasa_structure_atom_classes(s, c, classes);
+    ck_assert_int_eq(classes[0], c->sasa_class("ALA", " CA ", c));
+    ck_assert_int_eq(classes[1], c->sasa_class("ALA", " O  ", c));
+    ck_assert_int_eq(classes[2], FREESASA_WARN);
+
+    // calculated for other classifiers
+    freesasa_structure_atom_classes(s, rc, classes);
+    ck_assert_int_eq(classes[0], rc->sasa_class("ALA", "", rc));
+    ck_assert_int_eq(classes[2], rc->sasa_class("ABC", "CL  ", rc));
+    freesasa_structure_atom_classes(s, fc, classes);
+    ck_assert_int_eq(classes[0], fc->sasa_class("ALA", " CA ", fc));
+
+    // a structure built with two classifiers stores no classes
+    ck_assert_int_eq(freesasa_structure_add_atom_wopt(s," N  ","GLY","   3",'A',0,0,0,
+                                                      &freesasa_naccess_classifier, 0),
+                     FREESASA_SUCCESS);
+    freesasa_structure_atom_classes(s, c, classes);
+    ck_assert_int_eq(classes[0], c->sasa_class("ALA", " CA ", c));
+    ck_assert_int_eq(classes[3], c->sasa_class("GLY", " N  ", c));
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+
+    freesasa_classifier_free(fc);
+    fclose(f);
+    freesasa_structure_free(s);
+}
+END_TEST
+
 double a2r(const char *rn, const char *am)
 {
     return 1.0;
@@ -317,6 +437,21 @@ START_TEST (test_structure_array)
     ss = freesasa_structure_array(pdb, &n, NULL,  FREESASA_SEPARATE_CHAINS);
     freesasa_set_verbosity(FREESASA_V_NORMAL);
     ck_assert(ss == NULL);
+    fclose(pdb);
+
+    // the input doesn't have to be seekable
+    pdb = popen("cat " DATADIR "2jo4.pdb", "r");
+    ss = freesasa_structure_array(pdb, &n, NULL, FREESASA_SEPARATE_MODELS | FREESASA_SEPARATE_CHAINS);
+    pclose(pdb);
+    ck_assert(ss != NULL);
+    ck_assert_int_eq(n, 10*4);
+    for (int i = 0; i < n; ++i) {
+        ck_assert_int_eq(freesasa_structure_n(ss[i]), 129);
+        ck_assert_int_eq(freesasa_structure_model(ss[i]), i/4 + 1);
+        ck_assert_int_eq(freesasa_structure_chain_labels(ss[i])[0], "ABCD"[i%4]);
+        freesasa_structure_free(ss[i]);
+    }
+    free(ss);
 }
 END_TEST
 
@@ -383,20 +518,374 @@ START_TEST (test_occupancy)
 }
 END_TEST
 
+START_TEST (test_cif)
+{
+    FILE *pdb = fopen(DATADIR "1ubq.pdb", "r"), *cif = fopen(DATADIR "1ubq.cif", "r");
+    freesasa_structure *sp, *sc, **ss;
+    freesasa_result *rp, *rc;
+    int n;
+    const int options[] = {0, FREESASA_INCLUDE_HETATM};
+    ck_assert_ptr_ne(pdb, NULL);
+    ck_assert_ptr_ne(cif, NULL);
+
+    // the same structure as from the PDB file
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    for (int k = 0; k < 2; ++k) {
+        rewind(pdb);
+        rewind(cif);
+        sp = freesasa_structure_from_pdb(pdb, NULL, options[k]);
+        sc = freesasa_structure_from_cif(cif, NULL, options[k]);
+        ck_assert_ptr_ne(sp, NULL);
+        ck_assert_ptr_ne(sc, NULL);
+        ck_assert_int_eq(freesasa_structure_n(sc), freesasa_structure_n(sp));
+        ck_assert_int_eq(freesasa_structure_n_residues(sc), freesasa_structure_n_residues(sp));
+        for (int i = 0; i < freesasa_structure_n(sp); ++i) {
+            ck_assert_str_eq(freesasa_structure_atom_name(sc, i), freesasa_structure_atom_name(sp, i));
+            ck_assert_str_eq(freesasa_structure_atom_res_name(sc, i), freesasa_structure_atom_res_name(sp, i));
+            ck_assert_str_eq(freesasa_structure_atom_res_number(sc, i), freesasa_structure_atom_res_number(sp, i));
+            ck_assert_str_eq(freesasa_structure_atom_symbol(sc, i), freesasa_structure_atom_symbol(sp, i));
+            ck_assert_int_eq(freesasa_structure_atom_chain(sc, i), freesasa_structure_atom_chain(sp, i));
+            ck_assert(freesasa_structure_atom_radius(sc, i) == freesasa_structure_atom_radius(sp, i));
+        }
+        ck_assert(memcmp(freesasa_structure_coord_array(sc), freesasa_structure_coord_array(sp),
+                         3*sizeof(double)*freesasa_structure_n(sp)) == 0);
+        rp = freesasa_calc_structure(sp, NULL);
+        rc = freesasa_calc_structure(sc, NULL);
+        ck_assert(rc->total == rp->total);
+        freesasa_result_free(rp);
+        freesasa_result_free(rc);
+        freesasa_structure_free(sp);
+        freesasa_structure_free(sc);
+    }
+    fclose(pdb);
+
+    // options, see the comments in the file
+    freopen(DATADIR "syntax.cif", "r", cif);
+    sc = freesasa_structure_from_cif(cif, NULL, 0);
+    ck_assert_ptr_ne(sc, NULL);
+    ck_assert_int_eq(freesasa_structure_n(sc), 3);
+    ck_assert_int_eq(freesasa_structure_model(sc), 1);
+    ck_assert_str_eq(freesasa_structure_atom_name(sc, 2), " O5'");
+    ck_assert(freesasa_structure_coord_array(sc)[6] == -12.5);
+    freesasa_structure_free(sc);
+
+    rewind(cif);
+    sc = freesasa_structure_from_cif(cif, NULL, FREESASA_JOIN_MODELS | FREESASA_INCLUDE_HETATM |
+                                     FREESASA_INCLUDE_HYDROGEN);
+    ck_assert_ptr_ne(sc, NULL);
+    ck_assert_int_eq(freesasa_structure_n(sc), 7);
+    ck_assert_str_eq(freesasa_structure_chain_labels(sc), "ABC");
+    freesasa_structure_free(sc);
+
+    rewind(cif);
+    sc = freesasa_structure_from_cif(cif, NULL, FREESASA_RADIUS_FROM_OCCUPANCY);
+    ck_assert_ptr_ne(sc, NULL);
+    ck_assert(freesasa_structure_radius(sc)[2] == 0.5);
+    freesasa_structure_free(sc);
+    // the HETATM has no occupancy
+    rewind(cif);
+    ck_assert_ptr_eq(freesasa_structure_from_cif(cif, NULL, FREESASA_RADIUS_FROM_OCCUPANCY |
+                                                 FREESASA_INCLUDE_HETATM), NULL);
+
+    // chains are separated using the whole chain id
+    rewind(cif);
+    ss = freesasa_structure_array_from_cif(cif, &n, NULL, FREESASA_SEPARATE_CHAINS);
+    ck_assert_ptr_ne(ss, NULL);
+    ck_assert_int_eq(n, 1);
+    freesasa_structure_free(ss[0]);
+    free(ss);
+    rewind(cif);
+    ss = freesasa_structure_array_from_cif(cif, &n, NULL, FREESASA_SEPARATE_CHAINS |
+                                           FREESASA_SEPARATE_MODELS | FREESASA_INCLUDE_HETATM);
+    ck_assert_ptr_ne(ss, NULL);
+    ck_assert_int_eq(n, 4);
+    const int n_atoms[] = {3, 1, 1, 1}, models[] = {1, 1, 2, 2};
+    const char *chains[] = {"A", "B", "A", "C"};
+    for (int i = 0; i < n; ++i) {
+        ck_assert_int_eq(freesasa_structure_n(ss[i]), n_atoms[i]);
+        ck_assert_int_eq(freesasa_structure_model(ss[i]), models[i]);
+        ck_assert_str_eq(freesasa_structure_chain_labels(ss[i]), chains[i]);
+        freesasa_structure_free(ss[i]);
+    }
+    free(ss);
+    rewind(cif);
+    ck_assert_ptr_eq(freesasa_structure_array_from_cif(cif, &n, NULL, 0), NULL);
+    ck_assert_int_eq(n, 0);
+    fclose(cif);
+
+    // PDB input, and input that can't be mapped
+    pdb = fopen(DATADIR "1ubq.pdb", "r");
+    ck_assert_ptr_eq(freesasa_structure_from_cif(pdb, NULL, 0), NULL);
+    fclose(pdb);
+    cif = popen("cat " DATADIR "1ubq.cif", "r");
+    ck_assert_ptr_ne(cif, NULL);
+    sc = freesasa_structure_from_cif(cif, NULL, 0);
+    ck_assert_ptr_ne(sc, NULL);
+    ck_assert_int_eq(freesasa_structure_n(sc), 602);
+    freesasa_structure_free(sc);
+    pclose(cif);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+}
+END_TEST
+
+// Writes n ATOM lines from 1ubq.pdb, starting at atom first, with the chain label
+static void
+write_atoms(FILE *out, FILE *ubq, int first, int n, char chain)
+{
+    char line[100];
+    int i = 0;
+    rewind(ubq);
+    while (fgets(line, sizeof(line), ubq) && i < first + n) {
+        if (strncmp(line, "ATOM", 4) != 0) continue;
+        if (i++ < first) continue;
+        line[21] = chain;
+        fputs(line, out);
+    }
+}
+
+#if USE_ZLIB
+START_TEST (test_gzip)
+{
+    FILE *pdb = fopen(DATADIR "2jo4.pdb", "r"), *gz;
+    freesasa_structure *s, *sgz, **ss, **ssgz;
+    int n, ngz, options = FREESASA_SEPARATE_MODELS | FREESASA_SEPARATE_CHAINS;
+    ck_assert_ptr_ne(pdb, NULL);
+
+    gz = popen("gzip -c " DATADIR "2jo4.pdb", "r");
+    s = freesasa_structure_from_pdb(pdb, NULL, 0);
+    sgz = freesasa_structure_from_pdb(gz, NULL, 0);
+    pclose(gz);
+    ck_assert_ptr_ne(sgz, NULL);
+    ck_assert_int_eq(freesasa_structure_n(sgz), freesasa_structure_n(s));
+    ck_assert(memcmp(freesasa_structure_coord_array(sgz), freesasa_structure_coord_array(s),
+                     3*sizeof(double)*freesasa_structure_n(s)) == 0);
+    freesasa_structure_free(s);
+    freesasa_structure_free(sgz);
+
+    gz = popen("gzip -c " DATADIR "2jo4.pdb", "r");
+    ss = freesasa_structure_array(pdb, &n, NULL, options);
+    ssgz = freesasa_structure_array(gz, &ngz, NULL, options);
+    pclose(gz);
+    ck_assert_int_eq(n, 40);
+    ck_assert_int_eq(ngz, n);
+    for (int i = 0; i < n; ++i) {
+        ck_assert_int_eq(freesasa_structure_n(ssgz[i]), freesasa_structure_n(ss[i]));
+        ck_assert_str_eq(freesasa_structure_chain_labels(ssgz[i]),
+                         freesasa_structure_chain_labels(ss[i]));
+        freesasa_structure_free(ss[i]);
+        freesasa_structure_free(ssgz[i]);
+    }
+    free(ss);
+    free(ssgz);
+    fclose(pdb);
+
+    // truncated input
+    gz = popen("gzip -c " DATADIR "2jo4.pdb | head -c 10000", "r");
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    ck_assert_ptr_eq(freesasa_structure_array(gz, &ngz, NULL, options), NULL);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+    pclose(gz);
+
+    pdb = fopen(DATADIR "1ubq.cif", "r");
+    gz = popen("gzip -c " DATADIR "1ubq.cif", "r");
+    s = freesasa_structure_from_cif(pdb, NULL, 0);
+    sgz = freesasa_structure_from_cif(gz, NULL, 0);
+    pclose(gz);
+    ck_assert_ptr_ne(sgz, NULL);
+    ck_assert_int_eq(freesasa_structure_n(sgz), freesasa_structure_n(s));
+    freesasa_structure_free(s);
+    freesasa_structure_free(sgz);
+    fclose(pdb);
+}
+END_TEST
+#endif /* USE_ZLIB */
+
+START_TEST (test_structure_array_split)
+{
+    FILE *ubq = fopen(DATADIR "1ubq.pdb", "r"), *pdb = tmpfile();
+    int n = 0;
+    freesasa_structure **ss;
+    const int n_atoms[] = {20, 30, 40};
+    const char chains[] = "ABA";
+    ck_assert_ptr_ne(ubq, NULL);
+    ck_assert_ptr_ne(pdb, NULL);
+
+    /* atoms outside models are ignored, a chain that occurs twice in
+       a model gives two structures, the last model has no ENDMDL */
+    write_atoms(pdb, ubq, 0, 10, 'X');
+    for (int m = 1; m <= 2; ++m) {
+        fprintf(pdb, "MODEL     %4d\n", 10*m);
+        for (int c = 0, first = 0; c < 3; first += n_atoms[c++])
+            write_atoms(pdb, ubq, first, n_atoms[c], chains[c]);
+        if (m == 1) fputs("ENDMDL\n", pdb);
+    }
+
+    rewind(pdb);
+    ss = freesasa_structure_array(pdb, &n, NULL, FREESASA_SEPARATE_MODELS | FREESASA_SEPARATE_CHAINS);
+    ck_assert_ptr_ne(ss, NULL);
+    ck_assert_int_eq(n, 6);
+    for (int i = 0; i < n; ++i) {
+        ck_assert_int_eq(freesasa_structure_n(ss[i]), n_atoms[i%3]);
+        ck_assert_int_eq(freesasa_structure_model(ss[i]), 10*(i/3+1));
+        ck_assert_int_eq(freesasa_structure_chain_labels(ss[i])[0], chains[i%3]);
+        freesasa_structure_free(ss[i]);
+    }
+    free(ss);
+
+    rewind(pdb);
+    ss = freesasa_structure_array(pdb, &n, NULL, FREESASA_SEPARATE_CHAINS);
+    ck_assert_ptr_ne(ss, NULL);
+    ck_assert_int_eq(n, 3);
+    for (int i = 0; i < n; ++i) freesasa_structure_free(ss[i]);
+    free(ss);
+
+    rewind(pdb);
+    ss = freesasa_structure_array(pdb, &n, NULL, FREESASA_SEPARATE_MODELS);
+    ck_assert_ptr_ne(ss, NULL);
+    ck_assert_int_eq(n, 2);
+    for (int i = 0; i < n; ++i) {
+        ck_assert_int_eq(freesasa_structure_n(ss[i]), 90);
+        freesasa_structure_free(ss[i]);
+    }
+    free(ss);
+
+    // MODEL without ENDMDL before the next one
+    fputs("MODEL        3\n", pdb);
+    write_atoms(pdb, ubq, 0, 10, 'A');
+    rewind(pdb);
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    ck_assert_ptr_eq(freesasa_structure_array(pdb, &n, NULL, FREESASA_SEPARATE_MODELS), NULL);
+    ck_assert_int_eq(n, 0);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+
+    fclose(pdb);
+    fclose(ubq);
+}
+END_TEST
+
+START_TEST (test_trajectory)
+{
+    FILE *pdb = fopen(DATADIR "1d3z.pdb", "r");
+    int n = 0, options[] = {0, FREESASA_INCLUDE_HYDROGEN};
+    freesasa_structure **ss;
+    freesasa_trajectory *t;
+    const freesasa_structure *s;
+    ck_assert_ptr_ne(pdb, NULL);
+
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    ck_assert_ptr_eq(freesasa_trajectory_from_pdb(pdb, NULL, FREESASA_JOIN_MODELS), NULL);
+    ck_assert_ptr_eq(freesasa_trajectory_from_pdb(pdb, NULL, FREESASA_SEPARATE_MODELS), NULL);
+
+    // each frame should be the same as the corresponding model
+    for (int o = 0; o < 2; ++o) {
+        rewind(pdb);
+        ss = freesasa_structure_array(pdb, &n, NULL, FREESASA_SEPARATE_MODELS | options[o]);
+        ck_assert_ptr_ne(ss, NULL);
+        rewind(pdb);
+        t = freesasa_trajectory_from_pdb(pdb, NULL, options[o]);
+        ck_assert_ptr_ne(t, NULL);
+        s = freesasa_trajectory_structure(t);
+        for (int i = 0; i < n; ++i) {
+            const int na = freesasa_structure_n(s);
+            ck_assert_int_eq(freesasa_trajectory_next(t), 1);
+            ck_assert_int_eq(freesasa_structure_model(s), freesasa_structure_model(ss[i]));
+            ck_assert_int_eq(na, freesasa_structure_n(ss[i]));
+            for (int j = 0; j < 3*na; ++j) {
+                ck_assert(freesasa_structure_coord_array(s)[j] ==
+                          freesasa_structure_coord_array(ss[i])[j]);
+            }
+            for (int j = 0; j < na; ++j) {
+                ck_assert(freesasa_structure_radius(s)[j] ==
+                          freesasa_structure_radius(ss[i])[j]);
+            }
+            freesasa_structure_free(ss[i]);
+        }
+        ck_assert_int_eq(freesasa_trajectory_next(t), 0);
+        ck_assert_int_eq(freesasa_trajectory_next(t), 0);
+        freesasa_trajectory_free(t);
+        free(ss);
+    }
+    fclose(pdb);
+
+    // a file without models is a trajectory with one frame
+    pdb = fopen(DATADIR "1ubq.pdb", "r");
+    t = freesasa_trajectory_from_pdb(pdb, NULL, 0);
+    ck_assert_ptr_ne(t, NULL);
+    ck_assert_int_eq(freesasa_structure_n(freesasa_trajectory_structure(t)), 602);
+    ck_assert_int_eq(freesasa_trajectory_next(t), 1);
+    ck_assert_int_eq(freesasa_trajectory_next(t), 0);
+    freesasa_trajectory_free(t);
+    fclose(pdb);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+}
+END_TEST
+
+START_TEST (test_trajectory_calc)
+{
+    FILE *pdb = fopen(DATADIR "1d3z.pdb", "r");
+    const double skin[] = {0, 1, 5};
+    freesasa_parameters param[2] = {freesasa_default_parameters,
+                                    freesasa_default_parameters};
+    freesasa_trajectory *t;
+    ck_assert_ptr_ne(pdb, NULL);
+    param[1].alg = FREESASA_SHRAKE_RUPLEY;
+
+    // reusing neighbor lists should give exactly the same results
+    for (int k = 0; k < 3; ++k) {
+        for (int p = 0; p < 2; ++p) {
+            rewind(pdb);
+            t = freesasa_trajectory_from_pdb(pdb, NULL, 0);
+            ck_assert_ptr_ne(t, NULL);
+            ck_assert_int_eq(freesasa_trajectory_set_skin(t, skin[k]), FREESASA_SUCCESS);
+            while (freesasa_trajectory_next(t) == 1) {
+                const freesasa_structure *s = freesasa_trajectory_structure(t);
+                freesasa_result *r1 = freesasa_trajectory_calc(t, &param[p]),
+                    *r2 = freesasa_calc_structure(s, &param[p]);
+                ck_assert_ptr_ne(r1, NULL);
+                ck_assert_ptr_ne(r2, NULL);
+                ck_assert_int_eq(r1->n_atoms, r2->n_atoms);
+                for (int i = 0; i < r1->n_atoms; ++i)
+                    ck_assert(r1->sasa[i] == r2->sasa[i]);
+                freesasa_result_free(r1);
+                freesasa_result_free(r2);
+            }
+            freesasa_trajectory_free(t);
+        }
+    }
+
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    rewind(pdb);
+    t = freesasa_trajectory_from_pdb(pdb, NULL, 0);
+    ck_assert_int_eq(freesasa_trajectory_set_skin(t, -1), FREESASA_FAIL);
+    freesasa_trajectory_free(t);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+    fclose(pdb);
+}
+END_TEST
+
 Suite* structure_suite() {
     // what goes in what Case is kind of arbitrary
     Suite *s = suite_create("Structure");
     TCase *tc_core = tcase_create("Core");
     tcase_add_test(tc_core, test_structure_api);
     tcase_add_test(tc_core, test_add_atom);
+    tcase_add_test(tc_core, test_add_atoms);
+    tcase_add_test(tc_core, test_atom_classes);
 
     TCase *tc_pdb = tcase_create("PDB");
     tcase_add_test(tc_pdb,test_pdb);
     tcase_add_test(tc_pdb,test_hydrogen);
     tcase_add_test(tc_pdb,test_hetatm);
     tcase_add_test(tc_pdb,test_structure_array);
+    tcase_add_test(tc_pdb,test_structure_array_split);
+    tcase_add_test(tc_pdb,test_trajectory);
+    tcase_add_test(tc_pdb,test_trajectory_calc);
     tcase_add_test(tc_pdb,test_get_chains);
     tcase_add_test(tc_pdb,test_occupancy);
+    tcase_add_test(tc_pdb,test_cif);
+#if USE_ZLIB
+    tcase_add_test(tc_pdb,test_gzip);
+#endif
 
     TCase *tc_1ubq = tcase_create("1UBQ");
     tcase_add_checked_fixture(tc_1ubq,setup_1ubq,teardown_1ubq);
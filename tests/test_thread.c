@@ -0,0 +1,85 @@
+#include <stdlib.h>
+#include <check.h>
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+#include <freesasa.h>
+#include <thread.h>
+
+#define N_ITEMS 1000
+#define MAX_THREADS 4
+
+struct count {
+    int visits[N_ITEMS];
+    int thread[N_ITEMS];
+};
+
+static void
+count_task(int begin, int end, int thread, void *arg)
+{
+    struct count *c = arg;
+    for (int i = begin; i < end; ++i) {
+        ++c->visits[i];
+        c->thread[i] = thread;
+    }
+}
+
+START_TEST (test_thread_run)
+{
+    int chunks[] = {-1, 1, 7, 32, N_ITEMS, 2*N_ITEMS};
+    for (int n_threads = 1; n_threads <= MAX_THREADS; ++n_threads) {
+        for (int k = 0; k < sizeof(chunks)/sizeof(int); ++k) {
+            struct count c = {{0}, {0}};
+            ck_assert_int_eq(freesasa_thread_run(NULL, n_threads, N_ITEMS, chunks[k],
+                                                 count_task, &c),
+                             FREESASA_SUCCESS);
+            // each item is processed exactly once, by a valid thread
+            for (int i = 0; i < N_ITEMS; ++i) {
+                ck_assert_int_eq(c.visits[i], 1);
+                ck_assert(c.thread[i] >= 0 && c.thread[i] < n_threads);
+            }
+        }
+    }
+    // nothing to do
+    ck_assert_int_eq(freesasa_thread_run(NULL, 2, 0, 1, count_task, NULL),
+                     FREESASA_SUCCESS);
+}
+END_TEST
+
+START_TEST (test_thread_pool)
+{
+    freesasa_thread_pool *pool = freesasa_thread_pool_new(MAX_THREADS);
+    ck_assert_ptr_ne(pool, NULL);
+    ck_assert(freesasa_thread_pool_size(pool) >= 1);
+
+    // the same pool can be used repeatedly, with fewer threads too
+    for (int rep = 0; rep < 20; ++rep) {
+        int n_threads = 1 + rep % freesasa_thread_pool_size(pool);
+        struct count c = {{0}, {0}};
+        ck_assert_int_eq(freesasa_thread_run(pool, n_threads, N_ITEMS, 1 + rep,
+                                             count_task, &c),
+                         FREESASA_SUCCESS);
+        for (int i = 0; i < N_ITEMS; ++i) {
+            ck_assert_int_eq(c.visits[i], 1);
+            ck_assert(c.thread[i] >= 0 && c.thread[i] < n_threads);
+        }
+    }
+    freesasa_thread_pool_free(pool);
+
+    freesasa_set_verbosity(FREESASA_V_SILENT);
+    ck_assert_ptr_eq(freesasa_thread_pool_new(0), NULL);
+    freesasa_set_verbosity(FREESASA_V_NORMAL);
+    freesasa_thread_pool_free(NULL);
+}
+END_TEST
+
+Suite* thread_suite() {
+    Suite *s = suite_create("Threads");
+
+    TCase *tc_thread = tcase_create("Scheduler");
+    tcase_add_test(tc_thread,test_thread_run);
+    tcase_add_test(tc_thread,test_thread_pool);
+
+    suite_add_tcase(s, tc_thread);
+    return s;
+}
@@ -2,10 +2,13 @@
 #include <freesasa.c>
 #include <structure.c>
 #include <nb.c>
+#include <thread.c>
 #include <sasa_lr.c>
 #include <sasa_sr.c>
+#include <calculation.c>
 #include <coord.c>
 #include <pdb.c>
+#include <cif.c>
 #include <util.c>
 #include <classifier.c>
 #include <classifier_protor.c>